@@ -42,7 +42,7 @@
 #include "bf16.hpp"
 #include "coll.hpp"
 
-/* free letters: k */
+/* free letters: none */
 void print_help_usage(const char* app) {
     PRINT("\nUSAGE:\n"
           "\t%s [OPTIONS]\n\n"
@@ -73,6 +73,7 @@ void print_help_usage(const char* app) {
           "\t[-d,--dtype <datatypes list/all>]: %s\n"
           "\t[-r,--reduction <reductions list/all>]: %s\n"
           "\t[-o,--csv_filepath <file to store CSV-formatted data into>]: %s\n"
+          "\t[-k,--tune <file to store tuning into instead of benchmarking>]: %s\n"
           "\t[-v,--verbosity <show verbose timing information with level>]: %d\n"
           "\t[-x,--ext <show additional information>]: %s\n"
           "\t[-h,--help]\n\n"
@@ -105,6 +106,7 @@ void print_help_usage(const char* app) {
           DEFAULT_DTYPES_LIST,
           DEFAULT_REDUCTIONS_LIST,
           DEFAULT_CSV_FILEPATH,
+          DEFAULT_TUNE_FILEPATH,
           DEFAULT_VERBOSITY,
           ext_values_names[DEFAULT_EXT_VALUES].c_str());
 }
@@ -561,7 +563,7 @@ int parse_user_options(int& argc, char**(&argv), user_options_t& options) {
 
     char short_options[1024] = { 0 };
 
-    const char* base_options = "b:i:w:j:n:f:t:c:p:q:o:s:l:d:r:z:y:v:x:h";
+    const char* base_options = "b:i:w:j:n:f:t:c:p:q:o:k:s:l:d:r:z:y:v:x:h";
     memcpy(short_options, base_options, strlen(base_options));
 
 #ifdef CCL_ENABLE_NUMA
@@ -601,6 +603,7 @@ int parse_user_options(int& argc, char**(&argv), user_options_t& options) {
         { "dtype", required_argument, nullptr, 'd' },
         { "reduction", required_argument, nullptr, 'r' },
         { "csv_filepath", required_argument, nullptr, 'o' },
+        { "tune", required_argument, nullptr, 'k' },
         { "verbosity", required_argument, nullptr, 'v' },
         { "ext", required_argument, nullptr, 'x' },
         { "help", no_argument, nullptr, 'h' },
@@ -754,6 +757,7 @@ int parse_user_options(int& argc, char**(&argv), user_options_t& options) {
                 should_parse_reductions = true;
                 break;
             case 'o': options.csv_filepath = std::string(optarg); break;
+            case 'k': options.tune_filepath = std::string(optarg); break;
             case 'v':
                 if (is_valid_integer_option(optarg)) {
                     options.verbosity = atoi(optarg);
@@ -904,7 +908,8 @@ void print_user_options(const user_options_t& options, const ccl::communicator&
                   "\n  datatypes:       %s"
                   "\n  reductions:      %s"
                   "\n  extended info:   %s"
-                  "\n  csv_filepath:    %s",
+                  "\n  csv_filepath:    %s"
+                  "\n  tune:            %s",
                   comm.size(),
                   backend_str.c_str(),
                   options.iters,
@@ -935,5 +940,6 @@ void print_user_options(const user_options_t& options, const ccl::communicator&
                   datatypes_str.c_str(),
                   reductions_str.c_str(),
                   show_additional_info_str.c_str(),
-                  options.csv_filepath.c_str());
+                  options.csv_filepath.c_str(),
+                  options.tune_filepath.c_str());
 }
@@ -60,3 +60,4 @@
 #define DEFAULT_REDUCTIONS_LIST "sum"
 #define DEFAULT_VERBOSITY       (0)
 #define DEFAULT_CSV_FILEPATH    ""
+#define DEFAULT_TUNE_FILEPATH   ""
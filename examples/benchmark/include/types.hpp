@@ -151,6 +151,7 @@ typedef struct user_options_t {
     std::list<std::string> dtypes;
     std::list<std::string> reductions;
     std::string csv_filepath;
+    std::string tune_filepath;
 
     bool min_elem_count_set;
     bool max_elem_count_set;
@@ -184,6 +185,7 @@ typedef struct user_options_t {
         dtypes = tokenize<std::string>(DEFAULT_DTYPES_LIST, ',');
         reductions = tokenize<std::string>(DEFAULT_REDUCTIONS_LIST, ',');
         csv_filepath = std::string(DEFAULT_CSV_FILEPATH);
+        tune_filepath = std::string(DEFAULT_TUNE_FILEPATH);
 
         min_elem_count_set = false;
         max_elem_count_set = false;
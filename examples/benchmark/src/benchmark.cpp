@@ -16,9 +16,11 @@
 #include <algorithm>
 #include <atomic>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <iterator>
 #include <list>
+#include <map>
 #include <memory>
 #include <set>
 #include <sstream>
@@ -226,6 +228,324 @@ void run(ccl::communicator& service_comm,
     PRINT_BY_ROOT(service_comm, "\n# All done\n");
 }
 
+/* tuning mode: algorithm and chunk count which the library is forced to use via ccl::set_tuning */
+typedef struct {
+    std::string algo;
+    std::string param_name; // chunk count variable used by the algorithm, empty if none
+    size_t param_value;
+} tune_config_t;
+
+std::vector<tune_config_t> get_tune_configs(const std::string& coll_name) {
+    static const std::map<std::string, std::vector<std::string>> coll_algos = {
+        { "allgather", { "direct", "naive", "ring", "flat", "multi_bcast" } },
+        { "allgatherv", { "direct", "naive", "ring", "flat", "multi_bcast" } },
+        { "allreduce",
+          { "direct",
+            "rabenseifner",
+            "nreduce",
+            "ring",
+            "ring_rma",
+            "double_tree",
+            "recursive_doubling",
+            "2d" } },
+        { "alltoall", { "direct", "naive", "scatter", "bruck" } },
+        { "alltoallv", { "direct", "naive", "scatter", "hier" } },
+        { "bcast", { "direct", "ring", "double_tree", "naive" } },
+        { "broadcast", { "direct", "ring", "double_tree", "naive" } },
+        { "reduce", { "direct", "rabenseifner", "ring", "tree", "double_tree" } },
+        { "reduce_scatter", { "direct", "naive", "ring" } }
+    };
+    static const std::map<std::string, std::string> algo_params = {
+        { "allreduce:ring", "CCL_RS_CHUNK_COUNT" },
+        { "allreduce:2d", "CCL_ALLREDUCE_2D_CHUNK_COUNT" },
+        { "alltoall:naive", "CCL_CHUNK_COUNT" },
+        { "alltoall:scatter", "CCL_CHUNK_COUNT" },
+        { "alltoallv:naive", "CCL_CHUNK_COUNT" },
+        { "alltoallv:scatter", "CCL_CHUNK_COUNT" },
+        { "reduce_scatter:ring", "CCL_RS_CHUNK_COUNT" }
+    };
+    static const std::vector<size_t> chunk_counts = { 1, 2, 4, 8 };
+
+    std::vector<tune_config_t> configs;
+    auto algos_it = coll_algos.find(coll_name);
+    if (algos_it == coll_algos.end())
+        return configs;
+
+    for (const auto& algo : algos_it->second) {
+        auto param_it = algo_params.find(coll_name + ":" + algo);
+        if (param_it == algo_params.end()) {
+            configs.push_back({ algo, "", 0 });
+            continue;
+        }
+        for (auto chunk_count : chunk_counts) {
+            configs.push_back({ algo, param_it->second, chunk_count });
+        }
+    }
+    return configs;
+}
+
+/* returns max time across ranks in usec or negative value if the library used other algorithm */
+double measure_tune_config(ccl::communicator& service_comm,
+                           ccl::communicator& comm,
+                           std::shared_ptr<base_coll> coll,
+                           bench_exec_attr& bench_attr,
+                           req_list_t& reqs,
+                           const user_options_t& options,
+                           const tune_config_t& config,
+                           size_t count) {
+    size_t bytes = count * ccl::get_datatype_size(coll->get_dtype());
+    size_t iter_count = get_iter_count(bytes, options.iters, options.iter_policy);
+    size_t warmup_iter_count = get_iter_count(bytes, options.warmup_iters, options.iter_policy);
+
+    ccl::reset_stats(comm);
+    ccl::barrier(service_comm);
+
+    double time = 0;
+    for (size_t iter_idx = 0; iter_idx < (iter_count + warmup_iter_count); iter_idx++) {
+        double start_time = when();
+        for (size_t buf_idx = 0; buf_idx < options.buf_count; buf_idx++) {
+            coll->start(count, buf_idx, bench_attr, reqs);
+        }
+        for (auto& req : reqs) {
+            req.wait();
+        }
+        reqs.clear();
+        if (iter_idx >= warmup_iter_count) {
+            time += when() - start_time;
+        }
+    }
+    time /= iter_count;
+
+    /* the library falls back to other algorithm if the requested one can't be used */
+    double fallback = 0;
+    for (const auto& stats : ccl::get_stats(comm)) {
+        if (config.algo != stats.algo_name.c_str()) {
+            fallback = 1;
+        }
+    }
+
+    std::vector<double> send_buf = { time, fallback };
+    std::vector<double> recv_buf(send_buf.size());
+    ccl::allreduce(
+        send_buf.data(), recv_buf.data(), send_buf.size(), ccl::reduction::max, service_comm)
+        .wait();
+
+    return (recv_buf[1] > 0) ? -1 : recv_buf[0];
+}
+
+/* "<value>:<size1-size2>;..." where range of value starts at its size and ends before next one */
+std::string make_tune_ranges(const std::vector<size_t>& sizes,
+                             const std::vector<std::string>& values) {
+    std::stringstream ss;
+    for (size_t idx = 0; idx < sizes.size(); idx++) {
+        if (values[idx].empty())
+            continue;
+
+        size_t left = (idx == 0) ? 0 : sizes[idx];
+        size_t end_idx = idx;
+        while (end_idx + 1 < sizes.size() && values[end_idx + 1] == values[idx]) {
+            end_idx++;
+        }
+
+        ss << ((ss.tellp() > 0) ? ";" : "") << values[idx] << ":" << left << "-";
+        if (end_idx + 1 < sizes.size())
+            ss << sizes[end_idx + 1] - 1;
+        else
+            ss << "max";
+        idx = end_idx;
+    }
+    return ss.str();
+}
+
+void write_tune_file(const std::string& path,
+                     size_t worker_count,
+                     size_t comm_size,
+                     const std::string& entry) {
+    /* keep entries of other worker counts and comm sizes, one entry per line as written below */
+    std::vector<std::string> entries;
+    std::ifstream in(path);
+    std::string line;
+    std::string worker_count_key = "\"worker_count\": ";
+    std::string comm_size_key = "\"comm_size\": ";
+    while (std::getline(in, line)) {
+        size_t worker_count_pos = line.find(worker_count_key);
+        size_t comm_size_pos = line.find(comm_size_key);
+        if (worker_count_pos == std::string::npos || comm_size_pos == std::string::npos)
+            continue;
+        if (std::stoul(line.substr(worker_count_pos + worker_count_key.size())) ==
+                worker_count &&
+            std::stoul(line.substr(comm_size_pos + comm_size_key.size())) == comm_size)
+            continue;
+        if (line.back() == ',')
+            line.pop_back();
+        entries.push_back(line);
+    }
+    in.close();
+    entries.push_back(entry);
+
+    std::ofstream out(path, std::ofstream::out | std::ofstream::trunc);
+    ASSERT(out.is_open(), "cannot open tuning file for writing: %s", path.c_str());
+    out << "{\n  \"tunings\": [\n";
+    for (size_t idx = 0; idx < entries.size(); idx++) {
+        out << entries[idx] << ((idx + 1 < entries.size()) ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+void tune(ccl::communicator& service_comm,
+          bench_exec_attr& bench_attr,
+          coll_list_t& all_colls,
+          req_list_t& reqs,
+          const user_options_t& options) {
+    ccl::communicator& comm = transport_data::instance().get_comms()[0];
+
+    /* sizes in the tuning are bytes, so one datatype and reduction are enough */
+    ccl::datatype dtype = all_colls.front()->get_dtype();
+    size_t dtype_size = ccl::get_datatype_size(dtype);
+    ccl::reduction reduction_op = ccl::reduction::sum;
+    find_key_val(reduction_op, reduction_names, options.reductions.front());
+    bench_attr.reduction = reduction_op;
+    bench_attr.set<ccl::operation_attr_id::to_cache>(false);
+
+    std::vector<size_t> counts(options.elem_counts.begin(), options.elem_counts.end());
+    std::sort(counts.begin(), counts.end());
+    counts.erase(std::unique(counts.begin(), counts.end()), counts.end());
+
+    const char* worker_count_env = getenv("CCL_WORKER_COUNT");
+    size_t worker_count = (worker_count_env) ? std::stoul(worker_count_env) : 1;
+
+    PRINT_BY_ROOT(service_comm,
+                  "\n# tuning: datatype %s, reduction %s, worker_count %zu",
+                  find_str_val(dtype_names, dtype).c_str(),
+                  find_str_val(reduction_names, reduction_op).c_str(),
+                  worker_count);
+
+    std::map<std::string, std::string> vars;
+    std::map<std::string, std::map<std::string, std::string>> coll_vars;
+    for (auto& coll : all_colls) {
+        if (coll->get_dtype() != dtype)
+            continue;
+
+        std::string coll_name = coll->name();
+        std::vector<tune_config_t> configs = get_tune_configs(coll_name);
+        if (configs.empty())
+            continue;
+
+        std::string var_name = "CCL_" + coll_name;
+        std::transform(var_name.begin(), var_name.end(), var_name.begin(), ::toupper);
+
+        /* sizes of selection and of chunked buffer, reduce_scatter is selected by recv count */
+        size_t size_divider = (coll_name == "reduce_scatter") ? service_comm.size() : 1;
+        std::vector<size_t> algo_sizes, param_sizes;
+        std::vector<std::string> algo_values;
+        std::map<std::string, std::vector<std::string>> param_values;
+
+        for (auto count : counts) {
+            size_t algo_size = count / size_divider * dtype_size;
+            if (!algo_sizes.empty() && algo_sizes.back() == algo_size)
+                continue;
+
+            double best_time = -1;
+            const tune_config_t* best_config = nullptr;
+            for (const auto& config : configs) {
+                std::stringstream json;
+                json << "{\"tunings\":[{\"vars\":{\"" << var_name << "\":\"" << config.algo
+                     << "\"}";
+                if (!config.param_name.empty()) {
+                    json << ",\"coll_vars\":{\"" << coll_name << "\":{\"" << config.param_name
+                         << "\":\"" << config.param_value << "\"}}";
+                }
+                json << "}]}";
+                ccl::set_tuning(json.str());
+
+                double time = -1;
+                try {
+                    time = measure_tune_config(
+                        service_comm, comm, coll, bench_attr, reqs, options, config, count);
+                }
+                catch (const std::exception& ex) {
+                    reqs.clear();
+                    PRINT_BY_ROOT(service_comm,
+                                  "# skip %s %s: %s",
+                                  coll_name.c_str(),
+                                  config.algo.c_str(),
+                                  ex.what());
+                }
+                if (time >= 0 && (best_time < 0 || time < best_time)) {
+                    best_time = time;
+                    best_config = &config;
+                }
+            }
+
+            if (!best_config)
+                continue;
+
+            std::string best_str = best_config->algo;
+            if (!best_config->param_name.empty()) {
+                best_str += " " + best_config->param_name + "=" +
+                            std::to_string(best_config->param_value);
+            }
+            PRINT_BY_ROOT(service_comm,
+                          "%s count %zu: %s, %.2f usec",
+                          coll_name.c_str(),
+                          count,
+                          best_str.c_str(),
+                          best_time);
+
+            algo_sizes.push_back(algo_size);
+            algo_values.push_back(best_config->algo);
+            param_sizes.push_back(algo_size * size_divider);
+            for (const auto& config : configs) {
+                if (!config.param_name.empty()) {
+                    param_values[config.param_name].resize(algo_values.size());
+                }
+            }
+            if (!best_config->param_name.empty()) {
+                param_values[best_config->param_name].back() =
+                    std::to_string(best_config->param_value);
+            }
+        }
+
+        if (algo_sizes.empty())
+            continue;
+
+        vars[var_name] = make_tune_ranges(algo_sizes, algo_values);
+        /* chunk counts are shared by collectives, e.g. by ring allreduce and reduce_scatter */
+        for (const auto& param : param_values) {
+            std::string ranges = make_tune_ranges(param_sizes, param.second);
+            if (!ranges.empty())
+                coll_vars[coll_name][param.first] = ranges;
+        }
+    }
+
+    ccl::set_tuning("");
+
+    if (service_comm.rank() == 0) {
+        std::stringstream entry;
+        entry << "    { \"worker_count\": " << worker_count
+              << ", \"comm_size\": " << service_comm.size() << ", \"vars\": { ";
+        for (auto it = vars.begin(); it != vars.end(); ++it) {
+            entry << ((it != vars.begin()) ? ", " : "") << "\"" << it->first << "\": \""
+                  << it->second << "\"";
+        }
+        entry << " }, \"coll_vars\": { ";
+        for (auto coll_it = coll_vars.begin(); coll_it != coll_vars.end(); ++coll_it) {
+            entry << ((coll_it != coll_vars.begin()) ? ", " : "") << "\"" << coll_it->first
+                  << "\": { ";
+            for (auto it = coll_it->second.begin(); it != coll_it->second.end(); ++it) {
+                entry << ((it != coll_it->second.begin()) ? ", " : "") << "\"" << it->first
+                      << "\": \"" << it->second << "\"";
+            }
+            entry << " }";
+        }
+        entry << " } }";
+        write_tune_file(options.tune_filepath, worker_count, service_comm.size(), entry.str());
+        PRINT("\n# tuning is written to %s\n", options.tune_filepath.c_str());
+    }
+
+    ccl::barrier(service_comm);
+}
+
 template <class Dtype>
 void create_cpu_colls(bench_init_attr& init_attr, user_options_t& options, coll_list_t& colls) {
     std::stringstream error_messages_stream;
@@ -441,7 +761,12 @@ int main(int argc, char* argv[]) {
 
     ccl::barrier(service_comm);
 
-    run(service_comm, bench_attr, colls, reqs, options);
+    if (options.tune_filepath.empty()) {
+        run(service_comm, bench_attr, colls, reqs, options);
+    }
+    else {
+        tune(service_comm, bench_attr, colls, reqs, options);
+    }
 
     ccl::barrier(service_comm);
 
@@ -0,0 +1,277 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+/*
+   per byte throughput of bf16 and fp16 allreduce compared to fp32:
+   the reduction of low precision types converts to fp32 and back,
+   so its cost depends on the selected implementation
+
+   run on a single node with CCL_BF16=scalar/avx2/... and CCL_FP16=f16c/...
+   to compare the implementations
+*/
+
+#include <cstring>
+#include <getopt.h>
+
+#include "base.hpp"
+
+#define DEFAULT_ITERS     (64)
+#define DEFAULT_WARMUP    (8)
+#define DEFAULT_MIN_COUNT (65536)
+#define DEFAULT_MAX_COUNT (4194304)
+
+typedef struct {
+    size_t iters;
+    size_t warmup_iters;
+    size_t min_count;
+    size_t max_count;
+} lp_reduce_options_t;
+
+/* exact for the small integers used below */
+static uint16_t float_to_bf16(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return static_cast<uint16_t>(bits >> 16);
+}
+
+static float bf16_to_float(uint16_t value) {
+    uint32_t bits = static_cast<uint32_t>(value) << 16;
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+static uint16_t float_to_fp16(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    if ((bits & 0x7fffffff) == 0)
+        return static_cast<uint16_t>(bits >> 16);
+    uint32_t sign = (bits >> 16) & 0x8000;
+    uint32_t exp = ((bits >> 23) & 0xff) - 127 + 15;
+    uint32_t mantissa = (bits >> 13) & 0x3ff;
+    return static_cast<uint16_t>(sign | (exp << 10) | mantissa);
+}
+
+static float fp16_to_float(uint16_t value) {
+    if ((value & 0x7fff) == 0)
+        return 0;
+    uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+    uint32_t exp = ((value >> 10) & 0x1f) - 15 + 127;
+    uint32_t mantissa = static_cast<uint32_t>(value & 0x3ff) << 13;
+    uint32_t bits = sign | (exp << 23) | mantissa;
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+static void print_help() {
+    PRINT("\nUSAGE: lp_reduce [OPTIONS]\n\n"
+          "\t[-i,--iters <iteration count>]: %d\n"
+          "\t[-w,--warmup_iters <warm up iteration count>]: %d\n"
+          "\t[-f,--min_count <minimum element count>]: %d\n"
+          "\t[-t,--max_count <maximum element count>]: %d\n"
+          "\t[-h,--help]\n",
+          DEFAULT_ITERS,
+          DEFAULT_WARMUP,
+          DEFAULT_MIN_COUNT,
+          DEFAULT_MAX_COUNT);
+}
+
+static int parse_options(int argc, char* argv[], lp_reduce_options_t& options) {
+    const char* const short_options = "i:w:f:t:h";
+    struct option getopt_options[] = { { "iters", required_argument, nullptr, 'i' },
+                                       { "warmup_iters", required_argument, nullptr, 'w' },
+                                       { "min_count", required_argument, nullptr, 'f' },
+                                       { "max_count", required_argument, nullptr, 't' },
+                                       { "help", no_argument, nullptr, 'h' },
+                                       { nullptr, 0, nullptr, 0 } };
+
+    int ch;
+    while ((ch = getopt_long(argc, argv, short_options, getopt_options, nullptr)) != -1) {
+        if (ch == 'h') {
+            print_help();
+            return -1;
+        }
+        if (!is_valid_integer_option(optarg)) {
+            PRINT("unexpected value %s for option %c", optarg, ch);
+            return -1;
+        }
+        size_t value = atol(optarg);
+        switch (ch) {
+            case 'i': options.iters = value; break;
+            case 'w': options.warmup_iters = value; break;
+            case 'f': options.min_count = value; break;
+            case 't': options.max_count = value; break;
+            default: print_help(); return -1;
+        }
+    }
+
+    if (!options.iters || !options.min_count || (options.min_count > options.max_count)) {
+        PRINT("iters and min_count should be positive, min_count should not exceed max_count");
+        return -1;
+    }
+
+    return 0;
+}
+
+struct lp_dtype {
+    const char* name;
+    ccl::datatype dtype;
+    size_t size;
+};
+
+/* returns average time of allreduce in usec, buffers are filled and checked in float */
+static double run_allreduce(const lp_dtype& type,
+                            size_t count,
+                            const lp_reduce_options_t& options,
+                            ccl::communicator& comm) {
+    int size = comm.size();
+    int rank = comm.rank();
+
+    std::vector<char> send_buf(count * type.size);
+    std::vector<char> recv_buf(count * type.size);
+
+    float send_value = static_cast<float>(rank + 1);
+    for (size_t idx = 0; idx < count; idx++) {
+        if (type.dtype == ccl::datatype::float32) {
+            reinterpret_cast<float*>(send_buf.data())[idx] = send_value;
+        }
+        else {
+            reinterpret_cast<uint16_t*>(send_buf.data())[idx] =
+                (type.dtype == ccl::datatype::bfloat16) ? float_to_bf16(send_value)
+                                                        : float_to_fp16(send_value);
+        }
+    }
+
+    double total_time = 0;
+    for (size_t iter = 0; iter < options.warmup_iters + options.iters; iter++) {
+        ccl::barrier(comm);
+
+        double start_time = when();
+        ccl::allreduce(send_buf.data(),
+                       recv_buf.data(),
+                       count,
+                       type.dtype,
+                       ccl::reduction::sum,
+                       comm)
+            .wait();
+        double end_time = when();
+
+        if (iter >= options.warmup_iters) {
+            total_time += end_time - start_time;
+        }
+    }
+
+    float expected = static_cast<float>(size * (size + 1) / 2);
+    for (size_t idx = 0; idx < count; idx++) {
+        float value;
+        if (type.dtype == ccl::datatype::float32) {
+            value = reinterpret_cast<float*>(recv_buf.data())[idx];
+        }
+        else {
+            uint16_t raw = reinterpret_cast<uint16_t*>(recv_buf.data())[idx];
+            value = (type.dtype == ccl::datatype::bfloat16) ? bf16_to_float(raw)
+                                                            : fp16_to_float(raw);
+        }
+        ASSERT(value == expected,
+               "%s, count %zu, elem %zu: expected %f, got %f",
+               type.name,
+               count,
+               idx,
+               expected,
+               value);
+    }
+
+    double avg_time = total_time / options.iters;
+    double max_avg_time = 0;
+    MPI_Allreduce(&avg_time, &max_avg_time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+    return max_avg_time;
+}
+
+int main(int argc, char* argv[]) {
+    lp_reduce_options_t options = {
+        DEFAULT_ITERS, DEFAULT_WARMUP, DEFAULT_MIN_COUNT, DEFAULT_MAX_COUNT
+    };
+
+    if (parse_options(argc, argv, options)) {
+        return -1;
+    }
+
+    ccl::init();
+
+    int size, rank;
+    MPI_Init(NULL, NULL);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    atexit(mpi_finalize);
+
+    ccl::shared_ptr_class<ccl::kvs> kvs;
+    ccl::kvs::address_type main_addr;
+    if (rank == 0) {
+        kvs = ccl::create_main_kvs();
+        main_addr = kvs->get_address();
+        MPI_Bcast((void*)main_addr.data(), main_addr.size(), MPI_BYTE, 0, MPI_COMM_WORLD);
+    }
+    else {
+        MPI_Bcast((void*)main_addr.data(), main_addr.size(), MPI_BYTE, 0, MPI_COMM_WORLD);
+        kvs = ccl::create_kvs(main_addr);
+    }
+
+    auto comm = ccl::create_communicator(size, rank, kvs);
+
+    const std::vector<lp_dtype> types = { { "float32", ccl::datatype::float32, sizeof(float) },
+                                          { "bfloat16", ccl::datatype::bfloat16, 2 },
+                                          { "float16", ccl::datatype::float16, 2 } };
+
+    const char* bf16_env = getenv("CCL_BF16");
+    const char* fp16_env = getenv("CCL_FP16");
+    PRINT_BY_ROOT(comm,
+                  "ranks %d, CCL_BF16 %s, CCL_FP16 %s",
+                  size,
+                  bf16_env ? bf16_env : "default",
+                  fp16_env ? fp16_env : "default");
+    PRINT_BY_ROOT(comm,
+                  "%10s %12s %14s %12s %16s",
+                  "dtype",
+                  "count",
+                  "t_avg[usec]",
+                  "MB/s",
+                  "per byte vs fp32");
+
+    for (size_t count = options.min_count; count <= options.max_count; count *= 2) {
+        double fp32_byte_time = 0;
+        for (const auto& type : types) {
+            double avg_time = run_allreduce(type, count, options, comm);
+            double byte_time = avg_time / (count * type.size);
+            if (type.dtype == ccl::datatype::float32) {
+                fp32_byte_time = byte_time;
+            }
+            PRINT_BY_ROOT(comm,
+                          "%10s %12zu %14.2f %12.2f %16.2f",
+                          type.name,
+                          count,
+                          avg_time,
+                          count * type.size / avg_time,
+                          byte_time / fp32_byte_time);
+        }
+    }
+
+    PRINT_BY_ROOT(comm, "PASSED");
+
+    return 0;
+}
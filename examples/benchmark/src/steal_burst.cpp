@@ -0,0 +1,200 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+/*
+   skewed burst of allreduces to measure worker stealing:
+   scheds are assigned to workers by sched id, so with every worker_count-th
+   allreduce being large, one worker gets all large allreduces while others idle
+
+   run with the same CCL_WORKER_COUNT (4..8) and CCL_WORKER_STEAL=0/1 to compare
+*/
+
+#include <getopt.h>
+#include <set>
+#include <sstream>
+
+#include "base.hpp"
+
+#define DEFAULT_ITERS       (16)
+#define DEFAULT_WARMUP      (4)
+#define DEFAULT_BURST       (32)
+#define DEFAULT_LARGE_COUNT (1048576)
+#define DEFAULT_SMALL_COUNT (1024)
+
+typedef struct {
+    size_t iters;
+    size_t warmup_iters;
+    size_t burst;
+    size_t large_count;
+    size_t small_count;
+} steal_burst_options_t;
+
+static void print_help() {
+    PRINT("\nUSAGE: steal_burst [OPTIONS]\n\n"
+          "\t[-i,--iters <iteration count>]: %d\n"
+          "\t[-w,--warmup_iters <warm up iteration count>]: %d\n"
+          "\t[-b,--burst <allreduce count per iteration>]: %d\n"
+          "\t[-l,--large_count <element count of large allreduce>]: %d\n"
+          "\t[-s,--small_count <element count of small allreduce>]: %d\n"
+          "\t[-h,--help]\n",
+          DEFAULT_ITERS,
+          DEFAULT_WARMUP,
+          DEFAULT_BURST,
+          DEFAULT_LARGE_COUNT,
+          DEFAULT_SMALL_COUNT);
+}
+
+static int parse_options(int argc, char* argv[], steal_burst_options_t& options) {
+    const char* const short_options = "i:w:b:l:s:h";
+    struct option getopt_options[] = { { "iters", required_argument, nullptr, 'i' },
+                                       { "warmup_iters", required_argument, nullptr, 'w' },
+                                       { "burst", required_argument, nullptr, 'b' },
+                                       { "large_count", required_argument, nullptr, 'l' },
+                                       { "small_count", required_argument, nullptr, 's' },
+                                       { "help", no_argument, nullptr, 'h' },
+                                       { nullptr, 0, nullptr, 0 } };
+
+    int ch;
+    while ((ch = getopt_long(argc, argv, short_options, getopt_options, nullptr)) != -1) {
+        if (ch == 'h') {
+            print_help();
+            return -1;
+        }
+        if (!is_valid_integer_option(optarg)) {
+            PRINT("unexpected value %s for option %c", optarg, ch);
+            return -1;
+        }
+        size_t value = atol(optarg);
+        switch (ch) {
+            case 'i': options.iters = value; break;
+            case 'w': options.warmup_iters = value; break;
+            case 'b': options.burst = value; break;
+            case 'l': options.large_count = value; break;
+            case 's': options.small_count = value; break;
+            default: print_help(); return -1;
+        }
+    }
+
+    if (!options.iters || !options.burst || !options.large_count || !options.small_count) {
+        PRINT("iters, burst and counts should be positive");
+        return -1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    steal_burst_options_t options = { DEFAULT_ITERS,
+                                      DEFAULT_WARMUP,
+                                      DEFAULT_BURST,
+                                      DEFAULT_LARGE_COUNT,
+                                      DEFAULT_SMALL_COUNT };
+
+    if (parse_options(argc, argv, options)) {
+        return -1;
+    }
+
+    const char* worker_count_env = getenv("CCL_WORKER_COUNT");
+    size_t worker_count = worker_count_env ? std::max(atoi(worker_count_env), 1) : 1;
+
+    ccl::init();
+
+    int size, rank;
+    MPI_Init(NULL, NULL);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    atexit(mpi_finalize);
+
+    ccl::shared_ptr_class<ccl::kvs> kvs;
+    ccl::kvs::address_type main_addr;
+    if (rank == 0) {
+        kvs = ccl::create_main_kvs();
+        main_addr = kvs->get_address();
+        MPI_Bcast((void*)main_addr.data(), main_addr.size(), MPI_BYTE, 0, MPI_COMM_WORLD);
+    }
+    else {
+        MPI_Bcast((void*)main_addr.data(), main_addr.size(), MPI_BYTE, 0, MPI_COMM_WORLD);
+        kvs = ccl::create_kvs(main_addr);
+    }
+
+    auto comm = ccl::create_communicator(size, rank, kvs);
+
+    /* consecutive allreduces go to consecutive workers, so large ones share the same worker */
+    std::vector<size_t> counts(options.burst);
+    std::vector<std::vector<float>> send_bufs(options.burst);
+    std::vector<std::vector<float>> recv_bufs(options.burst);
+    for (size_t idx = 0; idx < options.burst; idx++) {
+        counts[idx] = (idx % worker_count == 0) ? options.large_count : options.small_count;
+        send_bufs[idx].assign(counts[idx], static_cast<float>(rank + 1));
+        recv_bufs[idx].assign(counts[idx], 0);
+    }
+
+    std::vector<ccl::event> events;
+    events.reserve(options.burst);
+    double total_time = 0;
+
+    for (size_t iter = 0; iter < options.warmup_iters + options.iters; iter++) {
+        ccl::barrier(comm);
+
+        double start_time = when();
+        for (size_t idx = 0; idx < options.burst; idx++) {
+            events.push_back(ccl::allreduce(send_bufs[idx].data(),
+                                            recv_bufs[idx].data(),
+                                            counts[idx],
+                                            ccl::reduction::sum,
+                                            comm));
+        }
+        for (auto& event : events) {
+            event.wait();
+        }
+        double end_time = when();
+        events.clear();
+
+        if (iter >= options.warmup_iters) {
+            total_time += end_time - start_time;
+        }
+    }
+
+    float expected = static_cast<float>(size * (size + 1) / 2);
+    for (size_t idx = 0; idx < options.burst; idx++) {
+        for (size_t elem_idx = 0; elem_idx < counts[idx]; elem_idx++) {
+            ASSERT(recv_bufs[idx][elem_idx] == expected,
+                   "allreduce %zu, elem %zu: expected %f, got %f",
+                   idx,
+                   elem_idx,
+                   expected,
+                   recv_bufs[idx][elem_idx]);
+        }
+    }
+
+    double avg_time = total_time / options.iters;
+    double max_avg_time = 0;
+    MPI_Reduce(&avg_time, &max_avg_time, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    PRINT_BY_ROOT(comm,
+                  "ranks %d, worker_count %zu, burst %zu, large_count %zu, small_count %zu, "
+                  "t_avg[usec] %.2f",
+                  size,
+                  worker_count,
+                  options.burst,
+                  options.large_count,
+                  options.small_count,
+                  max_avg_time);
+    PRINT_BY_ROOT(comm, "PASSED");
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+/*
+   contention test for sched submission:
+   many user threads submit small allreduces concurrently, each thread uses its own communicator
+
+   usage: cpu_allreduce_mt_test [thread_count] [iter_count] [elem_count]
+*/
+
+#include <chrono>
+#include <iostream>
+#include <mpi.h>
+#include <thread>
+#include <vector>
+
+#include "base.hpp"
+#include "oneapi/ccl.hpp"
+
+using namespace std;
+
+int main(int argc, char** argv) {
+    size_t thread_count = (argc > 1) ? atoi(argv[1]) : 8;
+    size_t iter_count = (argc > 2) ? atoi(argv[2]) : 10000;
+    size_t count = (argc > 3) ? atoi(argv[3]) : 16;
+
+    ccl::init();
+
+    int size, rank;
+    MPI_Init(NULL, NULL);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    atexit(mpi_finalize);
+
+    /* communicators are created one by one, each needs its own kvs */
+    vector<ccl::communicator> comms;
+    for (size_t idx = 0; idx < thread_count; idx++) {
+        ccl::shared_ptr_class<ccl::kvs> kvs;
+        ccl::kvs::address_type main_addr;
+        if (rank == 0) {
+            kvs = ccl::create_main_kvs();
+            main_addr = kvs->get_address();
+            MPI_Bcast((void*)main_addr.data(), main_addr.size(), MPI_BYTE, 0, MPI_COMM_WORLD);
+        }
+        else {
+            MPI_Bcast((void*)main_addr.data(), main_addr.size(), MPI_BYTE, 0, MPI_COMM_WORLD);
+            kvs = ccl::create_kvs(main_addr);
+        }
+        comms.push_back(ccl::create_communicator(size, rank, kvs));
+    }
+
+    vector<size_t> errors(thread_count, 0);
+
+    auto thread_func = [&](size_t thread_idx) {
+        auto& comm = comms[thread_idx];
+        vector<float> send_buf(count), recv_buf(count);
+
+        for (size_t iter = 0; iter < iter_count; iter++) {
+            for (size_t i = 0; i < count; i++) {
+                send_buf[i] = static_cast<float>(comm.rank() + iter % 8);
+                recv_buf[i] = -1;
+            }
+
+            ccl::allreduce(send_buf.data(), recv_buf.data(), count, ccl::reduction::sum, comm)
+                .wait();
+
+            float expected = static_cast<float>(size * (size - 1) / 2 + size * (iter % 8));
+            for (size_t i = 0; i < count; i++) {
+                if (recv_buf[i] != expected) {
+                    errors[thread_idx]++;
+                    break;
+                }
+            }
+        }
+    };
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    auto start = chrono::steady_clock::now();
+
+    vector<thread> threads;
+    for (size_t idx = 0; idx < thread_count; idx++) {
+        threads.emplace_back(thread_func, idx);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    double usec = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+
+    size_t total_errors = 0;
+    for (auto e : errors) {
+        total_errors += e;
+    }
+
+    if (rank == 0) {
+        size_t op_count = thread_count * iter_count;
+        cout << "threads: " << thread_count << ", iters: " << iter_count << ", count: " << count
+             << ", total usec: " << usec << ", ops/sec: " << op_count / (usec / 1e6)
+             << ", avg usec per op per thread: " << usec / iter_count << "\n";
+        cout << (total_errors ? "FAILED" : "PASSED") << "\n";
+    }
+
+    return 0;
+}
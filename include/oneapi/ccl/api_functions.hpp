@@ -479,6 +479,43 @@ void CCL_API group_start();
 void CCL_API group_end();
 /** @} */ // end of group_calls
 
+/******************** STATS ********************/
+
+/** @defgroup stats
+ * @{
+ */
+/**
+ * \ingroup stats
+ * \brief Retrieves latency statistics of collective operations completed on the communicator.
+ *        Statistics are collected when CCL_COLL_STATS is enabled (default)
+ * @param comm the communicator
+ * @return statistics per collective type, algorithm and message size bucket
+ */
+vector_class<coll_stats> CCL_API get_stats(const communicator& comm);
+
+/**
+ * \ingroup stats
+ * \brief Clears latency statistics collected on the communicator
+ * @param comm the communicator
+ */
+void CCL_API reset_stats(const communicator& comm);
+/** @} */ // end of stats
+
+/******************** TUNING ********************/
+
+/** @defgroup tuning
+ * @{
+ */
+/**
+ * \ingroup tuning
+ * \brief Replaces the tuning loaded from CCL_TUNING_FILE: selection tables and chunk counts
+ *        per message size, the format is described in CCL_TUNING_FILE.
+ *        Should be called on all ranks when no collective operations are in flight
+ * @param tuning tuning in JSON format, empty string drops the tuning
+ */
+void CCL_API set_tuning(const string_class& tuning);
+/** @} */ // end of tuning
+
 /******************** OPERATION ********************/
 
 /** @defgroup operation
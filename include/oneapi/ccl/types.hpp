@@ -115,6 +115,25 @@ typedef struct {
     string_class cl_backend_name;
 } library_version;
 
+/**
+ * Latency statistics of collective operations of the same type and algorithm
+ * whose message size falls into [min_bytes, max_bytes)
+ */
+typedef struct {
+    string_class coll_name;
+    string_class algo_name;
+    size_t min_bytes;
+    size_t max_bytes;
+    size_t call_count;
+    size_t total_bytes;
+    double min_usec;
+    double max_usec;
+    double avg_usec;
+    double p50_usec;
+    double p90_usec;
+    double p99_usec;
+} coll_stats;
+
 typedef struct {
     const char* match_id;
     const size_t offset;
@@ -133,6 +152,7 @@ struct ccl_empty_attr {
 } // namespace v1
 
 using v1::library_version;
+using v1::coll_stats;
 using v1::fn_context;
 using v1::reduction_fn;
 using v1::ccl_empty_attr;
@@ -21,6 +21,8 @@
 #include "atl/atl_base_comm.hpp"
 #include "atl/ofi/atl_ofi_comm.hpp"
 #include "atl/ofi/atl_ofi.hpp"
+#include "atl/shm/atl_shm_comm.hpp"
+#include "atl/shm/atl_shm.hpp"
 #include "atl/util/pm/pm_rt.h"
 #include "common/utils/utils.hpp"
 #include "comm/atl_tag.hpp"
@@ -51,6 +53,7 @@ atl_attr_t atl_base_comm::attr = {
         0, /* tag_bits */
         0, /* max_tag */
         0, /* max_order_waw_size */
+        {}, /* nic_numa_nodes */
     }
 };
 
@@ -154,6 +157,10 @@ void atl_base_comm::init_tag() {
                     new ccl_atl_tag_impl<common_tag_layout>(tag_bits, max_tag));
             }
             break;
+        case ccl_atl_shm:
+            tag_creator = std::shared_ptr<ccl_atl_tag>(
+                new ccl_atl_tag_impl<common_tag_layout>(tag_bits, max_tag));
+            break;
 #ifdef CCL_ENABLE_MPI
         case ccl_atl_mpi:
             CCL_THROW_IF_NOT(max_tag >= mpi_tag_layout::op_id_mask + mpi_tag_layout::sched_id_mask,
@@ -185,6 +192,7 @@ std::shared_ptr<atl_base_comm> atl_comm_manager::create() {
 
     switch (transport_type) {
         case ccl_atl_ofi: atl_comm = std::shared_ptr<atl_base_comm>(new atl_ofi_comm()); break;
+        case ccl_atl_shm: atl_comm = std::shared_ptr<atl_base_comm>(new atl_shm_comm()); break;
 #ifdef CCL_ENABLE_MPI
         case ccl_atl_mpi: atl_comm = std::shared_ptr<atl_base_comm>(new atl_mpi_comm()); break;
 #endif // CCL_ENABLE_MPI
@@ -200,6 +208,7 @@ std::shared_ptr<atl_base_comm> atl_comm_manager::create(std::shared_ptr<ikvs_wra
 
     switch (transport_type) {
         case ccl_atl_ofi: atl_comm = std::shared_ptr<atl_base_comm>(new atl_ofi_comm(k)); break;
+        case ccl_atl_shm: atl_comm = std::shared_ptr<atl_base_comm>(new atl_shm_comm(k)); break;
 #ifdef CCL_ENABLE_MPI
         case ccl_atl_mpi: atl_comm = std::shared_ptr<atl_base_comm>(new atl_mpi_comm(k)); break;
 #endif // CCL_ENABLE_MPI
@@ -219,6 +228,9 @@ std::shared_ptr<atl_base_comm> atl_comm_manager::create(int comm_size,
         case ccl_atl_ofi:
             atl_comm = std::shared_ptr<atl_base_comm>(new atl_ofi_comm(comm_size, ranks, k));
             break;
+        case ccl_atl_shm:
+            atl_comm = std::shared_ptr<atl_base_comm>(new atl_shm_comm(comm_size, ranks, k));
+            break;
 #ifdef CCL_ENABLE_MPI
         case ccl_atl_mpi:
             atl_comm = std::shared_ptr<atl_base_comm>(new atl_mpi_comm(comm_size, ranks, k));
@@ -243,6 +255,12 @@ std::shared_ptr<atl_base_comm> atl_comm_manager::create_with_id(
             atl_comm = std::shared_ptr<atl_base_comm>(new atl_ofi_comm(*ofi_base_comm.get()));
             break;
         }
+        case ccl_atl_shm: {
+            std::shared_ptr<atl_shm_comm> shm_base_comm =
+                std::dynamic_pointer_cast<atl_shm_comm>(base_comm);
+            atl_comm = std::shared_ptr<atl_base_comm>(new atl_shm_comm(*shm_base_comm.get()));
+            break;
+        }
 #ifdef CCL_ENABLE_MPI
         case ccl_atl_mpi: {
             std::shared_ptr<atl_mpi_comm> mpi_base_comm =
@@ -266,6 +284,8 @@ void atl_comm_manager::set_internal_env(const atl_attr_t& attr) {
 
     if (transport_type == ccl_atl_ofi)
         atl_ofi::set_env(attr);
+    else if (transport_type == ccl_atl_shm)
+        atl_shm::set_env(attr);
 #ifdef CCL_ENABLE_MPI
     else if (transport_type == ccl_atl_mpi)
         atl_mpi::set_env(attr);
@@ -213,6 +213,10 @@ public:
         return transport->poll(eps[ep_idx]);
     }
 
+    virtual atl_status_t poll_wait(size_t ep_idx, int timeout_ms) {
+        return transport->poll_wait(eps[ep_idx], timeout_ms);
+    }
+
     virtual atl_status_t check(size_t ep_idx, atl_req_t& req) {
         return transport->check(eps[ep_idx], req);
     }
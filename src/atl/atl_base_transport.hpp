@@ -179,6 +179,13 @@ public:
 
     virtual atl_status_t poll(atl_ep_t& ep) = 0;
 
+    /*
+       blocks until at least one completion is processed or timeout expires,
+       returns ATL_STATUS_AGAIN on timeout and ATL_STATUS_UNSUPPORTED
+       if transport has no wait object to block on
+    */
+    virtual atl_status_t poll_wait(atl_ep_t& ep, int timeout_ms) = 0;
+
     virtual atl_status_t check(atl_ep_t& ep, atl_req_t& req) = 0;
 
     virtual atl_proc_coord_t create_proc_coord(atl_ep_t& ep) = 0;
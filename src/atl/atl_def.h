@@ -124,6 +124,7 @@ inline const char* atl_status_to_str(atl_status_t status) {
     switch (status) {
         case ATL_STATUS_SUCCESS: return "SUCCESS";
         case ATL_STATUS_FAILURE: return "FAILURE";
+        case ATL_STATUS_AGAIN: return "AGAIN";
         case ATL_STATUS_UNSUPPORTED: return "UNSUPPORTED";
         default: return "UNKNOWN";
     }
@@ -182,6 +183,8 @@ typedef struct atl_attr {
         size_t tag_bits;
         uint64_t max_tag;
         size_t max_order_waw_size;
+        /* NUMA nodes closest to selected NICs in order of their use by eps, -1 if unknown */
+        std::vector<int> nic_numa_nodes;
     } out;
 } atl_attr_t;
 
@@ -567,6 +567,11 @@ atl_status_t atl_mpi::poll(atl_ep_t& ep) {
     return ATL_STATUS_SUCCESS;
 }
 
+atl_status_t atl_mpi::poll_wait(atl_ep_t& ep, int timeout_ms) {
+    /* MPI progress is driven only by test calls, there is nothing to block on */
+    return ATL_STATUS_UNSUPPORTED;
+}
+
 atl_status_t atl_mpi::check(atl_ep_t& ep, atl_req_t& req) {
     atl_status_t status;
 
@@ -221,6 +221,8 @@ public:
 
     atl_status_t poll(atl_ep_t& ep) override;
 
+    atl_status_t poll_wait(atl_ep_t& ep, int timeout_ms) override;
+
     atl_status_t check(atl_ep_t& ep, atl_req_t& req) override;
 
     atl_proc_coord_t create_proc_coord(atl_ep_t& ep) override;
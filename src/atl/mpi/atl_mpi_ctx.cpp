@@ -60,7 +60,7 @@ void fp16_base_op(void* in, void* inout, int* length, ccl::reduction op) {
     unsigned short* inout_buf = (unsigned short*)inout;
 
     size_t len = *length;
-    ccl_fp16_reduce_impl(in_buf, inout_buf, len, op);
+    ccl_fp16_reduce_impl(in_buf, inout_buf, len, op, 1);
 }
 
 void fp16_sum_op(void* in, void* inout, int* length, MPI_Datatype* datatype) {
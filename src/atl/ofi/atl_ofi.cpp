@@ -245,6 +245,11 @@ atl_status_t atl_ofi::init(int* argc,
     attr->out.mnic_type = ctx.mnic_type;
     attr->out.mnic_count = ctx.mnic_count;
     attr->out.max_order_waw_size = 0;
+    attr->out.nic_numa_nodes.clear();
+    for (size_t idx = 0; idx < ctx.nw_prov_count; idx++) {
+        attr->out.nic_numa_nodes.push_back(
+            atl_ofi_get_nic_numa_node(ctx.provs[ctx.nw_prov_first_idx + idx].info));
+    }
 
     return ATL_STATUS_SUCCESS;
 
@@ -367,6 +372,7 @@ atl_status_t atl_ofi::send(atl_ep_t& ep,
     ofi_req = ((atl_ofi_req_t*)req.internal);
 
     cache.get(ep, prov, const_cast<void*>(buf), len, &ofi_req->mr);
+    mr_guard guard(this, ep, ofi_req);
     void* desc = (ofi_req->mr) ? fi_mr_desc(ofi_req->mr) : nullptr;
 
     struct iovec iov;
@@ -384,6 +390,9 @@ atl_status_t atl_ofi::send(atl_ep_t& ep,
     msg.data = 0;
 
     ATL_OFI_RETRY(fi_tsendmsg(prov_ep->tx, &msg, 0), ep, ret);
+    if (ret == FI_SUCCESS) {
+        guard.set_posted();
+    }
 
     return ATL_OFI_RET(ret);
 }
@@ -408,6 +417,7 @@ atl_status_t atl_ofi::recv(atl_ep_t& ep,
     ofi_req = ((atl_ofi_req_t*)req.internal);
 
     cache.get(ep, prov, const_cast<void*>(buf), len, &ofi_req->mr);
+    mr_guard guard(this, ep, ofi_req);
     void* desc = (ofi_req->mr) ? fi_mr_desc(ofi_req->mr) : nullptr;
 
     struct iovec iov;
@@ -425,6 +435,9 @@ atl_status_t atl_ofi::recv(atl_ep_t& ep,
     msg.data = 0;
 
     ATL_OFI_RETRY(fi_trecvmsg(prov_ep->rx, &msg, 0), ep, ret);
+    if (ret == FI_SUCCESS) {
+        guard.set_posted();
+    }
 
     return ATL_OFI_RET(ret);
 }
@@ -647,7 +660,11 @@ atl_status_t atl_ofi::cancel(atl_ep_t& ep, atl_req_t& req) {
 
     ret = fi_cancel(&ofi_req->fi_ep->fid, &ofi_req->fi_ctx);
     if (ret == 0) {
-        return ATL_OFI_RET(atl_ofi_wait_cancel_cq(ofi_req->prov_ep->cq));
+        /* cancel completion is consumed here, so the regular completion path is not taken */
+        ret = atl_ofi_wait_cancel_cq(ofi_req->prov_ep->cq);
+        ofi_req->comp_state = ATL_OFI_COMP_COMPLETED;
+        release_mr(ep, ofi_req);
+        return ATL_OFI_RET(ret);
     }
 
     return ATL_STATUS_SUCCESS;
@@ -660,6 +677,37 @@ atl_status_t atl_ofi::poll(atl_ep_t& ep) {
     return ATL_STATUS_SUCCESS;
 }
 
+atl_status_t atl_ofi::poll_wait(atl_ep_t& ep, int timeout_ms) {
+    atl_ofi_ep_t* ofi_ep = ((atl_ofi_ep_t*)ep.internal);
+
+    /* blocking on several cqs would require wait set */
+    if (ofi_ep->active_prov_count != 1) {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_ofi_prov_ep_t* prov_ep = &(ctx.provs[ofi_ep->active_prov_idxs[0]].eps[ep.idx]);
+    if (!prov_ep->cq_wait) {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    struct fi_cq_tagged_entry entries[ATL_OFI_CQ_BUNCH_SIZE];
+    ssize_t ret = fi_cq_sread(prov_ep->cq, entries, ATL_OFI_CQ_BUNCH_SIZE, nullptr, timeout_ms);
+    if (ret > 0) {
+        process_comps(ep, entries, ret);
+        return progress_ep(ep);
+    }
+    else if (ret == -FI_EAGAIN) {
+        return ATL_STATUS_AGAIN;
+    }
+    else if (ret == -FI_ENOSYS) {
+        LOG_DEBUG("fi_cq_sread is not supported, disable cq wait");
+        prov_ep->cq_wait = false;
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    return prov_ep_handle_cq_err(ep, prov_ep);
+}
+
 atl_status_t atl_ofi::check(atl_ep_t& ep, atl_req_t& req) {
     atl_status_t status;
     atl_ofi_req_t* ofi_req;
@@ -1019,7 +1067,7 @@ atl_status_t atl_ofi::progress_ep(atl_ep_t& ep) {
             else if (ret == -FI_EAGAIN)
                 break;
             else
-                return prov_ep_handle_cq_err(prov_ep);
+                return prov_ep_handle_cq_err(ep, prov_ep);
         } while (ret > 0);
     }
 
@@ -1034,7 +1082,7 @@ void atl_ofi::process_comps(atl_ep_t& ep, struct fi_cq_tagged_entry* entries, ss
         switch (comp_ofi_req->comp_state) {
             case ATL_OFI_COMP_POSTED:
                 comp_ofi_req->comp_state = ATL_OFI_COMP_COMPLETED;
-                cache.push(ep.idx, comp_ofi_req->mr);
+                release_mr(ep, comp_ofi_req);
                 break;
             case ATL_OFI_COMP_COMPLETED: break;
             case ATL_OFI_COMP_PEEK_STARTED:
@@ -1049,11 +1097,18 @@ void atl_ofi::process_comps(atl_ep_t& ep, struct fi_cq_tagged_entry* entries, ss
     }
 }
 
-atl_status_t atl_ofi::prov_ep_handle_cq_err(atl_ofi_prov_ep_t* ep) {
+void atl_ofi::release_mr(atl_ep_t& ep, atl_ofi_req_t* ofi_req) {
+    if (ofi_req->mr) {
+        cache.push(ep.idx, ofi_req->mr);
+        ofi_req->mr = nullptr;
+    }
+}
+
+atl_status_t atl_ofi::prov_ep_handle_cq_err(atl_ep_t& ep, atl_ofi_prov_ep_t* prov_ep) {
     struct fi_cq_err_entry err_entry;
     atl_ofi_req_t* ofi_req;
 
-    int ret = fi_cq_readerr(ep->cq, &err_entry, 0);
+    int ret = fi_cq_readerr(prov_ep->cq, &err_entry, 0);
     if (ret != 1) {
         CCL_THROW("unable to read error from cq");
         return ATL_STATUS_FAILURE;
@@ -1061,6 +1116,11 @@ atl_status_t atl_ofi::prov_ep_handle_cq_err(atl_ofi_prov_ep_t* ep) {
     else {
         ofi_req = container_of(err_entry.op_context, atl_ofi_req_t, fi_ctx);
 
+        if (ofi_req->comp_state == ATL_OFI_COMP_POSTED) {
+            /* failed or cancelled request doesn't get a regular completion */
+            release_mr(ep, ofi_req);
+        }
+
         if (err_entry.err == FI_ECANCELED) {
             return ATL_STATUS_SUCCESS;
         }
@@ -1072,7 +1132,8 @@ atl_status_t atl_ofi::prov_ep_handle_cq_err(atl_ofi_prov_ep_t* ep) {
             LOG_ERROR("fi_cq_readerr: err: ",
                       err_entry.err,
                       ", prov_err: ",
-                      fi_cq_strerror(ep->cq, err_entry.prov_errno, err_entry.err_data, nullptr, 0),
+                      fi_cq_strerror(
+                          prov_ep->cq, err_entry.prov_errno, err_entry.err_data, nullptr, 0),
                       "(",
                       err_entry.prov_errno,
                       ")");
@@ -1218,18 +1279,25 @@ void atl_ofi::fi_cache::push(size_t idx, fid_mr* mr) {
 }
 
 atl_ofi::mr_cache::~mr_cache() {
-    if (!cache.empty()) {
-        LOG_WARN("mr cache is not empty, size: ", cache.size());
+    if (!cache.empty() || !retired.empty()) {
+        LOG_WARN("mr cache is not empty, size: ", cache.size(), ", retired: ", retired.size());
         clear();
     }
 }
 
 void atl_ofi::mr_cache::clear() {
-    LOG_DEBUG("mr cache size: ", cache.size());
+    LOG_DEBUG("mr cache size: ", cache.size(), ", bytes: ", cached_bytes);
     for (auto& key_value : cache) {
-        fi_close(&key_value.second->fid);
+        fi_close(&key_value.second.mr->fid);
+    }
+    for (auto mr : retired) {
+        fi_close(&mr->fid);
     }
     cache.clear();
+    lru.clear();
+    in_use.clear();
+    retired.clear();
+    cached_bytes = 0;
 }
 
 void atl_ofi::mr_cache::get(atl_ep_t& ep,
@@ -1240,28 +1308,16 @@ void atl_ofi::mr_cache::get(atl_ep_t& ep,
     CCL_THROW_IF_NOT(prov->domain);
     CCL_THROW_IF_NOT(mr);
 
-    if (ccl::global_data::env().enable_atl_cache) {
-        key_t key(prov->domain, buf, bytes);
-        auto key_value = cache.find(key);
-        if (key_value != cache.end()) {
-            *mr = key_value->second;
-            LOG_DEBUG("loaded from mr cache: buf: ", buf, ", bytes: ", bytes);
-            return;
-        }
-    }
-
     struct fi_mr_attr mr_attr;
-    struct iovec iov;
-
     memset(&mr_attr, 0, sizeof(mr_attr));
-    memset(&iov, 0, sizeof(iov));
 
-    iov.iov_base = buf;
-    iov.iov_len = bytes;
-    mr_attr.mr_iov = &iov;
-    mr_attr.iov_count = 1;
-    mr_attr.access = FI_SEND | FI_RECV | FI_REMOTE_READ | FI_REMOTE_WRITE;
-    mr_attr.requested_key = mr_key++;
+    uintptr_t start = (uintptr_t)buf;
+    uintptr_t end = start + bytes;
+
+    // range to register, the whole allocation for ze memory
+    uintptr_t reg_start = start;
+    uintptr_t reg_end = end;
+    uint64_t alloc_id = 0;
 
 #ifdef CCL_ENABLE_OFI_HMEM
 
@@ -1278,6 +1334,13 @@ void atl_ofi::mr_cache::get(atl_ep_t& ep,
     if (alloc_props.type == ZE_MEMORY_TYPE_HOST || alloc_props.type == ZE_MEMORY_TYPE_DEVICE ||
         alloc_props.type == ZE_MEMORY_TYPE_SHARED) {
         mr_attr.iface = FI_HMEM_ZE;
+
+        void* base_ptr = nullptr;
+        size_t alloc_size = 0;
+        ZE_CALL(zeMemGetAddressRange, (context, buf, &base_ptr, &alloc_size));
+        reg_start = (uintptr_t)base_ptr;
+        reg_end = reg_start + alloc_size;
+        alloc_id = alloc_props.id;
     }
 
     if (alloc_dev) {
@@ -1297,37 +1360,214 @@ void atl_ofi::mr_cache::get(atl_ep_t& ep,
     }
 #endif // CCL_ENABLE_OFI_HMEM
 
-    int ofi_ret;
-    ATL_OFI_CALL(fi_mr_regattr(prov->domain, &mr_attr, 0, mr),
-                 ofi_ret,
-                 CCL_THROW("failed to register mr, ret: ",
-                           ofi_ret,
-                           ", buf: ",
-                           buf,
-                           ", bytes: ",
-                           bytes,
-                           ", iface: ",
-                           mr_attr.iface));
+    int ofi_ret = 0;
+
+    if (!ccl::global_data::env().enable_atl_cache) {
+        ofi_ret = reg_mr(ep, prov, mr_attr, start, end, mr);
+        CCL_THROW_IF_NOT(ofi_ret == 0,
+                         "failed to register mr, ret: ",
+                         ofi_ret,
+                         ", buf: ",
+                         buf,
+                         ", bytes: ",
+                         bytes,
+                         ", iface: ",
+                         mr_attr.iface);
+        return;
+    }
 
-    if (prov->info->domain_attr->mr_mode & FI_MR_ENDPOINT) {
-        fi_mr_bind(*mr, (fid_t)&ep, 0);
-        fi_mr_enable(*mr);
+    auto it = find(prov->domain, start, end);
+    if (it != cache.end()) {
+        if ((start >= it->first.second) && (end <= it->second.end) &&
+            (it->second.alloc_id == alloc_id)) {
+            *mr = it->second.mr;
+            in_use[*mr]++;
+            lru.splice(lru.begin(), lru, it->second.lru_it);
+            LOG_DEBUG("loaded from mr cache: buf: ", buf, ", bytes: ", bytes);
+            return;
+        }
     }
 
-    if (ccl::global_data::env().enable_atl_cache) {
-        key_t key(prov->domain, buf, bytes);
-        LOG_DEBUG("inserted to mr cache: buf: ", buf, ", bytes: ", bytes);
-        cache.insert({ std::move(key), *mr });
+    // system memory ranges which overlap or touch the requested one are merged,
+    // anything else overlapping it belongs to freed memory
+    std::vector<cache_t::iterator> merged, stale;
+    for (it = find(prov->domain, reg_start, reg_end); it != cache.end(); it++) {
+        if ((it->first.first != prov->domain) || (it->first.second > reg_end)) {
+            break;
+        }
+        if (it->second.end < reg_start) {
+            continue;
+        }
+        bool is_overlapped = (it->first.second < reg_end) && (it->second.end > reg_start);
+        if ((alloc_id == 0) && (it->second.alloc_id == 0)) {
+            merged.push_back(it);
+        }
+        else if (is_overlapped) {
+            stale.push_back(it);
+        }
+    }
+
+    uintptr_t merged_start = reg_start;
+    uintptr_t merged_end = reg_end;
+    for (auto& merged_it : merged) {
+        merged_start = std::min(merged_start, merged_it->first.second);
+        merged_end = std::max(merged_end, merged_it->second.end);
     }
+
+    ofi_ret = reg_mr(ep, prov, mr_attr, merged_start, merged_end, mr);
+    if (ofi_ret && (merged_start != reg_start || merged_end != reg_end)) {
+        LOG_DEBUG("failed to register merged range, register requested range only");
+        merged_start = reg_start;
+        merged_end = reg_end;
+        for (auto& merged_it : merged) {
+            if ((merged_it->first.second < reg_end) && (merged_it->second.end > reg_start)) {
+                stale.push_back(merged_it);
+            }
+        }
+        merged.clear();
+        ofi_ret = reg_mr(ep, prov, mr_attr, merged_start, merged_end, mr);
+    }
+    CCL_THROW_IF_NOT(ofi_ret == 0,
+                     "failed to register mr, ret: ",
+                     ofi_ret,
+                     ", buf: ",
+                     buf,
+                     ", bytes: ",
+                     bytes,
+                     ", iface: ",
+                     mr_attr.iface);
+
+    for (auto& merged_it : merged) {
+        retire(merged_it);
+    }
+    for (auto& stale_it : stale) {
+        retire(stale_it);
+    }
+
+    key_t key(prov->domain, merged_start);
+    lru.push_front(key);
+    cache.insert({ key, mr_entry{ merged_end, *mr, alloc_id, lru.begin() } });
+    cached_bytes += merged_end - merged_start;
+    in_use[*mr]++;
+
+    LOG_DEBUG("inserted to mr cache: buf: ",
+              buf,
+              ", bytes: ",
+              bytes,
+              ", registered bytes: ",
+              merged_end - merged_start,
+              ", merged: ",
+              merged.size(),
+              ", invalidated: ",
+              stale.size());
+
+    evict();
 }
 
 void atl_ofi::mr_cache::push(fid_mr* mr) {
     CCL_THROW_IF_NOT(mr);
-    if (ccl::global_data::env().enable_atl_cache) {
-        /* do nothing, all mem regions will be closed in clear() */
+    if (!ccl::global_data::env().enable_atl_cache) {
+        fi_close(&mr->fid);
         return;
     }
-    fi_close(&mr->fid);
+
+    auto it = in_use.find(mr);
+    CCL_THROW_IF_NOT(it != in_use.end(), "unexpected mr ", mr);
+    if (--it->second > 0) {
+        return;
+    }
+    in_use.erase(it);
+
+    if (retired.erase(mr)) {
+        fi_close(&mr->fid);
+    }
+    else {
+        evict();
+    }
+}
+
+int atl_ofi::mr_cache::reg_mr(atl_ep_t& ep,
+                              atl_ofi_prov_t* prov,
+                              struct fi_mr_attr mr_attr,
+                              uintptr_t start,
+                              uintptr_t end,
+                              fid_mr** mr) {
+    struct iovec iov;
+    memset(&iov, 0, sizeof(iov));
+
+    iov.iov_base = (void*)start;
+    iov.iov_len = end - start;
+    mr_attr.mr_iov = &iov;
+    mr_attr.iov_count = 1;
+    mr_attr.access = FI_SEND | FI_RECV | FI_REMOTE_READ | FI_REMOTE_WRITE;
+    mr_attr.requested_key = mr_key++;
+
+    // failure is handled by caller, it can retry with smaller range
+    int ret = fi_mr_regattr(prov->domain, &mr_attr, 0, mr);
+    if (ret) {
+        return ret;
+    }
+
+    if (prov->info->domain_attr->mr_mode & FI_MR_ENDPOINT) {
+        fi_mr_bind(*mr, (fid_t)&ep, 0);
+        fi_mr_enable(*mr);
+    }
+
+    return 0;
+}
+
+// returns first entry of domain which ends after start, or end() if there is none
+atl_ofi::mr_cache::cache_t::iterator atl_ofi::mr_cache::find(fid_domain* domain,
+                                                             uintptr_t start,
+                                                             uintptr_t end) {
+    auto it = cache.upper_bound(key_t(domain, start));
+    if (it != cache.begin()) {
+        auto prev = std::prev(it);
+        if ((prev->first.first == domain) && (prev->second.end >= start)) {
+            return prev;
+        }
+    }
+    if ((it != cache.end()) && (it->first.first == domain) && (it->first.second <= end)) {
+        return it;
+    }
+    return cache.end();
+}
+
+void atl_ofi::mr_cache::retire(cache_t::iterator it) {
+    fid_mr* mr = it->second.mr;
+    cached_bytes -= it->second.end - it->first.second;
+    lru.erase(it->second.lru_it);
+    cache.erase(it);
+
+    if (in_use.count(mr)) {
+        retired.insert(mr);
+    }
+    else {
+        fi_close(&mr->fid);
+    }
+}
+
+bool atl_ofi::mr_cache::is_over_limit() const {
+    size_t max_entries = ccl::global_data::env().atl_cache_max_entries;
+    size_t max_size = ccl::global_data::env().atl_cache_max_size;
+    return (max_entries && (cache.size() > max_entries)) ||
+           (max_size && (cached_bytes > max_size));
+}
+
+void atl_ofi::mr_cache::evict() {
+    // regions used by in-flight requests stay, limits can be exceeded temporarily
+    auto lru_it = lru.end();
+    while (is_over_limit() && (lru_it != lru.begin())) {
+        --lru_it;
+        auto it = cache.find(*lru_it);
+        CCL_THROW_IF_NOT(it != cache.end());
+        if (in_use.count(it->second.mr)) {
+            continue;
+        }
+        ++lru_it;
+        LOG_DEBUG("evict from mr cache: bytes: ", it->second.end - it->first.second);
+        retire(it);
+    }
 }
 
 fi_addr_t atl_ofi::atl_ofi_get_addr(atl_ofi_prov_t* prov, int proc_idx, size_t ep_idx) {
@@ -16,8 +16,11 @@
 #pragma once
 
 #include <iostream>
+#include <list>
+#include <map>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "atl/atl_base_transport.hpp"
 #include "atl/ofi/atl_ofi_helper.hpp"
@@ -175,6 +178,8 @@ public:
 
     atl_status_t poll(atl_ep_t& ep) override;
 
+    atl_status_t poll_wait(atl_ep_t& ep, int timeout_ms) override;
+
     atl_status_t check(atl_ep_t& ep, atl_req_t& req) override;
 
     atl_proc_coord_t create_proc_coord(atl_ep_t& ep) override {
@@ -208,7 +213,36 @@ public:
 private:
     atl_status_t progress_ep(atl_ep_t& ep);
     void process_comps(atl_ep_t& ep, struct fi_cq_tagged_entry* entries, ssize_t ret);
-    atl_status_t prov_ep_handle_cq_err(atl_ofi_prov_ep_t* ep);
+    atl_status_t prov_ep_handle_cq_err(atl_ep_t& ep, atl_ofi_prov_ep_t* prov_ep);
+    /* returns mr of the request to the cache, does nothing if it is already returned */
+    void release_mr(atl_ep_t& ep, atl_ofi_req_t* ofi_req);
+
+    /* releases mr of the request on scope exit unless the request has been posted */
+    class mr_guard {
+    public:
+        mr_guard(atl_ofi* atl, atl_ep_t& ep, atl_ofi_req_t* ofi_req)
+                : atl(atl),
+                  ep(ep),
+                  ofi_req(ofi_req) {}
+        mr_guard(const mr_guard&) = delete;
+        mr_guard& operator=(const mr_guard&) = delete;
+        ~mr_guard() {
+            if (!is_posted) {
+                atl->release_mr(ep, ofi_req);
+            }
+        }
+
+        void set_posted() {
+            is_posted = true;
+        }
+
+    private:
+        atl_ofi* atl;
+        atl_ep_t& ep;
+        atl_ofi_req_t* ofi_req;
+        bool is_posted = false;
+    };
+
     atl_status_t open_providers(char* prov_env,
                                 const atl_proc_coord_t& coord,
                                 atl_attr_t* attr,
@@ -251,11 +285,40 @@ private:
         void push(fid_mr* mr);
 
     private:
-        size_t mr_key = 0;
+        // domain, start address of registered range
+        using key_t = typename std::pair<fid_domain*, uintptr_t>;
+
+        // ranges of one domain never overlap, so ordered map works as interval index
+        struct mr_entry {
+            uintptr_t end;
+            fid_mr* mr;
+            // ze allocation id, 0 for system memory
+            uint64_t alloc_id;
+            std::list<key_t>::iterator lru_it;
+        };
+        using cache_t = std::map<key_t, mr_entry>;
+
+        int reg_mr(atl_ep_t& ep,
+                   atl_ofi_prov_t* prov,
+                   struct fi_mr_attr mr_attr,
+                   uintptr_t start,
+                   uintptr_t end,
+                   fid_mr** mr);
+        cache_t::iterator find(fid_domain* domain, uintptr_t start, uintptr_t end);
+        void retire(cache_t::iterator it);
+        bool is_over_limit() const;
+        void evict();
 
-        using key_t = typename std::tuple<fid_domain*, void*, size_t>;
-        using value_t = fid_mr*;
-        std::unordered_multimap<key_t, value_t, ccl::utils::tuple_hash> cache{};
+        size_t mr_key = 0;
+        size_t cached_bytes = 0;
+
+        cache_t cache{};
+        // most recently used first
+        std::list<key_t> lru{};
+        // regions handed out to requests and not yet returned through push
+        std::unordered_map<fid_mr*, size_t> in_use{};
+        // regions removed from cache while in use, closed on last push
+        std::unordered_set<fid_mr*> retired{};
     };
 
     class fi_cache {
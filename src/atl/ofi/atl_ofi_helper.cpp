@@ -854,8 +854,23 @@ atl_status_t atl_ofi_prov_ep_init(atl_ofi_prov_t* prov, size_t ep_idx) {
     memset(&cq_attr, 0, sizeof(cq_attr));
     cq_attr.format = FI_CQ_FORMAT_TAGGED;
 
-    ATL_OFI_CALL(
-        fi_cq_open(prov->domain, &cq_attr, &ep->cq, nullptr), ret, return ATL_STATUS_FAILURE);
+    ep->cq_wait = false;
+    if (ccl::global_data::env().worker_park) {
+        cq_attr.wait_obj = FI_WAIT_UNSPEC;
+        ret = fi_cq_open(prov->domain, &cq_attr, &ep->cq, nullptr);
+        if (ret == FI_SUCCESS) {
+            ep->cq_wait = true;
+        }
+        else {
+            LOG_DEBUG("unable to open cq with wait object, ret: ", ret, ", fallback to polling");
+            cq_attr.wait_obj = FI_WAIT_NONE;
+        }
+    }
+
+    if (!ep->cq_wait) {
+        ATL_OFI_CALL(
+            fi_cq_open(prov->domain, &cq_attr, &ep->cq, nullptr), ret, return ATL_STATUS_FAILURE);
+    }
 
     if (prov->sep) {
         rx_attr = *prov->info->rx_attr;
@@ -1360,6 +1375,17 @@ int atl_ofi_is_nic_local(struct fi_info* info) {
     return 0;
 }
 
+/* return NUMA node closest to the NIC or -1 if it is unknown */
+int atl_ofi_get_nic_numa_node(const struct fi_info* info) {
+    if (info->nic && info->nic->bus_attr && info->nic->bus_attr->bus_type == FI_BUS_PCI &&
+        ccl::global_data::get().hwloc_wrapper->is_initialized()) {
+        struct fi_pci_attr pci = info->nic->bus_attr->attr.pci;
+        return ccl::global_data::get().hwloc_wrapper->get_numa_node_by_pci(
+            pci.domain_id, pci.bus_id, pci.device_id, pci.function_id);
+    }
+    return CCL_UNDEFINED_NUMA_NODE;
+}
+
 atl_status_t atl_ofi_parse_mnic_name(atl_ofi_ctx_t& ctx, std::string str_to_parse) {
     atl_status_t ret = ATL_STATUS_SUCCESS;
 
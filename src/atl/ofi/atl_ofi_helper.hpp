@@ -168,6 +168,8 @@ typedef struct {
     struct fid_ep* tx;
     struct fid_ep* rx;
     struct fid_cq* cq;
+    /* cq is opened with wait object and supports fi_cq_sread */
+    bool cq_wait;
     atl_ofi_prov_ep_name_t name;
 } atl_ofi_prov_ep_t;
 
@@ -248,6 +250,7 @@ extern atl_ofi_global_data_t global_data;
 
 std::string atl_ofi_get_short_nic_name(const struct fi_info* prov);
 std::string atl_ofi_get_nic_name(const struct fi_info* prov);
+int atl_ofi_get_nic_numa_node(const struct fi_info* info);
 atl_ofi_prov_t* atl_ofi_get_prov(atl_ofi_ctx_t& ctx,
                                  const atl_proc_coord_t& coord,
                                  const atl_ep_t& ep,
@@ -0,0 +1,909 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <algorithm>
+#include <cstdlib>
+#include <errno.h>
+#include <fcntl.h>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "atl/shm/atl_shm.hpp"
+#include "common/global/global.hpp"
+
+// read by peers through process_vm_readv to check that CMA is permitted
+static volatile uint64_t cma_probe_value = 0x636d612d70726f62;
+
+static std::string get_segment_name(pid_t src_pid, pid_t dst_pid) {
+    return std::string(ATL_SHM_SEGMENT_PREFIX) + "_" + std::to_string(src_pid) + "_" +
+           std::to_string(dst_pid);
+}
+
+static atl_shm_req_t* atl_shm_init_req(atl_req_t& req,
+                                       atl_shm_req_type_t type,
+                                       const void* buf,
+                                       size_t len,
+                                       int peer,
+                                       uint64_t tag) {
+    atl_shm_req_t* shm_req = ((atl_shm_req_t*)req.internal);
+    shm_req->type = type;
+    shm_req->completed = 0;
+    shm_req->peer = peer;
+    shm_req->tag = tag;
+    shm_req->buf = (char*)buf;
+    shm_req->len = len;
+    shm_req->offset = 0;
+    shm_req->id = 0;
+    req.is_completed = 0;
+    return shm_req;
+}
+
+atl_shm::~atl_shm() {
+    if (!is_finalized) {
+        finalize();
+    }
+}
+
+atl_status_t atl_shm::init(int* argc,
+                           char*** argv,
+                           atl_attr_t* attr,
+                           const char* main_addr,
+                           std::shared_ptr<ipmi> pmi) {
+    CCL_THROW_IF_NOT(!inited, "atl_shm reinit is not expected");
+    inited = true;
+
+    CCL_THROW_IF_NOT((sizeof(atl_shm_req_t) <= sizeof(atl_req_t) - offsetof(atl_req_t, internal)),
+                     "unexpected offset: atl_shm_request size ",
+                     sizeof(atl_shm_req_t),
+                     ", atl_request size ",
+                     sizeof(atl_req_t),
+                     ", expected offset ",
+                     offsetof(atl_req_t, internal));
+
+    if (!pmi) {
+        LOG_ERROR("pmi is null");
+        return ATL_STATUS_FAILURE;
+    }
+
+    ep_count = attr->in.ep_count;
+
+    char* cma_threshold_env = getenv(ATL_SHM_CMA_THRESHOLD_ENV);
+    if (cma_threshold_env) {
+        cma_threshold = std::strtoull(cma_threshold_env, nullptr, 10);
+    }
+    /* zero threshold disables single-copy path */
+    enable_cma = (cma_threshold != 0);
+
+#ifdef PR_SET_PTRACER
+    /*
+       opt-in only: allows any process of the user to ptrace this one,
+       without it CMA is used only when yama ptrace_scope permits it
+    */
+    char* ptrace_any_env = getenv(ATL_SHM_PTRACE_ANY_ENV);
+    if (enable_cma && ptrace_any_env && std::atoi(ptrace_any_env)) {
+        prctl(PR_SET_PTRACER, PR_SET_PTRACER_ANY, 0, 0, 0);
+    }
+#endif // PR_SET_PTRACER
+
+    char hostname[ATL_MAX_HOSTNAME_LEN] = { 0 };
+    gethostname(hostname, ATL_MAX_HOSTNAME_LEN - 1);
+
+    coord.global_count = pmi->get_size();
+    coord.global_idx = pmi->get_rank();
+    coord.local_count = coord.global_count;
+    coord.local_idx = coord.global_idx;
+    coord.hostname_hash = std::hash<std::string>{}(hostname);
+    coord.global2local_map.resize(coord.global_count);
+    for (int i = 0; i < coord.global_count; i++) {
+        coord.global2local_map[i] = i;
+    }
+
+    LOG_INFO(::to_string(coord));
+    coord.validate();
+
+    for (size_t ep_idx = 0; ep_idx < ep_count; ep_idx++) {
+        ep_ctxs.emplace_back(new atl_shm_ep_ctx_t());
+        ep_ctxs.back()->next_rts_id = 0;
+
+        atl_ep_t ep;
+        ep.idx = ep_idx;
+        eps.push_back(ep);
+    }
+
+    std::vector<int> rank2proc_map;
+    ATL_CHECK_STATUS(connect_procs(pmi, rank2proc_map), "failed to connect local processes");
+
+    attr->out.enable_shm = 1;
+    attr->out.enable_rma = 0;
+    attr->out.enable_hmem = 0;
+    attr->out.mnic_type = ATL_MNIC_NONE;
+    attr->out.mnic_count = 1;
+    attr->out.tag_bits = 64;
+    attr->out.max_tag = 0xFFFFFFFFFFFFFFFF;
+    attr->out.max_order_waw_size = 0;
+
+    return ATL_STATUS_SUCCESS;
+}
+
+atl_status_t atl_shm::update(std::shared_ptr<ipmi> pmi) {
+    LOG_ERROR("update is not supported for atl-shm");
+    return ATL_STATUS_UNSUPPORTED;
+}
+
+atl_status_t atl_shm::send(atl_ep_t& ep,
+                           const void* buf,
+                           size_t len,
+                           int dst_proc_idx,
+                           uint64_t tag,
+                           atl_req_t& req) {
+    atl_shm_ep_ctx_t& ep_ctx = *ep_ctxs[ep.idx];
+    atl_shm_req_t* shm_req = atl_shm_init_req(req, ATL_SHM_REQ_SEND, buf, len, dst_proc_idx, tag);
+
+    std::lock_guard<ccl_spinlock> lock{ ep_ctx.lock };
+
+    CCL_THROW_IF_NOT(dst_proc_idx >= 0 && dst_proc_idx < (int)ep_ctx.peers.size(),
+                     "unexpected dst_proc_idx ",
+                     dst_proc_idx);
+    atl_shm_peer_t& peer = ep_ctx.peers[dst_proc_idx];
+
+    atl_shm_send_op_t op{};
+    op.hdr.tag = tag;
+    op.hdr.total_len = len;
+    op.req = shm_req;
+
+    if (enable_cma && peer.use_cma && len >= cma_threshold) {
+        shm_req->id = ep_ctx.next_rts_id++;
+        op.hdr.type = ATL_SHM_CELL_RTS;
+        op.hdr.addr = (uint64_t)buf;
+        op.hdr.req_id = shm_req->id;
+        ep_ctx.rts_sends[shm_req->id] = shm_req;
+    }
+    else {
+        op.hdr.type = ATL_SHM_CELL_EAGER;
+    }
+
+    peer.send_queue.push_back(op);
+    progress_sends(peer);
+
+    return ATL_STATUS_SUCCESS;
+}
+
+atl_status_t atl_shm::recv(atl_ep_t& ep,
+                           void* buf,
+                           size_t len,
+                           int src_proc_idx,
+                           uint64_t tag,
+                           atl_req_t& req) {
+    atl_shm_ep_ctx_t& ep_ctx = *ep_ctxs[ep.idx];
+    atl_shm_req_t* shm_req = atl_shm_init_req(req, ATL_SHM_REQ_RECV, buf, len, src_proc_idx, tag);
+
+    std::lock_guard<ccl_spinlock> lock{ ep_ctx.lock };
+
+    CCL_THROW_IF_NOT(src_proc_idx >= 0 && src_proc_idx < (int)ep_ctx.peers.size(),
+                     "unexpected src_proc_idx ",
+                     src_proc_idx);
+
+    auto it = std::find_if(
+        ep_ctx.unexp_msgs.begin(), ep_ctx.unexp_msgs.end(), [&](const atl_shm_unexp_msg_t& msg) {
+            return (msg.peer == src_proc_idx) && (msg.tag == tag) && !msg.req;
+        });
+
+    if (it == ep_ctx.unexp_msgs.end()) {
+        ep_ctx.posted_recvs.push_back(shm_req);
+        return ATL_STATUS_SUCCESS;
+    }
+
+    CCL_THROW_IF_NOT(it->len <= len,
+                     "message is truncated, recv len ",
+                     len,
+                     ", message len ",
+                     it->len,
+                     ", tag ",
+                     tag);
+
+    if (it->is_rts) {
+        atl_shm_cell_hdr_t hdr{};
+        hdr.total_len = it->len;
+        hdr.addr = it->addr;
+        hdr.req_id = it->req_id;
+        ep_ctx.unexp_msgs.erase(it);
+        handle_rts(ep_ctx, src_proc_idx, hdr, shm_req);
+    }
+    else if (it->is_complete) {
+        if (it->len) {
+            memcpy(buf, it->data.data(), it->len);
+        }
+        ep_ctx.unexp_msgs.erase(it);
+        shm_req->completed = 1;
+    }
+    else {
+        /* payload is still arriving, it will be copied on the last cell */
+        it->req = shm_req;
+    }
+
+    return ATL_STATUS_SUCCESS;
+}
+
+atl_status_t atl_shm::probe(atl_ep_t& ep,
+                            int src_proc_idx,
+                            uint64_t tag,
+                            int* found,
+                            size_t* recv_len) {
+    ATL_CHECK_STATUS(progress_ep(ep), "progress failed");
+
+    atl_shm_ep_ctx_t& ep_ctx = *ep_ctxs[ep.idx];
+    std::lock_guard<ccl_spinlock> lock{ ep_ctx.lock };
+
+    *found = 0;
+    for (auto& msg : ep_ctx.unexp_msgs) {
+        if ((msg.peer == src_proc_idx) && (msg.tag == tag) && !msg.req) {
+            *found = 1;
+            if (recv_len) {
+                *recv_len = msg.len;
+            }
+            break;
+        }
+    }
+
+    return ATL_STATUS_SUCCESS;
+}
+
+atl_status_t atl_shm::wait(atl_ep_t& ep, atl_req_t& req) {
+    atl_status_t ret = ATL_STATUS_SUCCESS;
+    atl_shm_req_t* shm_req = ((atl_shm_req_t*)req.internal);
+
+    while (!shm_req->completed && ((ret = progress_ep(ep)) == ATL_STATUS_SUCCESS)) {
+    }
+
+    req.is_completed = 1;
+
+    return ret;
+}
+
+atl_status_t atl_shm::wait_all(atl_ep_t& ep, std::vector<atl_req_t>& reqs, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        atl_status_t ret = wait(ep, reqs[i]);
+        if (ret != ATL_STATUS_SUCCESS)
+            return ret;
+    }
+
+    return ATL_STATUS_SUCCESS;
+}
+
+atl_status_t atl_shm::cancel(atl_ep_t& ep, atl_req_t& req) {
+    atl_shm_ep_ctx_t& ep_ctx = *ep_ctxs[ep.idx];
+    atl_shm_req_t* shm_req = ((atl_shm_req_t*)req.internal);
+
+    std::lock_guard<ccl_spinlock> lock{ ep_ctx.lock };
+
+    if (shm_req->completed) {
+        return ATL_STATUS_SUCCESS;
+    }
+
+    if (shm_req->type == ATL_SHM_REQ_RECV) {
+        ep_ctx.posted_recvs.remove(shm_req);
+        for (auto& msg : ep_ctx.unexp_msgs) {
+            if (msg.req == shm_req) {
+                msg.req = nullptr;
+            }
+        }
+        for (auto& peer : ep_ctx.peers) {
+            if (peer.rx_active && !peer.rx_is_unexp && (peer.rx_req == shm_req)) {
+                /* drop remaining cells of this message */
+                peer.rx_req = nullptr;
+                peer.rx_buf = nullptr;
+            }
+            for (auto it = peer.nacked_recvs.begin(); it != peer.nacked_recvs.end(); ++it) {
+                if (it->second == shm_req) {
+                    /* RESEND cells of this message will be dropped */
+                    peer.nacked_recvs.erase(it);
+                    break;
+                }
+            }
+        }
+    }
+    else {
+        ep_ctx.rts_sends.erase(shm_req->id);
+        auto& queue = ep_ctx.peers[shm_req->peer].send_queue;
+        auto it = std::find_if(queue.begin(), queue.end(), [&](const atl_shm_send_op_t& op) {
+            return (op.req == shm_req);
+        });
+        if (it != queue.end()) {
+            if (shm_req->offset == 0) {
+                queue.erase(it);
+            }
+            else {
+                /*
+                   partially sent eager message has to be finished to keep ring consistent,
+                   the rest is copied as the request and its buffer are released on completion
+                */
+                it->data.assign(shm_req->buf + shm_req->offset, shm_req->buf + shm_req->len);
+                it->offset = 0;
+                it->req = nullptr;
+            }
+        }
+    }
+
+    shm_req->completed = 1;
+
+    return ATL_STATUS_SUCCESS;
+}
+
+atl_status_t atl_shm::poll(atl_ep_t& ep) {
+    return progress_ep(ep);
+}
+
+atl_status_t atl_shm::poll_wait(atl_ep_t& ep, int timeout_ms) {
+    /* rings are polled, peers do not signal new cells */
+    return ATL_STATUS_UNSUPPORTED;
+}
+
+atl_status_t atl_shm::check(atl_ep_t& ep, atl_req_t& req) {
+    atl_status_t status = ATL_STATUS_SUCCESS;
+    atl_shm_req_t* shm_req = ((atl_shm_req_t*)req.internal);
+
+    CCL_THROW_IF_NOT(!req.is_completed, "request is already completed");
+
+    req.is_completed = shm_req->completed;
+    if (req.is_completed) {
+        return ATL_STATUS_SUCCESS;
+    }
+
+    status = progress_ep(ep);
+    req.is_completed = shm_req->completed;
+
+    return status;
+}
+
+atl_status_t atl_shm::get_rank2proc_map(std::shared_ptr<ipmi> pmi,
+                                        std::vector<int>& rank2proc_map,
+                                        atl_proc_coord_t coord) {
+    CCL_THROW_IF_NOT(rank2proc_map.empty());
+
+    if (!need_extra_exchange) {
+        /* processes were connected in init in pmi rank order */
+        rank2proc_map.resize(pmi->get_size());
+        for (size_t i = 0; i < rank2proc_map.size(); i++) {
+            rank2proc_map[i] = i;
+        }
+        need_extra_exchange = true;
+        return ATL_STATUS_SUCCESS;
+    }
+
+    return connect_procs(pmi, rank2proc_map);
+}
+
+std::string atl_shm::to_string() {
+    std::stringstream ss;
+    ss << "atl-shm:\n{\n"
+       << "  ep_count: " << ep_count << "\n"
+       << "  cell_size: " << ATL_SHM_CELL_SIZE << "\n"
+       << "  cell_count: " << ATL_SHM_CELL_COUNT << "\n"
+       << "  cma: " << enable_cma << "\n"
+       << "  cma_threshold: " << cma_threshold << "\n"
+       << "}";
+    return ss.str();
+}
+
+atl_status_t atl_shm::finalize(int global_idx) {
+    CCL_THROW_IF_NOT(!is_finalized, "atl_shm refinalize is not expected");
+    is_finalized = true;
+    inited = false;
+
+    if (coord.global_idx == 0) {
+        LOG_INFO("finalizing atl-shm");
+    }
+
+    size_t seg_size = ep_count * sizeof(atl_shm_ring_t);
+    for (auto& proc : procs) {
+        if (proc.in_seg) {
+            munmap(proc.in_seg, seg_size);
+        }
+        if (proc.out_seg) {
+            munmap(proc.out_seg, seg_size);
+        }
+    }
+    procs.clear();
+    ep_ctxs.clear();
+    eps.clear();
+
+    if (coord.global_idx == 0) {
+        LOG_INFO("finalized atl-shm");
+    }
+
+    return ATL_STATUS_SUCCESS;
+}
+
+atl_status_t atl_shm::connect_procs(std::shared_ptr<ipmi> pmi, std::vector<int>& rank2proc_map) {
+    std::lock_guard<std::mutex> lock{ procs_guard };
+
+    int pmi_rank = pmi->get_rank();
+    int pmi_size = pmi->get_size();
+    pid_t my_pid = getpid();
+
+    atl_shm_proc_info_t my_info{};
+    my_info.pid = my_pid;
+    my_info.hostname_hash = coord.hostname_hash;
+    my_info.probe_addr = (uint64_t)&cma_probe_value;
+
+    ATL_CHECK_STATUS(
+        pmi->pmrt_kvs_put((char*)ATL_SHM_PROC_INFO_PM_KEY, pmi_rank, &my_info, sizeof(my_info)),
+        "failed to put proc info");
+    ATL_CHECK_STATUS(pmi->pmrt_barrier(), "barrier failed");
+
+    std::vector<atl_shm_proc_info_t> infos(pmi_size);
+    for (int rank = 0; rank < pmi_size; rank++) {
+        ATL_CHECK_STATUS(pmi->pmrt_kvs_get((char*)ATL_SHM_PROC_INFO_PM_KEY,
+                                           rank,
+                                           &infos[rank],
+                                           sizeof(atl_shm_proc_info_t)),
+                         "failed to get proc info");
+        if (infos[rank].hostname_hash != coord.hostname_hash) {
+            LOG_ERROR("atl-shm supports single node only, rank ", rank, " is on another node");
+            return ATL_STATUS_FAILURE;
+        }
+    }
+
+    /* proc_idx is stable across communicators, only unknown processes are connected */
+    std::vector<size_t> new_procs;
+    std::vector<int> new_proc_ranks;
+    rank2proc_map.resize(pmi_size);
+    for (int rank = 0; rank < pmi_size; rank++) {
+        auto it = std::find_if(procs.begin(), procs.end(), [&](const atl_shm_proc_t& proc) {
+            return (proc.pid == (pid_t)infos[rank].pid);
+        });
+        if (it == procs.end()) {
+            atl_shm_proc_t proc{};
+            proc.pid = infos[rank].pid;
+            proc.probe_addr = infos[rank].probe_addr;
+            procs.push_back(proc);
+            new_procs.push_back(procs.size() - 1);
+            new_proc_ranks.push_back(rank);
+            rank2proc_map[rank] = procs.size() - 1;
+        }
+        else {
+            rank2proc_map[rank] = it - procs.begin();
+        }
+    }
+
+    for (auto proc_idx : new_procs) {
+        procs[proc_idx].in_seg = create_segment(procs[proc_idx].pid, my_pid);
+        if (!procs[proc_idx].in_seg) {
+            return ATL_STATUS_FAILURE;
+        }
+    }
+    ATL_CHECK_STATUS(pmi->pmrt_barrier(), "barrier failed");
+
+    for (auto proc_idx : new_procs) {
+        procs[proc_idx].out_seg = open_segment(my_pid, procs[proc_idx].pid);
+        if (!procs[proc_idx].out_seg) {
+            return ATL_STATUS_FAILURE;
+        }
+    }
+    ATL_CHECK_STATUS(pmi->pmrt_barrier(), "barrier failed");
+
+    /* both sides are mapped, names are not needed anymore */
+    for (auto proc_idx : new_procs) {
+        shm_unlink(get_segment_name(procs[proc_idx].pid, my_pid).c_str());
+    }
+
+    /* each process reports whether it can read memory of all new peers */
+    int cma_ok = enable_cma;
+    for (auto proc_idx : new_procs) {
+        if (cma_ok && !check_cma(procs[proc_idx])) {
+            LOG_DEBUG("CMA is not available for pid ", procs[proc_idx].pid);
+            cma_ok = 0;
+        }
+    }
+
+    ATL_CHECK_STATUS(
+        pmi->pmrt_kvs_put((char*)ATL_SHM_CMA_PM_KEY, pmi_rank, &cma_ok, sizeof(cma_ok)),
+        "failed to put cma flag");
+    ATL_CHECK_STATUS(pmi->pmrt_barrier(), "barrier failed");
+
+    for (size_t idx = 0; idx < new_procs.size(); idx++) {
+        int peer_cma_ok = 0;
+        ATL_CHECK_STATUS(pmi->pmrt_kvs_get((char*)ATL_SHM_CMA_PM_KEY,
+                                           new_proc_ranks[idx],
+                                           &peer_cma_ok,
+                                           sizeof(peer_cma_ok)),
+                         "failed to get cma flag");
+        procs[new_procs[idx]].cma_readable = peer_cma_ok;
+    }
+
+    for (size_t ep_idx = 0; ep_idx < ep_ctxs.size(); ep_idx++) {
+        atl_shm_ep_ctx_t& ep_ctx = *ep_ctxs[ep_idx];
+        std::lock_guard<ccl_spinlock> ep_lock{ ep_ctx.lock };
+        ep_ctx.peers.resize(procs.size());
+        for (auto proc_idx : new_procs) {
+            atl_shm_peer_t& peer = ep_ctx.peers[proc_idx];
+            peer.in = (atl_shm_ring_t*)procs[proc_idx].in_seg + ep_idx;
+            peer.out = (atl_shm_ring_t*)procs[proc_idx].out_seg + ep_idx;
+            peer.pid = procs[proc_idx].pid;
+            peer.use_cma = procs[proc_idx].cma_readable;
+            peer.rx_active = false;
+            peer.rx_is_unexp = false;
+            peer.rx_buf = nullptr;
+            peer.rx_len = 0;
+            peer.rx_offset = 0;
+            peer.rx_req = nullptr;
+        }
+    }
+
+    LOG_DEBUG("connected ",
+              new_procs.size(),
+              " new processes, rank2proc_map: ",
+              ccl::utils::vec_to_string(rank2proc_map));
+
+    return ATL_STATUS_SUCCESS;
+}
+
+void* atl_shm::create_segment(pid_t src_pid, pid_t dst_pid) {
+    std::string name = get_segment_name(src_pid, dst_pid);
+    size_t seg_size = ep_count * sizeof(atl_shm_ring_t);
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if ((fd < 0) && (errno == EEXIST)) {
+        /* leftover from a previous process with the same pid */
+        shm_unlink(name.c_str());
+        fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    }
+    if (fd < 0) {
+        LOG_ERROR("shm_open failed for ", name, ": ", strerror(errno));
+        return nullptr;
+    }
+
+    if (ftruncate(fd, seg_size) != 0) {
+        LOG_ERROR("ftruncate failed for ", name, ": ", strerror(errno));
+        close(fd);
+        shm_unlink(name.c_str());
+        return nullptr;
+    }
+
+    void* seg = mmap(nullptr, seg_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (seg == MAP_FAILED) {
+        LOG_ERROR("mmap failed for ", name, ": ", strerror(errno));
+        shm_unlink(name.c_str());
+        return nullptr;
+    }
+
+    for (size_t ep_idx = 0; ep_idx < ep_count; ep_idx++) {
+        atl_shm_ring_t* ring = (atl_shm_ring_t*)seg + ep_idx;
+        ring->head.store(0, std::memory_order_relaxed);
+        ring->tail.store(0, std::memory_order_relaxed);
+    }
+
+    return seg;
+}
+
+void* atl_shm::open_segment(pid_t src_pid, pid_t dst_pid) {
+    std::string name = get_segment_name(src_pid, dst_pid);
+    size_t seg_size = ep_count * sizeof(atl_shm_ring_t);
+
+    int fd = shm_open(name.c_str(), O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        LOG_ERROR("shm_open failed for ", name, ": ", strerror(errno));
+        return nullptr;
+    }
+
+    void* seg = mmap(nullptr, seg_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (seg == MAP_FAILED) {
+        LOG_ERROR("mmap failed for ", name, ": ", strerror(errno));
+        return nullptr;
+    }
+
+    return seg;
+}
+
+bool atl_shm::check_cma(const atl_shm_proc_t& proc) {
+    uint64_t value = 0;
+    struct iovec local_iov = { &value, sizeof(value) };
+    struct iovec remote_iov = { (void*)proc.probe_addr, sizeof(value) };
+    ssize_t ret = process_vm_readv(proc.pid, &local_iov, 1, &remote_iov, 1, 0);
+    return (ret == (ssize_t)sizeof(value)) && (value == cma_probe_value);
+}
+
+atl_status_t atl_shm::progress_ep(atl_ep_t& ep) {
+    atl_shm_ep_ctx_t& ep_ctx = *ep_ctxs[ep.idx];
+    std::lock_guard<ccl_spinlock> lock{ ep_ctx.lock };
+
+    for (size_t peer_idx = 0; peer_idx < ep_ctx.peers.size(); peer_idx++) {
+        progress_recvs(ep_ctx, peer_idx);
+        progress_sends(ep_ctx.peers[peer_idx]);
+    }
+
+    return ATL_STATUS_SUCCESS;
+}
+
+void atl_shm::progress_sends(atl_shm_peer_t& peer) {
+    atl_shm_ring_t* ring = peer.out;
+    uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+    uint64_t head = ring->head.load(std::memory_order_acquire);
+
+    while (!peer.send_queue.empty()) {
+        if (tail - head == ATL_SHM_CELL_COUNT) {
+            head = ring->head.load(std::memory_order_acquire);
+            if (tail - head == ATL_SHM_CELL_COUNT) {
+                break;
+            }
+        }
+
+        atl_shm_send_op_t& op = peer.send_queue.front();
+        atl_shm_cell_t& cell = ring->cells[tail % ATL_SHM_CELL_COUNT];
+        cell.hdr = op.hdr;
+
+        bool is_op_done = true;
+        if ((op.hdr.type == ATL_SHM_CELL_EAGER) || (op.hdr.type == ATL_SHM_CELL_RESEND)) {
+            atl_shm_req_t* req = op.req;
+            const char* buf = (req) ? req->buf : op.data.data();
+            size_t len = (req) ? req->len : op.data.size();
+            size_t& offset = (req) ? req->offset : op.offset;
+            size_t chunk = std::min(len - offset, (size_t)ATL_SHM_CELL_PAYLOAD);
+            if (chunk) {
+                memcpy(cell.data, buf + offset, chunk);
+            }
+            cell.hdr.len = chunk;
+            offset += chunk;
+            is_op_done = (offset == len);
+            if (is_op_done && req) {
+                req->completed = 1;
+            }
+        }
+
+        tail++;
+        ring->tail.store(tail, std::memory_order_release);
+
+        if (is_op_done) {
+            peer.send_queue.pop_front();
+        }
+    }
+}
+
+void atl_shm::progress_recvs(atl_shm_ep_ctx_t& ep_ctx, int peer_idx) {
+    atl_shm_ring_t* ring = ep_ctx.peers[peer_idx].in;
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    uint64_t tail = ring->tail.load(std::memory_order_acquire);
+
+    while (head != tail) {
+        const atl_shm_cell_t& cell = ring->cells[head % ATL_SHM_CELL_COUNT];
+
+        switch (cell.hdr.type) {
+            case ATL_SHM_CELL_EAGER:
+            case ATL_SHM_CELL_RESEND: handle_eager_cell(ep_ctx, peer_idx, cell); break;
+            case ATL_SHM_CELL_RTS: {
+                atl_shm_req_t* req = match_posted_recv(ep_ctx, peer_idx, cell.hdr.tag);
+                if (req) {
+                    handle_rts(ep_ctx, peer_idx, cell.hdr, req);
+                }
+                else {
+                    ep_ctx.unexp_msgs.emplace_back();
+                    atl_shm_unexp_msg_t& msg = ep_ctx.unexp_msgs.back();
+                    msg.peer = peer_idx;
+                    msg.tag = cell.hdr.tag;
+                    msg.len = cell.hdr.total_len;
+                    msg.is_rts = true;
+                    msg.addr = cell.hdr.addr;
+                    msg.req_id = cell.hdr.req_id;
+                    msg.is_complete = true;
+                    msg.req = nullptr;
+                }
+                break;
+            }
+            case ATL_SHM_CELL_FIN: {
+                auto it = ep_ctx.rts_sends.find(cell.hdr.req_id);
+                if (it != ep_ctx.rts_sends.end()) {
+                    it->second->completed = 1;
+                    ep_ctx.rts_sends.erase(it);
+                }
+                break;
+            }
+            case ATL_SHM_CELL_NACK: handle_nack(ep_ctx, peer_idx, cell.hdr); break;
+            default: CCL_THROW("unexpected cell type ", cell.hdr.type);
+        }
+
+        head++;
+        ring->head.store(head, std::memory_order_release);
+    }
+}
+
+void atl_shm::handle_eager_cell(atl_shm_ep_ctx_t& ep_ctx,
+                                int peer_idx,
+                                const atl_shm_cell_t& cell) {
+    atl_shm_peer_t& peer = ep_ctx.peers[peer_idx];
+
+    if (!peer.rx_active) {
+        /* first cell of a message */
+        peer.rx_active = true;
+        peer.rx_len = cell.hdr.total_len;
+        peer.rx_offset = 0;
+
+        if (cell.hdr.type == ATL_SHM_CELL_RESEND) {
+            /* payload of nacked RTS, the receive may have been cancelled meanwhile */
+            auto it = peer.nacked_recvs.find(cell.hdr.req_id);
+            if (it != peer.nacked_recvs.end()) {
+                peer.rx_req = it->second;
+                peer.nacked_recvs.erase(it);
+            }
+            else {
+                peer.rx_req = nullptr;
+            }
+            peer.rx_is_unexp = false;
+            peer.rx_buf = (peer.rx_req) ? peer.rx_req->buf : nullptr;
+        }
+        else if ((peer.rx_req = match_posted_recv(ep_ctx, peer_idx, cell.hdr.tag))) {
+            CCL_THROW_IF_NOT(peer.rx_len <= peer.rx_req->len,
+                             "message is truncated, recv len ",
+                             peer.rx_req->len,
+                             ", message len ",
+                             peer.rx_len,
+                             ", tag ",
+                             cell.hdr.tag);
+            peer.rx_is_unexp = false;
+            peer.rx_buf = peer.rx_req->buf;
+        }
+        else {
+            ep_ctx.unexp_msgs.emplace_back();
+            atl_shm_unexp_msg_t& msg = ep_ctx.unexp_msgs.back();
+            msg.peer = peer_idx;
+            msg.tag = cell.hdr.tag;
+            msg.len = peer.rx_len;
+            msg.is_rts = false;
+            msg.addr = 0;
+            msg.req_id = 0;
+            msg.is_complete = false;
+            msg.req = nullptr;
+            msg.data.resize(peer.rx_len);
+            peer.rx_is_unexp = true;
+            peer.rx_unexp = std::prev(ep_ctx.unexp_msgs.end());
+            peer.rx_buf = msg.data.data();
+        }
+    }
+
+    if (cell.hdr.len && peer.rx_buf) {
+        memcpy(peer.rx_buf + peer.rx_offset, cell.data, cell.hdr.len);
+    }
+    peer.rx_offset += cell.hdr.len;
+
+    if (peer.rx_offset < peer.rx_len) {
+        return;
+    }
+
+    peer.rx_active = false;
+    peer.rx_buf = nullptr;
+
+    if (!peer.rx_is_unexp) {
+        if (peer.rx_req) {
+            peer.rx_req->completed = 1;
+        }
+        peer.rx_req = nullptr;
+        return;
+    }
+
+    atl_shm_unexp_msg_t& msg = *peer.rx_unexp;
+    if (msg.req) {
+        if (msg.len) {
+            memcpy(msg.req->buf, msg.data.data(), msg.len);
+        }
+        msg.req->completed = 1;
+        ep_ctx.unexp_msgs.erase(peer.rx_unexp);
+    }
+    else {
+        msg.is_complete = true;
+    }
+    peer.rx_is_unexp = false;
+}
+
+void atl_shm::handle_rts(atl_shm_ep_ctx_t& ep_ctx,
+                         int peer_idx,
+                         const atl_shm_cell_hdr_t& hdr,
+                         atl_shm_req_t* req) {
+    atl_shm_peer_t& peer = ep_ctx.peers[peer_idx];
+
+    CCL_THROW_IF_NOT(hdr.total_len <= req->len,
+                     "message is truncated, recv len ",
+                     req->len,
+                     ", message len ",
+                     hdr.total_len);
+
+    atl_shm_send_op_t reply{};
+    reply.hdr.req_id = hdr.req_id;
+    reply.req = nullptr;
+
+    if (cma_read(peer, req->buf, hdr.addr, hdr.total_len)) {
+        req->completed = 1;
+        reply.hdr.type = ATL_SHM_CELL_FIN;
+    }
+    else {
+        /* not permitted to read, ask sender to push the payload through the ring */
+        peer.nacked_recvs[hdr.req_id] = req;
+        reply.hdr.type = ATL_SHM_CELL_NACK;
+    }
+
+    peer.send_queue.push_back(reply);
+    progress_sends(peer);
+}
+
+void atl_shm::handle_nack(atl_shm_ep_ctx_t& ep_ctx,
+                          int peer_idx,
+                          const atl_shm_cell_hdr_t& hdr) {
+    atl_shm_peer_t& peer = ep_ctx.peers[peer_idx];
+
+    /* peer is not able to read our memory, next messages go through the ring only */
+    if (peer.use_cma) {
+        LOG_DEBUG("CMA read is not permitted for peer ", peer_idx, ", fallback to copy");
+        peer.use_cma = false;
+    }
+
+    atl_shm_send_op_t op{};
+    op.hdr.type = ATL_SHM_CELL_RESEND;
+    op.hdr.req_id = hdr.req_id;
+    op.req = nullptr;
+
+    auto it = ep_ctx.rts_sends.find(hdr.req_id);
+    if (it != ep_ctx.rts_sends.end()) {
+        op.req = it->second;
+        op.hdr.tag = op.req->tag;
+        op.hdr.total_len = op.req->len;
+        ep_ctx.rts_sends.erase(it);
+    }
+    /* send was cancelled, empty RESEND completes the receive */
+
+    peer.send_queue.push_back(op);
+}
+
+atl_shm_req_t* atl_shm::match_posted_recv(atl_shm_ep_ctx_t& ep_ctx, int peer_idx, uint64_t tag) {
+    auto it = std::find_if(
+        ep_ctx.posted_recvs.begin(), ep_ctx.posted_recvs.end(), [&](const atl_shm_req_t* req) {
+            return (req->peer == peer_idx) && (req->tag == tag);
+        });
+
+    if (it == ep_ctx.posted_recvs.end()) {
+        return nullptr;
+    }
+
+    atl_shm_req_t* req = *it;
+    ep_ctx.posted_recvs.erase(it);
+    return req;
+}
+
+bool atl_shm::cma_read(const atl_shm_peer_t& peer, void* buf, uint64_t addr, size_t len) {
+    size_t done = 0;
+    while (done < len) {
+        struct iovec local_iov = { (char*)buf + done, len - done };
+        struct iovec remote_iov = { (void*)(addr + done), len - done };
+        ssize_t ret = process_vm_readv(peer.pid, &local_iov, 1, &remote_iov, 1, 0);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret < 0 && errno == EPERM) {
+            return false;
+        }
+        CCL_THROW_IF_NOT(ret > 0,
+                         "process_vm_readv failed, pid ",
+                         peer.pid,
+                         ", len ",
+                         len - done,
+                         ", error: ",
+                         strerror(errno));
+        done += ret;
+    }
+    return true;
+}
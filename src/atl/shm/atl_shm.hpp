@@ -0,0 +1,381 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+     http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <sys/types.h>
+#include <unordered_map>
+#include <vector>
+
+#include "atl/atl_base_transport.hpp"
+#include "atl/util/pm/pm_rt.h"
+#include "common/utils/spinlock.hpp"
+
+#define ATL_SHM_CELL_SIZE         8192
+#define ATL_SHM_CELL_COUNT        32
+#define ATL_SHM_CMA_THRESHOLD     32768
+#define ATL_SHM_CMA_THRESHOLD_ENV "ATL_SHM_CMA_THRESHOLD"
+#define ATL_SHM_PTRACE_ANY_ENV    "ATL_SHM_PTRACE_ANY"
+#define ATL_SHM_SEGMENT_PREFIX    "/ccl_atl_shm"
+#define ATL_SHM_PROC_INFO_PM_KEY  "atl-shm-proc-info"
+#define ATL_SHM_CMA_PM_KEY        "atl-shm-cma"
+
+/*
+ * Intra-node transport:
+ * every ordered pair of processes owns a POSIX shared memory segment
+ * with one single-producer/single-consumer ring of fixed-size cells per endpoint.
+ * Small messages are copied through the ring (eager protocol).
+ * Large messages are announced by a single RTS cell and pulled by the receiver
+ * directly from the sender address space with process_vm_readv (CMA),
+ * the receiver acknowledges completion with a FIN cell.
+ * If the read is not permitted the receiver answers with a NACK cell
+ * and the sender pushes the payload through the ring in RESEND cells.
+ */
+
+typedef enum {
+    ATL_SHM_CELL_EAGER,
+    ATL_SHM_CELL_RTS,
+    ATL_SHM_CELL_FIN,
+    ATL_SHM_CELL_NACK,
+    ATL_SHM_CELL_RESEND
+} atl_shm_cell_type_t;
+
+typedef struct {
+    uint64_t tag;
+    uint64_t total_len; /* full message length */
+    uint64_t len; /* payload bytes carried by this cell */
+    uint64_t addr; /* sender buffer for RTS */
+    uint64_t req_id; /* sender request id for RTS, FIN, NACK and RESEND */
+    uint32_t type;
+    uint32_t reserved;
+} atl_shm_cell_hdr_t;
+
+#define ATL_SHM_CELL_PAYLOAD (ATL_SHM_CELL_SIZE - sizeof(atl_shm_cell_hdr_t))
+
+typedef struct {
+    atl_shm_cell_hdr_t hdr;
+    char data[ATL_SHM_CELL_PAYLOAD];
+} atl_shm_cell_t;
+
+typedef struct {
+    /* advanced by consumer */
+    alignas(ATL_CACHELINE_LEN) std::atomic<uint64_t> head;
+    /* advanced by producer */
+    alignas(ATL_CACHELINE_LEN) std::atomic<uint64_t> tail;
+    alignas(ATL_CACHELINE_LEN) atl_shm_cell_t cells[ATL_SHM_CELL_COUNT];
+} atl_shm_ring_t;
+
+typedef enum { ATL_SHM_REQ_SEND, ATL_SHM_REQ_RECV } atl_shm_req_type_t;
+
+/* stored in atl_req_t::internal */
+typedef struct {
+    atl_shm_req_type_t type;
+    int completed;
+    int peer;
+    uint64_t tag;
+    char* buf;
+    size_t len;
+    size_t offset; /* eager bytes already pushed into ring */
+    uint64_t id; /* RTS id, matched by FIN */
+} atl_shm_req_t;
+
+typedef struct atl_shm_unexp_msg {
+    int peer;
+    uint64_t tag;
+    size_t len;
+    bool is_rts;
+    uint64_t addr;
+    uint64_t req_id;
+    bool is_complete;
+    /* recv posted while eager payload was still in flight */
+    atl_shm_req_t* req;
+    std::vector<char> data;
+} atl_shm_unexp_msg_t;
+
+typedef struct {
+    atl_shm_cell_hdr_t hdr;
+    /* nullptr for control messages and for eager messages cancelled in the middle */
+    atl_shm_req_t* req;
+    /* rest of the payload of a cancelled eager message, sent to keep ring consistent */
+    std::vector<char> data;
+    size_t offset;
+} atl_shm_send_op_t;
+
+typedef struct atl_shm_peer {
+    atl_shm_ring_t* in;
+    atl_shm_ring_t* out;
+    pid_t pid;
+    bool use_cma;
+    std::deque<atl_shm_send_op_t> send_queue;
+
+    /* eager message which is currently received from this peer */
+    bool rx_active;
+    bool rx_is_unexp;
+    char* rx_buf;
+    size_t rx_len;
+    size_t rx_offset;
+    atl_shm_req_t* rx_req;
+    std::list<atl_shm_unexp_msg_t>::iterator rx_unexp;
+
+    /* RTS receives which wait for RESEND cells, by sender request id */
+    std::unordered_map<uint64_t, atl_shm_req_t*> nacked_recvs;
+} atl_shm_peer_t;
+
+typedef struct atl_shm_ep_ctx {
+    ccl_spinlock lock;
+    std::vector<atl_shm_peer_t> peers;
+    std::list<atl_shm_req_t*> posted_recvs;
+    std::list<atl_shm_unexp_msg_t> unexp_msgs;
+    std::unordered_map<uint64_t, atl_shm_req_t*> rts_sends;
+    uint64_t next_rts_id;
+} atl_shm_ep_ctx_t;
+
+typedef struct {
+    pid_t pid;
+    uint64_t probe_addr;
+    /* whether peer is able to read our memory through CMA */
+    bool cma_readable;
+    void* in_seg;
+    void* out_seg;
+} atl_shm_proc_t;
+
+typedef struct {
+    int64_t pid;
+    uint64_t hostname_hash;
+    uint64_t probe_addr;
+} atl_shm_proc_info_t;
+
+class atl_shm : public atl_base_transport {
+public:
+    atl_shm() = default;
+    atl_shm(const atl_shm& other) = delete;
+    atl_shm& operator=(const atl_shm& other) = delete;
+    ~atl_shm();
+
+    atl_status_t init(int* argc,
+                      char*** argv,
+                      atl_attr_t* attr,
+                      const char* main_addr,
+                      std::shared_ptr<ipmi> pmi) override;
+
+    atl_status_t update(std::shared_ptr<ipmi> pmi) override;
+
+    atl_status_t mr_reg(const void* buf, size_t len, atl_mr_t** mr) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t mr_dereg(atl_mr_t* mr) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t send(atl_ep_t& ep,
+                      const void* buf,
+                      size_t len,
+                      int dst_proc_idx,
+                      uint64_t tag,
+                      atl_req_t& req) override;
+
+    atl_status_t recv(atl_ep_t& ep,
+                      void* buf,
+                      size_t len,
+                      int src_proc_idx,
+                      uint64_t tag,
+                      atl_req_t& req) override;
+
+    atl_status_t probe(atl_ep_t& ep,
+                       int src_proc_idx,
+                       uint64_t tag,
+                       int* found,
+                       size_t* recv_len) override;
+
+    atl_status_t allgather(atl_ep_t& ep,
+                           const void* send_buf,
+                           void* recv_buf,
+                           size_t len,
+                           atl_req_t& req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t allgatherv(atl_ep_t& ep,
+                            const void* send_buf,
+                            size_t send_len,
+                            void* recv_buf,
+                            const size_t* recv_lens,
+                            const size_t* offsets,
+                            atl_req_t& req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t allreduce(atl_ep_t& ep,
+                           const void* send_buf,
+                           void* recv_buf,
+                           size_t len,
+                           atl_datatype_t dtype,
+                           atl_reduction_t op,
+                           atl_req_t& req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t alltoall(atl_ep_t& ep,
+                          const void* send_buf,
+                          void* recv_buf,
+                          int len,
+                          atl_req_t& req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t alltoallv(atl_ep_t& ep,
+                           const void* send_buf,
+                           const size_t* send_lens,
+                           const size_t* send_offsets,
+                           void* recv_buf,
+                           const size_t* recv_lens,
+                           const size_t* recv_offsets,
+                           atl_req_t& req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t barrier(atl_ep_t& ep, atl_req_t& req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t bcast(atl_ep_t& ep, void* buf, size_t len, int root, atl_req_t& req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t broadcast(atl_ep_t& ep,
+                           void* send_buf,
+                           void* recv_buf,
+                           size_t len,
+                           int root,
+                           atl_req_t& req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t reduce(atl_ep_t& ep,
+                        const void* send_buf,
+                        void* recv_buf,
+                        size_t len,
+                        int root,
+                        atl_datatype_t dtype,
+                        atl_reduction_t op,
+                        atl_req_t& req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t reduce_scatter(atl_ep_t& ep,
+                                const void* send_buf,
+                                void* recv_buf,
+                                size_t recv_len,
+                                atl_datatype_t dtype,
+                                atl_reduction_t op,
+                                atl_req_t& req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t read(atl_ep_t& ep,
+                      void* buf,
+                      size_t len,
+                      atl_mr_t* mr,
+                      uint64_t addr,
+                      uintptr_t remote_key,
+                      int dst_proc_idx,
+                      atl_req_t& req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t write(atl_ep_t& ep,
+                       const void* buf,
+                       size_t len,
+                       atl_mr_t* mr,
+                       uint64_t addr,
+                       uintptr_t remote_key,
+                       int dst_proc_idx,
+                       atl_req_t& req) override {
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t wait(atl_ep_t& ep, atl_req_t& req) override;
+
+    atl_status_t wait_all(atl_ep_t& ep, std::vector<atl_req_t>& reqs, size_t count) override;
+
+    atl_status_t cancel(atl_ep_t& ep, atl_req_t& req) override;
+
+    atl_status_t poll(atl_ep_t& ep) override;
+
+    atl_status_t poll_wait(atl_ep_t& ep, int timeout_ms) override;
+
+    atl_status_t check(atl_ep_t& ep, atl_req_t& req) override;
+
+    atl_proc_coord_t create_proc_coord(atl_ep_t& ep) override {
+        return coord;
+    }
+
+    void comms_free(std::vector<atl_ep_t>& eps) override {
+        throw ccl::exception(std::string(__PRETTY_FUNCTION__) + " - is not implemented");
+    }
+
+    atl_status_t comm_split(const std::vector<atl_ep_t>& base_eps,
+                            std::vector<atl_ep_t>& eps,
+                            size_t color,
+                            int key,
+                            int local_idx,
+                            int local_count) override {
+        throw ccl::exception(std::string(__PRETTY_FUNCTION__) + " - is not implemented");
+        return ATL_STATUS_UNSUPPORTED;
+    }
+
+    atl_status_t get_rank2proc_map(std::shared_ptr<ipmi> pmi,
+                                   std::vector<int>& rank2proc_map,
+                                   atl_proc_coord_t coord) override;
+
+    std::string to_string() override;
+
+    atl_status_t finalize(int global_idx = 0) override;
+
+    static void set_env(const atl_attr_t& attr) {}
+
+private:
+    atl_status_t connect_procs(std::shared_ptr<ipmi> pmi, std::vector<int>& rank2proc_map);
+    void* create_segment(pid_t src_pid, pid_t dst_pid);
+    void* open_segment(pid_t src_pid, pid_t dst_pid);
+    bool check_cma(const atl_shm_proc_t& proc);
+
+    atl_status_t progress_ep(atl_ep_t& ep);
+    void progress_sends(atl_shm_peer_t& peer);
+    void progress_recvs(atl_shm_ep_ctx_t& ep_ctx, int peer_idx);
+    void handle_eager_cell(atl_shm_ep_ctx_t& ep_ctx, int peer_idx, const atl_shm_cell_t& cell);
+    void handle_rts(atl_shm_ep_ctx_t& ep_ctx,
+                    int peer_idx,
+                    const atl_shm_cell_hdr_t& hdr,
+                    atl_shm_req_t* req);
+    void handle_nack(atl_shm_ep_ctx_t& ep_ctx, int peer_idx, const atl_shm_cell_hdr_t& hdr);
+    atl_shm_req_t* match_posted_recv(atl_shm_ep_ctx_t& ep_ctx, int peer_idx, uint64_t tag);
+    bool cma_read(const atl_shm_peer_t& peer, void* buf, uint64_t addr, size_t len);
+
+    size_t ep_count{ 0 };
+    size_t cma_threshold{ ATL_SHM_CMA_THRESHOLD };
+    bool enable_cma{ false };
+    bool need_extra_exchange{ false };
+
+    std::mutex procs_guard;
+    std::vector<atl_shm_proc_t> procs;
+    std::vector<std::unique_ptr<atl_shm_ep_ctx_t>> ep_ctxs;
+};
@@ -24,7 +24,10 @@
 #endif //#if defined(CCL_ENABLE_ZE) || defined(CCL_ENABLE_SYCL)
 
 #include "ccl_api_functions_generators.hpp"
+#include "coll/selection/selection.hpp"
+#include "coll/selection/tuning.hpp"
 #include "common/global/global.hpp"
+#include "sched/cache/cache.hpp"
 #include "common/api_wrapper/mpi_api_wrapper.hpp"
 // WA for broadcast to avoid scheduler completely
 #include "coll/algorithms/broadcast/mpi_bcast_invoke.hpp"
@@ -142,6 +145,49 @@ void group_end() {
     group_impl::end();
 }
 
+/******************** STATS ********************/
+
+static ccl_coll_stats* get_coll_stats(const communicator& comm) {
+#ifdef CCL_ENABLE_STUB_BACKEND
+    /* stub comm doesn't run collectives */
+    if (ccl::global_data::env().backend == backend_mode::stub) {
+        return nullptr;
+    }
+#endif // CCL_ENABLE_STUB_BACKEND
+    impl_dispatch disp;
+    ccl_comm* comm_impl = (ccl_comm*)(disp(comm).get());
+    CCL_THROW_IF_NOT(comm_impl, "invalid communicator");
+    return &comm_impl->get_coll_stats();
+}
+
+vector_class<coll_stats> get_stats(const communicator& comm) {
+    ccl_coll_stats* stats = get_coll_stats(comm);
+    return stats ? stats->get() : vector_class<coll_stats>{};
+}
+
+void reset_stats(const communicator& comm) {
+    ccl_coll_stats* stats = get_coll_stats(comm);
+    if (stats) {
+        stats->reset();
+    }
+}
+
+/******************** TUNING ********************/
+
+void set_tuning(const string_class& tuning) {
+    auto& data = ccl::global_data::get();
+    data.tuning->set(tuning);
+
+    /* selection tables are built once, rebuild them with the new tuning */
+    data.algorithm_selector.reset(new ccl_algorithm_selector_wrapper<CCL_COLL_LIST>());
+    data.algorithm_selector->init();
+
+    /* cached scheds keep the algorithms and chunk counts they were built with */
+    if (!data.sched_cache->try_flush()) {
+        LOG_WARN("can't flush sched cache, cached collectives keep the previous tuning");
+    }
+}
+
 /******************** OPERATION ********************/
 
 #define CHECK_DEPS(deps) \
@@ -70,7 +70,8 @@ enum ccl_coll_alltoall_algo {
     ccl_coll_alltoall_direct,
     ccl_coll_alltoall_naive,
     ccl_coll_alltoall_scatter,
-    ccl_coll_alltoall_topo
+    ccl_coll_alltoall_topo,
+    ccl_coll_alltoall_bruck
 };
 
 enum ccl_coll_alltoallv_algo {
@@ -79,9 +80,21 @@ enum ccl_coll_alltoallv_algo {
     ccl_coll_alltoallv_direct,
     ccl_coll_alltoallv_naive,
     ccl_coll_alltoallv_scatter,
-    ccl_coll_alltoallv_topo
+    ccl_coll_alltoallv_topo,
+    ccl_coll_alltoallv_hier
 };
 
+/* alltoall and alltoallv share ccl_coll_algo and are compared through either member */
+static_assert(static_cast<int>(ccl_coll_alltoall_direct) ==
+                      static_cast<int>(ccl_coll_alltoallv_direct) &&
+                  static_cast<int>(ccl_coll_alltoall_naive) ==
+                      static_cast<int>(ccl_coll_alltoallv_naive) &&
+                  static_cast<int>(ccl_coll_alltoall_scatter) ==
+                      static_cast<int>(ccl_coll_alltoallv_scatter) &&
+                  static_cast<int>(ccl_coll_alltoall_topo) ==
+                      static_cast<int>(ccl_coll_alltoallv_topo),
+              "common alltoall and alltoallv algorithms must have the same values");
+
 enum ccl_coll_barrier_algo {
     ccl_coll_barrier_undefined = 0,
 
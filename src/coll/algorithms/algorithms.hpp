@@ -90,13 +90,15 @@ ccl::status ccl_coll_build_rabenseifner_allreduce(ccl_sched* sched,
                                                   const ccl_datatype& dtype,
                                                   ccl::reduction reduction,
                                                   ccl_comm* comm);
+/* avg_divisor: divisor of avg, 0 - size of comm */
 ccl::status ccl_coll_build_nreduce_allreduce(ccl_sched* sched,
                                              ccl_buffer send_buf,
                                              ccl_buffer recv_buf,
                                              size_t count,
                                              const ccl_datatype& dtype,
                                              ccl::reduction reduction,
-                                             ccl_comm* comm);
+                                             ccl_comm* comm,
+                                             size_t avg_divisor = 0);
 ccl::status ccl_coll_build_ring_allreduce(ccl_sched* sched,
                                           ccl_buffer send_buf,
                                           ccl_buffer recv_buf,
@@ -143,6 +145,12 @@ ccl::status ccl_coll_build_direct_alltoall(ccl_sched* sched,
                                            size_t count,
                                            const ccl_datatype& dtype,
                                            ccl_comm* comm);
+ccl::status ccl_coll_build_bruck_alltoall(ccl_sched* sched,
+                                          ccl_buffer send_buf,
+                                          ccl_buffer recv_buf,
+                                          size_t count,
+                                          const ccl_datatype& dtype,
+                                          ccl_comm* comm);
 
 ccl::status ccl_coll_build_direct_alltoallv(ccl_sched* sched,
                                             ccl_buffer send_buf,
@@ -157,6 +165,9 @@ ccl::status ccl_coll_build_naive_alltoallv(ccl_sched* main_sched,
 ccl::status ccl_coll_build_scatter_alltoallv(ccl_sched* main_sched,
                                              std::vector<ccl_sched*>& scheds,
                                              const ccl_coll_param& coll_param);
+ccl::status ccl_coll_build_hier_alltoallv(ccl_sched* main_sched,
+                                          std::vector<ccl_sched*>& scheds,
+                                          const ccl_coll_param& coll_param);
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
 ccl::status ccl_coll_build_topo_alltoallv(ccl_sched* main_sched,
                                           std::vector<ccl_sched*>& scheds,
@@ -311,13 +322,22 @@ ccl::status ccl_coll_build_naive_reduce_scatter(ccl_sched* sched,
                                                 const ccl_datatype& dtype,
                                                 ccl::reduction reduction,
                                                 ccl_comm* comm);
+/* entries of ring reduce_scatter block, the caller may depend on them instead of a barrier */
+struct ccl_reduce_scatter_block_deps {
+    sched_entry* last_send = nullptr;
+    sched_entry* last_recv = nullptr;
+    /* entries which read or write each block of recv_buf */
+    std::vector<std::vector<sched_entry*>> block_entries;
+};
+/* without deps the block ends with a barrier */
 ccl::status ccl_coll_build_reduce_scatter_block(ccl_sched* sched,
                                                 ccl_buffer send_buf,
                                                 ccl_buffer recv_buf,
                                                 size_t send_count,
                                                 const ccl_datatype& dtype,
                                                 ccl::reduction reduction,
-                                                ccl_comm* comm);
+                                                ccl_comm* comm,
+                                                ccl_reduce_scatter_block_deps* deps = nullptr);
 ccl::status ccl_coll_build_ring_reduce_scatter(ccl_sched* sched,
                                                ccl_buffer send_buf,
                                                ccl_buffer recv_buf,
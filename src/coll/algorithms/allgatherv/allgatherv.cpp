@@ -362,6 +362,39 @@ ccl::status ccl_coll_build_flat_allgatherv(ccl_sched* main_sched,
                      ", expected ",
                      comm_size);
 
+    size_t lazy_threshold = ccl::global_data::env().lazy_entries_threshold;
+    if (!main_sched && lazy_threshold && static_cast<size_t>(comm_size) >= lazy_threshold) {
+        /* send/recv entries are generated on the fly, their number doesn't depend on comm size */
+        std::vector<size_t> recv_counts(comm_size);
+        for (int idx = 0; idx < comm_size; idx++) {
+            recv_counts[idx] = coll_param.get_recv_count(idx);
+        }
+
+        entry_factory::create<generator_entry>(
+            scheds[0],
+            comm_size,
+            ccl::global_data::env().lazy_entries_window,
+            [=](generator_entry* gen, size_t step_idx) {
+                /* rotated schedule: send to rank + step, recv from rank - step, avoids incast */
+                if (step_idx == 0)
+                    return;
+
+                int recv_peer = static_cast<int>((comm_rank + comm_size - step_idx) % comm_size);
+                int send_peer = static_cast<int>((comm_rank + step_idx) % comm_size);
+
+                if (recv_counts[recv_peer]) {
+                    gen->emit<recv_entry>(
+                        recv_bufs[recv_peer], recv_counts[recv_peer], dtype, recv_peer, comm);
+                }
+
+                if (recv_counts[comm_rank]) {
+                    gen->emit<send_entry>(send_seg, recv_counts[comm_rank], dtype, send_peer, comm);
+                }
+            });
+
+        return ccl::status::success;
+    }
+
     size_t total_ranks = (main_sched) ? sched_count : comm_size;
     for (size_t idx = 0; idx < total_ranks; idx++) {
         if (static_cast<int>(idx) == comm_rank)
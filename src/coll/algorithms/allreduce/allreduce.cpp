@@ -23,6 +23,7 @@
 #include "coll/algorithms/algorithms.hpp"
 #include "coll/algorithms/algorithm_utils.hpp"
 #include "coll/coll_util.hpp"
+#include "coll/selection/tuning.hpp"
 #include "comm/comm.hpp"
 #include "sched/entry/copy/copy_helper.hpp"
 #include "sched/entry/factory/chunked_entry_factory.hpp"
@@ -181,6 +182,11 @@ ccl::status ccl_coll_build_rabenseifner_allreduce(ccl_sched* sched,
 
             CCL_ASSERT(can_use_recv_reduce);
 
+            /* the last reduce-scatter step produces the final result for avg */
+            size_t avg_divisor = (op == ccl::reduction::avg && mask * 2 == pof2)
+                                     ? static_cast<size_t>(comm_size)
+                                     : 1;
+
             if (can_use_recv_reduce) {
                 entry_factory::create<recv_reduce_entry>(sched,
                                                          (recv_buf + disps[recv_idx] * dtype_size),
@@ -188,7 +194,10 @@ ccl::status ccl_coll_build_rabenseifner_allreduce(ccl_sched* sched,
                                                          dtype,
                                                          op,
                                                          dst,
-                                                         comm);
+                                                         comm,
+                                                         ccl_buffer(),
+                                                         ccl_recv_reduce_local_buf,
+                                                         avg_divisor);
                 entry_factory::create<send_entry>(
                     sched, (recv_buf + disps[send_idx] * dtype_size), send_cnt, dtype, dst, comm);
                 sched->add_barrier();
@@ -214,7 +223,8 @@ ccl::status ccl_coll_build_rabenseifner_allreduce(ccl_sched* sched,
                                                           (recv_buf + disps[recv_idx] * dtype_size),
                                                           nullptr,
                                                           dtype,
-                                                          op);
+                                                          op,
+                                                          avg_divisor);
                 sched->add_barrier();
             }
 
@@ -295,7 +305,8 @@ ccl::status ccl_coll_build_nreduce_allreduce(ccl_sched* sched,
                                              size_t count,
                                              const ccl_datatype& dtype,
                                              ccl::reduction op,
-                                             ccl_comm* comm) {
+                                             ccl_comm* comm,
+                                             size_t avg_divisor) {
     LOG_DEBUG("build nreduce allreduce");
 
     ccl::status status = ccl::status::success;
@@ -381,6 +392,17 @@ ccl::status ccl_coll_build_nreduce_allreduce(ccl_sched* sched,
 
             // recv part of buffer from other rank and perform reduce
             int src = (comm_rank + idx) % comm_size;
+            if (op == ccl::reduction::avg && idx == comm_size - 1) {
+                // recv_reduce entries complete in any order,
+                // so the last part is reduced and averaged after the barrier
+                entry_factory::create<recv_entry>(sched,
+                                                  seg_tmp_buf + elem_count * src * dtype_size,
+                                                  elem_count,
+                                                  dtype,
+                                                  src,
+                                                  comm);
+                continue;
+            }
             entry_factory::create<recv_reduce_entry>(sched,
                                                      reduce_buf,
                                                      elem_count,
@@ -393,6 +415,19 @@ ccl::status ccl_coll_build_nreduce_allreduce(ccl_sched* sched,
 
         sched->add_barrier();
 
+        if (op == ccl::reduction::avg) {
+            int src = (comm_rank + comm_size - 1) % comm_size;
+            entry_factory::create<reduce_local_entry>(sched,
+                                                      seg_tmp_buf + elem_count * src * dtype_size,
+                                                      elem_count,
+                                                      reduce_buf,
+                                                      nullptr,
+                                                      dtype,
+                                                      op,
+                                                      avg_divisor ? avg_divisor : comm_size);
+            sched->add_barrier();
+        }
+
         // allgatherv
         if (use_buffering) {
             copy_attr attr;
@@ -439,6 +474,77 @@ ccl::status ccl_coll_build_nreduce_allreduce(ccl_sched* sched,
     return status;
 }
 
+/* allgatherv phase of ring allreduce linked to reduce_scatter by entry dependencies:
+   a block is sent as soon as it is reduced or received and a block is received into
+   once reduce_scatter doesn't access it anymore, sends and recvs keep their posting order */
+static void ccl_allreduce_ring_add_allgatherv(ccl_sched* sched,
+                                              ccl_buffer recv_buf,
+                                              size_t main_block_count,
+                                              const std::vector<size_t>& recv_counts,
+                                              const ccl_reduce_scatter_block_deps& rs_deps,
+                                              const ccl_datatype& dtype,
+                                              ccl_comm* comm) {
+    int comm_size = comm->size();
+    int rank = comm->rank();
+    int src = (comm_size + rank - 1) % comm_size;
+    int dst = (comm_size + rank + 1) % comm_size;
+
+    sched_entry* prev_send = rs_deps.last_send;
+    sched_entry* prev_recv = rs_deps.last_recv;
+    /* recv entries which deliver the blocks */
+    std::vector<sched_entry*> block_recvs(comm_size, nullptr);
+
+    auto add_dependencies = [](sched_entry* entry, const std::vector<sched_entry*>& deps) {
+        for (auto dep : deps) {
+            entry->add_dependency(dep);
+        }
+    };
+
+    int block_idx = rank;
+    for (int idx = 0; idx < (comm_size - 1); idx++) {
+        int send_block_idx = block_idx;
+        int recv_block_idx = (comm_size + block_idx - 1) % comm_size;
+
+        if (recv_counts[send_block_idx]) {
+            auto send = entry_factory::create<send_entry>(
+                sched,
+                recv_buf + send_block_idx * main_block_count * dtype.size(),
+                recv_counts[send_block_idx],
+                dtype,
+                dst,
+                comm);
+            if (prev_send) {
+                send->add_dependency(prev_send);
+            }
+            if (idx == 0) {
+                add_dependencies(send, rs_deps.block_entries[send_block_idx]);
+            }
+            else if (block_recvs[send_block_idx]) {
+                send->add_dependency(block_recvs[send_block_idx]);
+            }
+            prev_send = send;
+        }
+
+        if (recv_counts[recv_block_idx]) {
+            auto recv = entry_factory::create<recv_entry>(
+                sched,
+                recv_buf + recv_block_idx * main_block_count * dtype.size(),
+                recv_counts[recv_block_idx],
+                dtype,
+                src,
+                comm);
+            if (prev_recv) {
+                recv->add_dependency(prev_recv);
+            }
+            add_dependencies(recv, rs_deps.block_entries[recv_block_idx]);
+            block_recvs[recv_block_idx] = recv;
+            prev_recv = recv;
+        }
+
+        block_idx = recv_block_idx;
+    }
+}
+
 ccl::status ccl_coll_build_ring_allreduce(ccl_sched* sched,
                                           ccl_buffer send_buf,
                                           ccl_buffer recv_buf,
@@ -466,9 +572,17 @@ ccl::status ccl_coll_build_ring_allreduce(ccl_sched* sched,
                      recv_buf);
 
     ccl::status status = ccl::status::success;
-    ccl_coll_build_reduce_scatter_block(sched, send_buf, recv_buf, count, dtype, op, comm);
 
-    sched->add_barrier();
+    // host buffers: allgatherv entries depend on reduce_scatter entries of the same block
+    // instead of a barrier between the phases, device copies below still need the barrier
+    bool use_deps = recv_device_bufs.empty();
+    ccl_reduce_scatter_block_deps rs_deps;
+    ccl_coll_build_reduce_scatter_block(
+        sched, send_buf, recv_buf, count, dtype, op, comm, use_deps ? &rs_deps : nullptr);
+
+    if (!use_deps) {
+        sched->add_barrier();
+    }
 
     // Prepare recv_counts for allgatherv phase
     int comm_size = comm->size();
@@ -521,16 +635,22 @@ ccl::status ccl_coll_build_ring_allreduce(ccl_sched* sched,
     }
 #endif // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
 
-    std::vector<ccl_sched*> part_scheds = { sched };
-    ccl_coll_build_ring_allgatherv(nullptr,
-                                   part_scheds,
-                                   recv_buf + comm->rank() * main_block_count * dtype.size(),
-                                   recv_counts[comm->rank()],
-                                   recv_buf,
-                                   recv_counts.data(),
-                                   recv_device_allgatherv_bufs,
-                                   dtype,
-                                   comm);
+    if (use_deps) {
+        ccl_allreduce_ring_add_allgatherv(
+            sched, recv_buf, main_block_count, recv_counts, rs_deps, dtype, comm);
+    }
+    else {
+        std::vector<ccl_sched*> part_scheds = { sched };
+        ccl_coll_build_ring_allgatherv(nullptr,
+                                       part_scheds,
+                                       recv_buf + comm->rank() * main_block_count * dtype.size(),
+                                       recv_counts[comm->rank()],
+                                       recv_buf,
+                                       recv_counts.data(),
+                                       recv_device_allgatherv_bufs,
+                                       dtype,
+                                       comm);
+    }
 
     sched->add_barrier();
 
@@ -629,8 +749,11 @@ ccl::status ccl_coll_build_recursive_doubling_allreduce(ccl_sched* sched,
 
             /* tmp_buf contains data received in this step.
              * recv_buf contains data accumulated so far */
+            size_t avg_divisor = (op == ccl::reduction::avg && mask * 2 == pof2)
+                                     ? static_cast<size_t>(comm_size)
+                                     : 1;
             entry_factory::create<reduce_local_entry>(
-                sched, tmp_buf, count, recv_buf, nullptr, dtype, op);
+                sched, tmp_buf, count, recv_buf, nullptr, dtype, op, avg_divisor);
             sched->add_barrier();
 
             mask <<= 1;
@@ -678,8 +801,9 @@ static void ccl_allreduce_2d_add_allreduce_allgather(ccl_sched* sched,
     if (ar_count) {
         // TODO: add second level selection to distinguish high and low level algorithms
         ccl_buffer ar_buf = rbuf + first_dim_comm->rank() * main_block_count * dtype_size;
+        // avg is divided once by the size of the whole comm, see reduce_scatter phase
         ccl_coll_build_nreduce_allreduce(
-            sched, ar_buf, ar_buf, ar_count, dtype, op, second_dim_comm);
+            sched, ar_buf, ar_buf, ar_count, dtype, op, second_dim_comm, comm->size());
         sched->add_barrier();
     }
 
@@ -719,7 +843,19 @@ static void ccl_allreduce_2d_add_reduce_scatter_allreduce_allgather(ccl_sched* s
     ccl_buffer sbuf = send_buf + chunk_idx * main_chunk_size * dtype_size;
     ccl_buffer rbuf = recv_buf + chunk_idx * main_chunk_size * dtype_size;
 
-    ccl_coll_build_reduce_scatter(sched, sbuf, rbuf, cnt, dtype, op, first_dim_comm, false, true);
+    /*
+       avg is reduced as sum in the 1st dim and is divided in the 2nd dim allreduce,
+       so integer results are truncated only once, the 1st dim averages if it is the only one
+    */
+    ccl::reduction rs_op =
+        (op == ccl::reduction::avg && second_dim_comm->size() > 1) ? ccl::reduction::sum : op;
+
+    // hint of the allreduce itself is not applicable to the nested reduce_scatter
+    ccl_coll_algo hint_algo = sched->hint_algo;
+    sched->hint_algo = {};
+    ccl_coll_build_reduce_scatter(
+        sched, sbuf, rbuf, cnt, dtype, rs_op, first_dim_comm, false, true);
+    sched->hint_algo = hint_algo;
     sched->add_barrier();
 
     if (chunk_idx == (chunk_count - 1) || (chunk_count == 1)) {
@@ -808,7 +944,12 @@ ccl::status ccl_coll_build_2d_allreduce(ccl_sched* sched,
         return status;
     }
 
-    size_t chunk_count = ccl::global_data::env().allreduce_2d_chunk_count;
+    size_t chunk_count =
+        ccl::global_data::get().tuning->get_param(ccl_tuning_param::allreduce_2d_chunk_count,
+                                                  ccl_coll_allreduce,
+                                                  comm->size(),
+                                                  count * dtype.size(),
+                                                  ccl::global_data::env().allreduce_2d_chunk_count);
 
     bool switch_dims = ccl::global_data::env().allreduce_2d_switch_dims;
     ccl_comm* first_dim_comm =
@@ -13,6 +13,8 @@
  See the License for the specific language governing permissions and
  limitations under the License.
 */
+#include <algorithm>
+
 #include "coll/algorithms/algorithms.hpp"
 #include "sched/entry/factory/entry_factory.hpp"
 
@@ -27,3 +29,116 @@ ccl::status ccl_coll_build_direct_alltoall(ccl_sched* sched,
     entry_factory::create<alltoall_entry>(sched, send_buf, recv_buf, count, dtype, comm);
     return ccl::status::success;
 }
+
+/* copies blocks [first, first + k), [first + 2k, first + 3k), ... of tmp_buf
+   to/from the contiguous pack_buf, returns the number of copied blocks */
+static size_t ccl_bruck_alltoall_pack(ccl_sched* sched,
+                                      ccl_buffer tmp_buf,
+                                      ccl_buffer pack_buf,
+                                      int comm_size,
+                                      int k,
+                                      size_t count,
+                                      const ccl_datatype& dtype,
+                                      bool unpack) {
+    size_t block_bytes = count * dtype.size();
+    size_t pack_blocks = 0;
+
+    for (int idx = k; idx < comm_size; idx += 2 * k) {
+        size_t run_blocks = std::min(k, comm_size - idx);
+        ccl_buffer tmp_run = tmp_buf + idx * block_bytes;
+        ccl_buffer pack_run = pack_buf + pack_blocks * block_bytes;
+        entry_factory::create<copy_entry>(sched,
+                                          unpack ? pack_run : tmp_run,
+                                          unpack ? tmp_run : pack_run,
+                                          run_blocks * count,
+                                          dtype);
+        pack_blocks += run_blocks;
+    }
+
+    return pack_blocks;
+}
+
+/*
+ * Bruck alltoall: ceil(log2(comm_size)) steps instead of comm_size - 1 sends,
+ * each step forwards about half of the blocks, so it is used for small blocks only
+ *
+ * 1. local rotation: tmp_buf[i] = send_buf[(rank + i) % comm_size]
+ * 2. on step k (k = 1, 2, 4, ...) blocks with bit k set in their index are sent
+ *    to rank + k and the same block positions are received from rank - k
+ * 3. inverse rotation: recv_buf[(rank - i) % comm_size] = tmp_buf[i]
+ */
+ccl::status ccl_coll_build_bruck_alltoall(ccl_sched* sched,
+                                          ccl_buffer send_buf,
+                                          ccl_buffer recv_buf,
+                                          size_t count,
+                                          const ccl_datatype& dtype,
+                                          ccl_comm* comm) {
+    LOG_DEBUG("build bruck alltoall");
+
+    ccl::status status = ccl::status::success;
+
+    if (count == 0) {
+        return status;
+    }
+
+    int comm_size = comm->size();
+    int rank = comm->rank();
+    size_t block_bytes = count * dtype.size();
+
+    if (comm_size == 1) {
+        if (send_buf != recv_buf) {
+            entry_factory::create<copy_entry>(sched, send_buf, recv_buf, count, dtype);
+        }
+        return status;
+    }
+
+    ccl_buffer tmp_buf = sched->alloc_buffer({ comm_size * block_bytes, send_buf });
+
+    /* the largest number of blocks forwarded on a single step */
+    size_t max_pack_blocks = 0;
+    for (int k = 1; k < comm_size; k <<= 1) {
+        size_t pack_blocks = 0;
+        for (int idx = k; idx < comm_size; idx += 2 * k) {
+            pack_blocks += std::min(k, comm_size - idx);
+        }
+        max_pack_blocks = std::max(max_pack_blocks, pack_blocks);
+    }
+
+    ccl_buffer send_pack_buf = sched->alloc_buffer({ max_pack_blocks * block_bytes, send_buf });
+    ccl_buffer recv_pack_buf = sched->alloc_buffer({ max_pack_blocks * block_bytes, send_buf });
+
+    entry_factory::create<copy_entry>(
+        sched, send_buf + rank * block_bytes, tmp_buf, (comm_size - rank) * count, dtype);
+    if (rank > 0) {
+        entry_factory::create<copy_entry>(
+            sched, send_buf, tmp_buf + (comm_size - rank) * block_bytes, rank * count, dtype);
+    }
+    sched->add_barrier();
+
+    for (int k = 1; k < comm_size; k <<= 1) {
+        int dst = (rank + k) % comm_size;
+        int src = (rank - k + comm_size) % comm_size;
+
+        size_t pack_blocks = ccl_bruck_alltoall_pack(
+            sched, tmp_buf, send_pack_buf, comm_size, k, count, dtype, false /* unpack */);
+        sched->add_barrier();
+
+        entry_factory::create<recv_entry>(
+            sched, recv_pack_buf, pack_blocks * count, dtype, src, comm);
+        entry_factory::create<send_entry>(
+            sched, send_pack_buf, pack_blocks * count, dtype, dst, comm);
+        sched->add_barrier();
+
+        ccl_bruck_alltoall_pack(
+            sched, tmp_buf, recv_pack_buf, comm_size, k, count, dtype, true /* unpack */);
+        sched->add_barrier();
+    }
+
+    for (int idx = 0; idx < comm_size; idx++) {
+        int peer = (rank - idx + comm_size) % comm_size;
+        entry_factory::create<copy_entry>(
+            sched, tmp_buf + idx * block_bytes, recv_buf + peer * block_bytes, count, dtype);
+    }
+
+    return status;
+}
@@ -20,6 +20,7 @@
  *      See COPYRIGHT in top-level directory.
  */
 
+#include <cstring>
 #include <numeric>
 
 #include "coll/algorithms/algorithms.hpp"
@@ -157,6 +158,62 @@ ccl::status ccl_coll_build_naive_alltoallv(ccl_sched* main_sched,
                                           dtype);
     }
 
+    size_t lazy_threshold = ccl::global_data::env().lazy_entries_threshold;
+    if (!inplace && lazy_threshold && static_cast<size_t>(comm_size) >= lazy_threshold) {
+        /* send/recv entries are generated on the fly, their number doesn't depend on comm size */
+        void* send_buf_ptr = coll_param.get_send_buf_ptr();
+        void* recv_buf_ptr = coll_param.get_recv_buf_ptr();
+        size_t window = ccl::global_data::env().lazy_entries_window;
+
+        for (size_t sched_idx = 0; sched_idx < sched_count; sched_idx++) {
+            /*
+               rotated schedule: on step with shift s every rank sends to rank + s and
+               receives from rank - s, so no rank is targeted by all the others at once,
+               shifts s with s % sched_count == sched_idx belong to this sched
+            */
+            if (sched_idx >= static_cast<size_t>(comm_size)) {
+                continue;
+            }
+            size_t step_count = (comm_size - sched_idx + sched_count - 1) / sched_count;
+
+            entry_factory::create<generator_entry>(
+                scheds[sched_idx],
+                step_count,
+                window,
+                [=](generator_entry* gen, size_t step_idx) {
+                    size_t shift = sched_idx + step_idx * sched_count;
+                    if (shift == 0)
+                        return;
+
+                    int recv_peer = static_cast<int>((comm_rank + comm_size - shift) % comm_size);
+                    int send_peer = static_cast<int>((comm_rank + shift) % comm_size);
+
+                    if (recv_counts[recv_peer] && send_counts[recv_peer]) {
+                        gen->emit<recv_entry>(ccl_buffer(recv_buf_ptr,
+                                                         total_recv_bytes,
+                                                         recv_offsets[recv_peer],
+                                                         ccl_buffer_type::INDIRECT),
+                                              recv_counts[recv_peer],
+                                              dtype,
+                                              recv_peer,
+                                              comm);
+                    }
+                    if (recv_counts[send_peer] && send_counts[send_peer]) {
+                        gen->emit<send_entry>(ccl_buffer(send_buf_ptr,
+                                                         total_send_bytes,
+                                                         send_offsets[send_peer],
+                                                         ccl_buffer_type::INDIRECT),
+                                              send_counts[send_peer],
+                                              dtype,
+                                              send_peer,
+                                              comm);
+                    }
+                });
+        }
+
+        return ccl::status::success;
+    }
+
     for (int idx = 0; idx < comm_size; idx++) {
         if (idx == comm_rank)
             continue;
@@ -364,6 +421,380 @@ ccl::status ccl_coll_build_scatter_alltoallv(ccl_sched* main_sched,
     return ccl::status::success;
 }
 
+/*
+ * hierarchical alltoallv for block rank layout: rank = node_idx * ppn + local_idx
+ *
+ * 1. local ranks exchange per-destination-node counts and pack send data by destination local_idx
+ * 2. rank (n, l) sends to rank (n, l') everything it has for ranks (*, l') over node_comm
+ * 3. rank (n, l') regroups received data by destination node
+ * 4. rank (n, l') sends one aggregated message to each rank (m, l') over r2r_comm,
+ *    the message already has recv_buf layout of the receiver
+ */
+struct ccl_hier_alltoallv_ctx {
+    ccl_sched* sched;
+
+    size_t node_count;
+    size_t ppn;
+    size_t node_idx;
+    size_t local_idx;
+    size_t dtype_size;
+
+    /* counts[l * node_count + m] - count which rank (node_idx, l) sends to rank (m, local_idx) */
+    size_t* counts;
+
+    /* packed send data of this rank for ranks (*, local_idx) */
+    void* self_send_ptr;
+
+    /* recv_buf and offset of the block from rank (node_idx, 0) */
+    ccl_buffer recv_buf;
+    size_t self_recv_offset;
+
+    /* runtime staging: rows from local ranks followed by rows for remote nodes */
+    void* stage_buf;
+    size_t stage_bytes;
+    size_t* stage_local_offsets;
+    size_t* stage_local_counts;
+    size_t* stage_node_offsets;
+    size_t* stage_node_counts;
+};
+
+struct ccl_hier_alltoallv_peer_ctx {
+    ccl_hier_alltoallv_ctx* ctx;
+    size_t idx;
+};
+
+static ccl::status ccl_hier_alltoallv_alloc_stage(const void* fn_ctx) {
+    auto ctx = static_cast<ccl_hier_alltoallv_ctx*>(const_cast<void*>(fn_ctx));
+
+    size_t offset = 0;
+    for (size_t l = 0; l < ctx->ppn; l++) {
+        size_t count = 0;
+        for (size_t m = 0; m < ctx->node_count; m++) {
+            count += ctx->counts[l * ctx->node_count + m];
+        }
+        ctx->stage_local_offsets[l] = offset;
+        ctx->stage_local_counts[l] = count;
+        if (l != ctx->local_idx) {
+            offset += count * ctx->dtype_size;
+        }
+    }
+
+    for (size_t m = 0; m < ctx->node_count; m++) {
+        size_t count = 0;
+        for (size_t l = 0; l < ctx->ppn; l++) {
+            count += ctx->counts[l * ctx->node_count + m];
+        }
+        ctx->stage_node_offsets[m] = offset;
+        ctx->stage_node_counts[m] = count;
+        if (m != ctx->node_idx) {
+            offset += count * ctx->dtype_size;
+        }
+    }
+
+    ctx->stage_bytes = offset;
+    ctx->stage_buf = nullptr;
+    if (ctx->stage_bytes) {
+        ctx->stage_buf =
+            ctx->sched
+                ->alloc_buffer({ ctx->stage_bytes,
+                                 ccl::buffer_type::regular,
+                                 ccl::buffer_place::host,
+                                 false /* is_managed */ })
+                .get_ptr();
+    }
+
+    LOG_DEBUG("hier alltoallv: stage_bytes ", ctx->stage_bytes);
+
+    return ccl::status::success;
+}
+
+static ccl::status ccl_hier_alltoallv_regroup(const void* fn_ctx) {
+    auto ctx = static_cast<ccl_hier_alltoallv_ctx*>(const_cast<void*>(fn_ctx));
+
+    char* stage_buf = static_cast<char*>(ctx->stage_buf);
+    char* self_recv_ptr = static_cast<char*>(ctx->recv_buf.get_ptr()) + ctx->self_recv_offset;
+
+    for (size_t l = 0; l < ctx->ppn; l++) {
+        const char* src = (l == ctx->local_idx)
+                              ? static_cast<const char*>(ctx->self_send_ptr)
+                              : stage_buf + ctx->stage_local_offsets[l];
+        for (size_t m = 0; m < ctx->node_count; m++) {
+            size_t bytes = ctx->counts[l * ctx->node_count + m] * ctx->dtype_size;
+            if (!bytes) {
+                continue;
+            }
+            /* block from rank (node_idx, l) goes after blocks from ranks (node_idx, 0..l-1) */
+            size_t dst_offset = 0;
+            for (size_t idx = 0; idx < l; idx++) {
+                dst_offset += ctx->counts[idx * ctx->node_count + m] * ctx->dtype_size;
+            }
+            char* dst = (m == ctx->node_idx) ? self_recv_ptr
+                                             : stage_buf + ctx->stage_node_offsets[m];
+            memcpy(dst + dst_offset, src, bytes);
+            src += bytes;
+        }
+    }
+
+    return ccl::status::success;
+}
+
+static ccl::status ccl_hier_alltoallv_free_stage(const void* fn_ctx) {
+    auto ctx = static_cast<ccl_hier_alltoallv_ctx*>(const_cast<void*>(fn_ctx));
+    if (ctx->stage_buf) {
+        ctx->sched->dealloc_buffer(
+            { ctx->stage_buf, ctx->stage_bytes, ccl::buffer_type::regular });
+        ctx->stage_buf = nullptr;
+    }
+    return ccl::status::success;
+}
+
+static ccl::status ccl_hier_alltoallv_get_local_buf(const void* fn_ctx, void* field_ptr) {
+    auto peer_ctx = static_cast<const ccl_hier_alltoallv_peer_ctx*>(fn_ctx);
+    auto ctx = peer_ctx->ctx;
+    size_t bytes = ctx->stage_local_counts[peer_ctx->idx] * ctx->dtype_size;
+    ccl_buffer* buf_ptr = static_cast<ccl_buffer*>(field_ptr);
+    buf_ptr->set(bytes ? static_cast<char*>(ctx->stage_buf) +
+                             ctx->stage_local_offsets[peer_ctx->idx]
+                       : nullptr,
+                 bytes);
+    return ccl::status::success;
+}
+
+static ccl::status ccl_hier_alltoallv_get_local_count(const void* fn_ctx, void* field_ptr) {
+    auto peer_ctx = static_cast<const ccl_hier_alltoallv_peer_ctx*>(fn_ctx);
+    size_t* count_ptr = static_cast<size_t*>(field_ptr);
+    *count_ptr = peer_ctx->ctx->stage_local_counts[peer_ctx->idx];
+    return ccl::status::success;
+}
+
+static ccl::status ccl_hier_alltoallv_get_node_buf(const void* fn_ctx, void* field_ptr) {
+    auto peer_ctx = static_cast<const ccl_hier_alltoallv_peer_ctx*>(fn_ctx);
+    auto ctx = peer_ctx->ctx;
+    size_t bytes = ctx->stage_node_counts[peer_ctx->idx] * ctx->dtype_size;
+    ccl_buffer* buf_ptr = static_cast<ccl_buffer*>(field_ptr);
+    buf_ptr->set(bytes ? static_cast<char*>(ctx->stage_buf) +
+                             ctx->stage_node_offsets[peer_ctx->idx]
+                       : nullptr,
+                 bytes);
+    return ccl::status::success;
+}
+
+static ccl::status ccl_hier_alltoallv_get_node_count(const void* fn_ctx, void* field_ptr) {
+    auto peer_ctx = static_cast<const ccl_hier_alltoallv_peer_ctx*>(fn_ctx);
+    size_t* count_ptr = static_cast<size_t*>(field_ptr);
+    *count_ptr = peer_ctx->ctx->stage_node_counts[peer_ctx->idx];
+    return ccl::status::success;
+}
+
+ccl::status ccl_coll_build_hier_alltoallv(ccl_sched* main_sched,
+                                          std::vector<ccl_sched*>& scheds,
+                                          const ccl_coll_param& coll_param) {
+    LOG_DEBUG("build hier alltoallv");
+
+    ccl_comm* comm = coll_param.comm;
+    ccl_comm* node_comm = comm->get_node_comm().get();
+    ccl_comm* r2r_comm = comm->get_r2r_comm().get();
+    ccl_sched* sched = scheds.front();
+    const ccl_datatype& dtype = coll_param.dtype;
+
+    int comm_rank = comm->rank();
+    size_t dtype_size = dtype.size();
+    size_t ppn = node_comm->size();
+    size_t node_count = r2r_comm->size();
+    size_t node_idx = comm_rank / ppn;
+    size_t local_idx = comm_rank % ppn;
+
+    CCL_THROW_IF_NOT(ppn * node_count == static_cast<size_t>(comm->size()) &&
+                         node_comm->rank() == static_cast<int>(local_idx) &&
+                         r2r_comm->rank() == static_cast<int>(node_idx),
+                     "unexpected rank layout: comm ",
+                     comm->to_string(),
+                     ", node_comm ",
+                     node_comm->to_string(),
+                     ", r2r_comm ",
+                     r2r_comm->to_string());
+    for (size_t idx = 0; idx < ppn; idx++) {
+        CCL_THROW_IF_NOT(node_comm->get_global_rank(idx) ==
+                             comm->get_global_rank(node_idx * ppn + idx),
+                         "unexpected node_comm rank ",
+                         idx);
+    }
+    for (size_t idx = 0; idx < node_count; idx++) {
+        CCL_THROW_IF_NOT(r2r_comm->get_global_rank(idx) ==
+                             comm->get_global_rank(idx * ppn + local_idx),
+                         "unexpected r2r_comm rank ",
+                         idx);
+    }
+
+    std::vector<size_t> send_counts, recv_counts, send_offsets, recv_offsets;
+    size_t total_send_count = 0, total_recv_count = 0;
+    size_t total_send_bytes = 0, total_recv_bytes = 0;
+
+    ccl_coll_calculate_alltoallv_counts(coll_param,
+                                        send_counts,
+                                        recv_counts,
+                                        send_offsets,
+                                        recv_offsets,
+                                        total_send_count,
+                                        total_recv_count,
+                                        total_send_bytes,
+                                        total_recv_bytes);
+
+    ccl_buffer send_buf(coll_param.get_send_buf_ptr(), total_send_bytes, ccl_buffer_type::INDIRECT);
+    ccl_buffer recv_buf(coll_param.get_recv_buf_ptr(), total_recv_bytes, ccl_buffer_type::INDIRECT);
+
+    auto ctx = static_cast<ccl_hier_alltoallv_ctx*>(
+        sched->alloc_buffer(sizeof(ccl_hier_alltoallv_ctx)).get_ptr());
+    new (ctx) ccl_hier_alltoallv_ctx{};
+    ctx->sched = sched;
+    ctx->node_count = node_count;
+    ctx->ppn = ppn;
+    ctx->node_idx = node_idx;
+    ctx->local_idx = local_idx;
+    ctx->dtype_size = dtype_size;
+    ctx->recv_buf = recv_buf;
+    ctx->self_recv_offset = recv_offsets[node_idx * ppn];
+
+    size_t counts_bytes = ppn * node_count * sizeof(size_t);
+    ctx->counts = static_cast<size_t*>(sched->alloc_buffer(counts_bytes).get_ptr());
+    ctx->stage_local_offsets = static_cast<size_t*>(
+        sched->alloc_buffer(4 * (ppn + node_count) * sizeof(size_t)).get_ptr());
+    ctx->stage_local_counts = ctx->stage_local_offsets + ppn;
+    ctx->stage_node_offsets = ctx->stage_local_counts + ppn;
+    ctx->stage_node_counts = ctx->stage_node_offsets + node_count;
+
+    auto peer_ctxs = static_cast<ccl_hier_alltoallv_peer_ctx*>(
+        sched->alloc_buffer((ppn + node_count) * sizeof(ccl_hier_alltoallv_peer_ctx)).get_ptr());
+    auto local_peer_ctxs = peer_ctxs;
+    auto node_peer_ctxs = peer_ctxs + ppn;
+    for (size_t idx = 0; idx < ppn; idx++) {
+        local_peer_ctxs[idx] = { ctx, idx };
+    }
+    for (size_t idx = 0; idx < node_count; idx++) {
+        node_peer_ctxs[idx] = { ctx, idx };
+    }
+
+    /* send_counts_by_local[l * node_count + m] - count which this rank sends to rank (m, l) */
+    auto send_counts_by_local = static_cast<size_t*>(sched->alloc_buffer(counts_bytes).get_ptr());
+    for (size_t l = 0; l < ppn; l++) {
+        for (size_t m = 0; m < node_count; m++) {
+            send_counts_by_local[l * node_count + m] = send_counts[m * ppn + l];
+        }
+    }
+    memcpy(ctx->counts + local_idx * node_count,
+           send_counts_by_local + local_idx * node_count,
+           node_count * sizeof(size_t));
+
+    /* 1. exchange counts and pack send data by destination local_idx */
+    ccl_buffer send_pack_buf;
+    if (total_send_bytes) {
+        send_pack_buf = sched->alloc_buffer({ total_send_bytes, send_buf });
+    }
+
+    std::vector<size_t> send_pack_offsets(ppn, 0);
+    size_t send_pack_offset = 0;
+    for (size_t l = 0; l < ppn; l++) {
+        send_pack_offsets[l] = send_pack_offset;
+        for (size_t m = 0; m < node_count; m++) {
+            size_t peer = m * ppn + l;
+            if (!send_counts[peer]) {
+                continue;
+            }
+            entry_factory::create<copy_entry>(sched,
+                                              send_buf + send_offsets[peer],
+                                              send_pack_buf + send_pack_offset,
+                                              send_counts[peer],
+                                              dtype);
+            send_pack_offset += send_counts[peer] * dtype_size;
+        }
+    }
+    ctx->self_send_ptr =
+        (total_send_bytes) ? (send_pack_buf + send_pack_offsets[local_idx]).get_ptr() : nullptr;
+
+    size_t counts_row_bytes = node_count * sizeof(size_t);
+    for (size_t idx = 1; idx < ppn; idx++) {
+        int src = (local_idx + ppn - idx) % ppn;
+        int dst = (local_idx + idx) % ppn;
+        entry_factory::create<recv_entry>(
+            sched,
+            ccl_buffer(ctx->counts, counts_bytes, src * counts_row_bytes),
+            counts_row_bytes,
+            ccl_datatype_int8,
+            src,
+            node_comm);
+        entry_factory::create<send_entry>(
+            sched,
+            ccl_buffer(send_counts_by_local, counts_bytes, dst * counts_row_bytes),
+            counts_row_bytes,
+            ccl_datatype_int8,
+            dst,
+            node_comm);
+    }
+    sched->add_barrier();
+
+    entry_factory::create<function_entry>(sched, ccl_hier_alltoallv_alloc_stage, ctx);
+    sched->add_barrier();
+
+    /* 2. send packed data to local ranks */
+    for (size_t idx = 1; idx < ppn; idx++) {
+        int src = (local_idx + ppn - idx) % ppn;
+        int dst = (local_idx + idx) % ppn;
+        auto recv = entry_factory::create<recv_entry>(
+            sched, ccl_buffer(), 0, dtype, src, node_comm);
+        recv->set_field_fn<ccl_sched_entry_field_buf>(
+            ccl_hier_alltoallv_get_local_buf, &local_peer_ctxs[src], false);
+        recv->set_field_fn<ccl_sched_entry_field_cnt>(
+            ccl_hier_alltoallv_get_local_count, &local_peer_ctxs[src], false);
+
+        size_t send_count = 0;
+        for (size_t m = 0; m < node_count; m++) {
+            send_count += send_counts[m * ppn + dst];
+        }
+        entry_factory::create<send_entry>(sched,
+                                          (send_count) ? send_pack_buf + send_pack_offsets[dst]
+                                                       : ccl_buffer(),
+                                          send_count,
+                                          dtype,
+                                          dst,
+                                          node_comm);
+    }
+    sched->add_barrier();
+
+    /* 3. regroup by destination node, own node goes directly to recv_buf */
+    entry_factory::create<function_entry>(sched, ccl_hier_alltoallv_regroup, ctx);
+    sched->add_barrier();
+
+    /* 4. exchange aggregated messages between nodes */
+    for (size_t idx = 1; idx < node_count; idx++) {
+        int src = (node_idx + node_count - idx) % node_count;
+        int dst = (node_idx + idx) % node_count;
+
+        size_t recv_count = 0;
+        for (size_t l = 0; l < ppn; l++) {
+            recv_count += recv_counts[src * ppn + l];
+        }
+        entry_factory::create<recv_entry>(sched,
+                                          (recv_count) ? recv_buf + recv_offsets[src * ppn]
+                                                       : ccl_buffer(),
+                                          recv_count,
+                                          dtype,
+                                          src,
+                                          r2r_comm);
+
+        auto send = entry_factory::create<send_entry>(
+            sched, ccl_buffer(), 0, dtype, dst, r2r_comm);
+        send->set_field_fn<ccl_sched_entry_field_buf>(
+            ccl_hier_alltoallv_get_node_buf, &node_peer_ctxs[dst], false);
+        send->set_field_fn<ccl_sched_entry_field_cnt>(
+            ccl_hier_alltoallv_get_node_count, &node_peer_ctxs[dst], false);
+    }
+    sched->add_barrier();
+
+    entry_factory::create<function_entry>(sched, ccl_hier_alltoallv_free_stage, ctx);
+
+    return ccl::status::success;
+}
+
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
 ccl::status ccl_coll_build_topo_alltoallv(ccl_sched* main_sched,
                                           std::vector<ccl_sched*>& scheds,
@@ -23,24 +23,78 @@ static void bcast_tree(const ccl_bin_tree& tree,
                        size_t count,
                        const ccl_datatype& dtype,
                        ccl_comm* comm) {
+    sched_entry* recv = nullptr;
     if (tree.parent() != -1) {
         LOG_DEBUG("recv from parent ", tree.parent());
-        entry_factory::create<recv_entry>(
+        recv = entry_factory::create<recv_entry>(
             sched, buffer, count, dtype, static_cast<size_t>(tree.parent()), comm);
-        sched->add_barrier();
     }
     if (tree.left() != -1) {
         LOG_DEBUG("send to left ", tree.left());
-        entry_factory::create<send_entry>(
+        auto send = entry_factory::create<send_entry>(
             sched, buffer, count, dtype, static_cast<size_t>(tree.left()), comm);
+        if (recv) {
+            send->add_dependency(recv);
+        }
     }
     if (tree.right() != -1) {
         LOG_DEBUG("send to right ", tree.right());
-        entry_factory::create<send_entry>(
+        auto send = entry_factory::create<send_entry>(
             sched, buffer, count, dtype, static_cast<size_t>(tree.right()), comm);
+        if (recv) {
+            send->add_dependency(recv);
+        }
     }
 }
 
+/* returns entries which complete the reduction of children data into buffer */
+static std::vector<sched_entry*> recv_reduce_children(const ccl_bin_tree& tree,
+                                                      ccl_sched* sched,
+                                                      ccl_buffer buffer,
+                                                      size_t count,
+                                                      const ccl_datatype& dtype,
+                                                      ccl::reduction reduction,
+                                                      ccl_comm* comm) {
+    /* for avg the tree root divides on the last reduction,
+       children are reduced one by one to keep that step the final one */
+    bool is_avg_root = (reduction == ccl::reduction::avg && tree.parent() == -1);
+    size_t avg_divisor = is_avg_root ? static_cast<size_t>(comm->size()) : 1;
+
+    std::vector<sched_entry*> reduces;
+    if (tree.left() != -1) {
+        LOG_DEBUG("recv_reduce left ", tree.left());
+        reduces.push_back(
+            entry_factory::create<recv_reduce_entry>(sched,
+                                                     buffer,
+                                                     count,
+                                                     dtype,
+                                                     reduction,
+                                                     static_cast<size_t>(tree.left()),
+                                                     comm,
+                                                     ccl_buffer(),
+                                                     ccl_recv_reduce_local_buf,
+                                                     (tree.right() == -1) ? avg_divisor : 1));
+    }
+    if (tree.right() != -1) {
+        LOG_DEBUG("recv_reduce right ", tree.right());
+        auto reduce = entry_factory::create<recv_reduce_entry>(sched,
+                                                               buffer,
+                                                               count,
+                                                               dtype,
+                                                               reduction,
+                                                               static_cast<size_t>(tree.right()),
+                                                               comm,
+                                                               ccl_buffer(),
+                                                               ccl_recv_reduce_local_buf,
+                                                               avg_divisor);
+        if (is_avg_root && !reduces.empty()) {
+            reduce->add_dependency(reduces.back());
+        }
+        reduces.push_back(reduce);
+    }
+    return reduces;
+}
+
 static void reduce_tree(const ccl_bin_tree& tree,
                         ccl_sched* sched,
                         ccl_buffer buffer,
@@ -48,23 +102,14 @@ static void reduce_tree(const ccl_bin_tree& tree,
                         const ccl_datatype& dtype,
                         ccl::reduction reduction,
                         ccl_comm* comm) {
-    if (tree.left() != -1) {
-        LOG_DEBUG("recv_reduce left ", tree.left());
-        entry_factory::create<recv_reduce_entry>(
-            sched, buffer, count, dtype, reduction, static_cast<size_t>(tree.left()), comm);
-    }
-    if (tree.right() != -1) {
-        LOG_DEBUG("recv_reduce right ", tree.right());
-        entry_factory::create<recv_reduce_entry>(
-            sched, buffer, count, dtype, reduction, static_cast<size_t>(tree.right()), comm);
-    }
+    auto reduces = recv_reduce_children(tree, sched, buffer, count, dtype, reduction, comm);
     if (tree.parent() != -1) {
-        if (tree.left() != -1 || tree.right() != -1) {
-            sched->add_barrier();
-        }
         LOG_DEBUG("send to parent ", tree.parent());
-        entry_factory::create<send_entry>(
+        auto send = entry_factory::create<send_entry>(
             sched, buffer, count, dtype, static_cast<size_t>(tree.parent()), comm);
+        for (auto reduce : reduces) {
+            send->add_dependency(reduce);
+        }
     }
 }
 
@@ -75,43 +120,40 @@ static void reduce_bcast_tree(const ccl_bin_tree& tree,
                               const ccl_datatype& dtype,
                               ccl::reduction reduction,
                               ccl_comm* comm) {
-    if (tree.left() != -1) {
-        LOG_DEBUG("recv_reduce left ", tree.left());
-        entry_factory::create<recv_reduce_entry>(
-            sched, buffer, count, dtype, reduction, static_cast<size_t>(tree.left()), comm);
-    }
-    if (tree.right() != -1) {
-        LOG_DEBUG("recv_reduce right ", tree.right());
-        entry_factory::create<recv_reduce_entry>(
-            sched, buffer, count, dtype, reduction, static_cast<size_t>(tree.right()), comm);
-    }
+    /* entries which have to be completed before the result is sent to children */
+    auto reduced = recv_reduce_children(tree, sched, buffer, count, dtype, reduction, comm);
     if (tree.parent() != -1) {
-        if (tree.left() != -1 || tree.right() != -1) {
-            sched->add_barrier();
-        }
-
         LOG_DEBUG("send to parent ", tree.parent());
-        entry_factory::create<send_entry>(
+        auto send = entry_factory::create<send_entry>(
             sched, buffer, count, dtype, static_cast<size_t>(tree.parent()), comm);
 
         LOG_DEBUG("recv from parent ", tree.parent());
-        entry_factory::create<recv_entry>(
+        auto recv = entry_factory::create<recv_entry>(
             sched, buffer, count, dtype, static_cast<size_t>(tree.parent()), comm);
-    }
 
-    if (tree.left() != -1 || tree.right() != -1) {
-        sched->add_barrier();
+        for (auto reduce : reduced) {
+            send->add_dependency(reduce);
+            recv->add_dependency(reduce);
+        }
+        reduced.push_back(send);
+        reduced.push_back(recv);
     }
 
     if (tree.left() != -1) {
         LOG_DEBUG("send to left ", tree.left());
-        entry_factory::create<send_entry>(
+        auto send = entry_factory::create<send_entry>(
             sched, buffer, count, dtype, static_cast<size_t>(tree.left()), comm);
+        for (auto dep : reduced) {
+            send->add_dependency(dep);
+        }
     }
     if (tree.right() != -1) {
         LOG_DEBUG("send to right ", tree.right());
-        entry_factory::create<send_entry>(
+        auto send = entry_factory::create<send_entry>(
             sched, buffer, count, dtype, static_cast<size_t>(tree.right()), comm);
+        for (auto dep : reduced) {
+            send->add_dependency(dep);
+        }
     }
 }
 
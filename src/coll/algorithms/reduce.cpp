@@ -220,13 +220,17 @@ ccl::status ccl_coll_build_rabenseifner_reduce(ccl_sched* sched,
 
             /* This algorithm is used only for predefined ops
              * and predefined ops are always commutative. */
+            size_t avg_divisor = (reduction == ccl::reduction::avg && mask * 2 == pof2)
+                                     ? static_cast<size_t>(comm_size)
+                                     : 1;
             entry_factory::create<reduce_local_entry>(sched,
                                                       (tmp_buf + disps[recv_idx] * dtype_size),
                                                       recv_cnt,
                                                       (recv_buf + disps[recv_idx] * dtype_size),
                                                       nullptr,
                                                       dtype,
-                                                      reduction);
+                                                      reduction,
+                                                      avg_divisor);
             sched->add_barrier();
 
             /* update send_idx for next iteration */
@@ -504,8 +508,13 @@ ccl::status ccl_coll_build_binomial_reduce(ccl_sched* sched,
                 entry_factory::create<recv_entry>(sched, tmp_buf, count, dtype, source, comm);
                 sched->add_barrier();
 
+                /* root combines the last child on the highest mask */
+                size_t avg_divisor =
+                    (reduction == ccl::reduction::avg && relrank == 0 && mask * 2 >= comm_size)
+                        ? static_cast<size_t>(comm_size)
+                        : 1;
                 entry_factory::create<reduce_local_entry>(
-                    sched, tmp_buf, count, recv_buf, nullptr, dtype, reduction);
+                    sched, tmp_buf, count, recv_buf, nullptr, dtype, reduction, avg_divisor);
                 sched->add_barrier();
             }
         }
@@ -22,6 +22,7 @@
 
 #include "coll/algorithms/algorithms.hpp"
 #include "coll/coll_util.hpp"
+#include "coll/selection/tuning.hpp"
 #include "sched/entry/factory/entry_factory.hpp"
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
 #include "sched/entry/ze/ze_dummy_entry.hpp"
@@ -131,8 +132,11 @@ ccl::status ccl_coll_build_naive_reduce_scatter(ccl_sched* sched,
 
         sched->add_barrier();
 
+        size_t avg_divisor = (op == ccl::reduction::avg && idx == comm_size - 1)
+                                 ? static_cast<size_t>(comm_size)
+                                 : 1;
         entry_factory::create<reduce_local_entry>(
-            sched, tmp_buf, recv_count, recv_buf, nullptr, dtype, op);
+            sched, tmp_buf, recv_count, recv_buf, nullptr, dtype, op, avg_divisor);
     }
 
     return status;
@@ -195,7 +199,8 @@ ccl::status ccl_coll_build_reduce_scatter_block(ccl_sched* sched,
                                                 size_t recv_count,
                                                 const ccl_datatype& dtype,
                                                 ccl::reduction op,
-                                                ccl_comm* comm) {
+                                                ccl_comm* comm,
+                                                ccl_reduce_scatter_block_deps* deps) {
     LOG_DEBUG("build reduce_scatter block (ring)");
 
     CCL_THROW_IF_NOT(sched && send_buf && recv_buf,
@@ -223,11 +228,16 @@ ccl::status ccl_coll_build_reduce_scatter_block(ccl_sched* sched,
         return status;
     }
 
-    size_t chunk_count =
-        (bytes >= ccl::global_data::env().rs_min_chunk_size &&
-         count >= ccl::global_data::env().rs_chunk_count && (int)count >= comm_size)
-            ? ccl::global_data::env().rs_chunk_count
-            : 1;
+    size_t max_chunk_count =
+        ccl::global_data::get().tuning->get_param(ccl_tuning_param::rs_chunk_count,
+                                                  sched->coll_param.ctype,
+                                                  comm_size,
+                                                  bytes,
+                                                  ccl::global_data::env().rs_chunk_count);
+    size_t chunk_count = (bytes >= ccl::global_data::env().rs_min_chunk_size &&
+                          count >= max_chunk_count && (int)count >= comm_size)
+                             ? max_chunk_count
+                             : 1;
 
     while ((chunk_count > 1) &&
            (bytes / (comm_size * chunk_count) < ccl::global_data::env().rs_min_chunk_size)) {
@@ -251,10 +261,19 @@ ccl::status ccl_coll_build_reduce_scatter_block(ccl_sched* sched,
               ", chunk_count ",
               chunk_count);
 
+    if (deps) {
+        deps->block_entries.assign(comm_size, {});
+    }
+
     if (comm_size == 1) {
         if (!inplace) {
-            entry_factory::create<copy_entry>(sched, send_buf, recv_buf, count, dtype);
-            sched->add_barrier();
+            auto copy = entry_factory::create<copy_entry>(sched, send_buf, recv_buf, count, dtype);
+            if (deps) {
+                deps->block_entries[0].push_back(copy);
+            }
+            else {
+                sched->add_barrier();
+            }
         }
         return ccl::status::success;
     }
@@ -292,7 +311,32 @@ ccl::status ccl_coll_build_reduce_scatter_block(ccl_sched* sched,
 
     ccl_recv_reduce_result_buf_type recv_reduce_result_type;
 
+    /* entries are linked by dependencies instead of per-chunk barriers:
+       sends and recvs keep their posting order for tag matching
+       and a chunk is forwarded as soon as its own reduction is done */
+    sched_entry* prev_send_entry = nullptr;
+    sched_entry* prev_recv_entry = nullptr;
+    /* entries producing the final data of each chunk of the send/recv block */
+    std::vector<sched_entry*> send_chunk_entries(chunk_count, nullptr);
+    std::vector<sched_entry*> recv_chunk_entries(chunk_count, nullptr);
+
+    auto add_dependency = [](sched_entry* entry, sched_entry* dep) {
+        if (dep) {
+            entry->add_dependency(dep);
+        }
+    };
+
+    auto track_block = [deps](sched_entry* entry, int block) {
+        if (deps) {
+            deps->block_entries[block].push_back(entry);
+        }
+    };
+
     for (int idx = 0; idx < (comm_size - 1); idx++) {
+        /* block received on the previous iteration is sent on this one */
+        send_chunk_entries.swap(recv_chunk_entries);
+        std::fill(recv_chunk_entries.begin(), recv_chunk_entries.end(), nullptr);
+
         send_block_idx = block_idx;
         recv_block_idx = (comm_size + block_idx - 1) % comm_size;
 
@@ -353,38 +397,72 @@ ccl::status ccl_coll_build_reduce_scatter_block(ccl_sched* sched,
             recv_reduce_local_buf += reduce_chunk_offset;
             recv_reduce_comm_buf += reduce_chunk_offset;
 
-            entry_factory::create<send_entry>(sched, sbuf, send_chunk_size, dtype, dst, comm);
+            /* blocks reduced on the last iteration hold the final result */
+            bool is_last_iter = (idx == comm_size - 2);
+            size_t final_avg_divisor =
+                (op == ccl::reduction::avg) ? static_cast<size_t>(comm_size) : 1;
+
+            auto send = entry_factory::create<send_entry>(
+                sched, sbuf, send_chunk_size, dtype, dst, comm);
+            add_dependency(send, prev_send_entry);
+            add_dependency(send, send_chunk_entries[chunk_idx]);
+            track_block(send, send_block_idx);
+            prev_send_entry = send;
 
             if (!use_prev) {
                 CCL_ASSERT(recv_chunk_size == reduce_chunk_size);
-                entry_factory::create<recv_reduce_entry>(sched,
-                                                         recv_reduce_local_buf,
-                                                         recv_chunk_size,
-                                                         dtype,
-                                                         op,
-                                                         src,
-                                                         comm,
-                                                         recv_reduce_comm_buf,
-                                                         recv_reduce_result_type);
+                auto recv_reduce =
+                    entry_factory::create<recv_reduce_entry>(sched,
+                                                             recv_reduce_local_buf,
+                                                             recv_chunk_size,
+                                                             dtype,
+                                                             op,
+                                                             src,
+                                                             comm,
+                                                             recv_reduce_comm_buf,
+                                                             recv_reduce_result_type,
+                                                             is_last_iter ? final_avg_divisor : 1);
+                add_dependency(recv_reduce, prev_recv_entry);
+                track_block(recv_reduce, recv_block_idx);
+                prev_recv_entry = recv_reduce;
+                recv_chunk_entries[chunk_idx] = recv_reduce;
             }
             else {
-                entry_factory::create<recv_entry>(sched, rbuf, recv_chunk_size, dtype, src, comm);
+                /* the delayed reduction below consumes the previous recv */
+                sched_entry* reduce_recv_entry = prev_recv_entry;
+
+                auto recv = entry_factory::create<recv_entry>(
+                    sched, rbuf, recv_chunk_size, dtype, src, comm);
+                add_dependency(recv, prev_recv_entry);
+                track_block(recv, recv_block_idx);
+                prev_recv_entry = recv;
 
                 if (idx + chunk_idx > 0) {
-                    entry_factory::create<reduce_local_entry>(sched,
-                                                              reduce_in_buf,
-                                                              reduce_chunk_size,
-                                                              reduce_inout_buf,
-                                                              nullptr,
-                                                              dtype,
-                                                              op);
-                    sched->add_barrier();
+                    /* with delayed reduction chunk_idx == 0 still reduces the previous block */
+                    size_t avg_divisor =
+                        (is_last_iter && chunk_idx > 0) ? final_avg_divisor : 1;
+                    auto reduce = entry_factory::create<reduce_local_entry>(sched,
+                                                                            reduce_in_buf,
+                                                                            reduce_chunk_size,
+                                                                            reduce_inout_buf,
+                                                                            nullptr,
+                                                                            dtype,
+                                                                            op,
+                                                                            avg_divisor);
+                    add_dependency(reduce, reduce_recv_entry);
+                    if (chunk_idx > 0) {
+                        recv_chunk_entries[chunk_idx - 1] = reduce;
+                        track_block(reduce, recv_block_idx);
+                    }
+                    else {
+                        /* last chunk of the previous block, it is sent on this iteration */
+                        send_chunk_entries[chunk_count - 1] = reduce;
+                        track_block(reduce, send_block_idx);
+                    }
                 }
 
                 if ((idx == comm_size - 2) && (chunk_idx == chunk_count - 1)) {
                     /* tail reduction for last recv operation */
-                    sched->add_barrier();
-
                     if (inplace) {
                         reduce_in_buf = tmp_buf;
                         reduce_inout_buf = recv_buf;
@@ -397,23 +475,35 @@ ccl::status ccl_coll_build_reduce_scatter_block(ccl_sched* sched,
                     reduce_in_buf += recv_chunk_offset;
                     reduce_inout_buf += recv_chunk_offset;
 
-                    entry_factory::create<reduce_local_entry>(sched,
-                                                              reduce_in_buf,
-                                                              recv_chunk_size,
-                                                              reduce_inout_buf,
-                                                              nullptr,
-                                                              dtype,
-                                                              op);
+                    auto tail_reduce =
+                        entry_factory::create<reduce_local_entry>(sched,
+                                                                  reduce_in_buf,
+                                                                  recv_chunk_size,
+                                                                  reduce_inout_buf,
+                                                                  nullptr,
+                                                                  dtype,
+                                                                  op,
+                                                                  final_avg_divisor);
+                    add_dependency(tail_reduce, recv);
+                    track_block(tail_reduce, recv_block_idx);
+                    recv_chunk_entries[chunk_idx] = tail_reduce;
                 }
             }
-
-            sched->add_barrier();
         }
 
         /* move blocks left */
         block_idx = (comm_size + block_idx - 1) % comm_size;
     }
 
+    if (deps) {
+        deps->last_send = prev_send_entry;
+        deps->last_recv = prev_recv_entry;
+    }
+    else {
+        /* callers expect the whole block to be completed after the last entry */
+        sched->add_barrier();
+    }
+
     return status;
 }
 
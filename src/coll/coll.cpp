@@ -198,7 +198,9 @@ static ccl_request* ccl_coll_create(ccl_coll_param& param, const ccl_coll_attr&
     }
 
     // TODO: remove after MLSL-3510 (asynchronous ofi failure) is fixed
-    if (ccl::global_data::env().atl_transport == ccl_atl_ofi) {
+    // shm has no hmem support, device buffers go through host staging copies
+    if (ccl::global_data::env().atl_transport == ccl_atl_ofi ||
+        ccl::global_data::env().atl_transport == ccl_atl_shm) {
         attr.synchronous = 1;
     }
 
@@ -241,6 +243,21 @@ static ccl_request* ccl_coll_create(ccl_coll_param& param, const ccl_coll_attr&
     selector_param.peer_rank = param.peer_rank;
     selector_param.is_scaleout = param.is_scaleout;
 
+    bool is_tune_trial = false;
+    ccl_coll_algo tuned_algo =
+        param.comm->get_coll_tuner().select(param, selector_param, is_tune_trial);
+    if (tuned_algo.has_value()) {
+        param.hint_algo = tuned_algo;
+        selector_param.hint_algo = tuned_algo;
+    }
+    else if (!is_tune_trial) {
+        ccl_coll_algo modeled_algo = param.comm->get_cost_model().select(param, selector_param);
+        if (modeled_algo.has_value()) {
+            param.hint_algo = modeled_algo;
+            selector_param.hint_algo = modeled_algo;
+        }
+    }
+
     // Some allgatherv algos hang up because of L0 submissions from multiple schedules MLSL-3258, MLSL-3461
     // WA is to make allgatherv flat & mullti_bcast synchronous
     if (param.ctype == ccl_coll_allgatherv &&
@@ -347,8 +364,14 @@ static ccl_request* ccl_coll_create(ccl_coll_param& param, const ccl_coll_attr&
         }
     }
 
+    if (is_tune_trial) {
+        /* every trial is timed from scratch */
+        attr.to_cache = 0;
+    }
+
     /* 2. create or get schedule */
     ccl_sched* sched = ccl_sched::create(param, attr);
+    sched->is_tune_trial = is_tune_trial;
 
     /* 3. fuse schedule */
     if (!postpone_schedule &&
@@ -447,6 +470,7 @@ ccl::status ccl_coll_build_allgather(ccl_sched* sched,
     param.is_scaleout = is_scaleout;
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_allgather>(param);
+    sched->selected_algo.allgather = algo;
 
     switch (algo) {
         case ccl_coll_allgather_direct:
@@ -492,6 +516,7 @@ ccl::status ccl_coll_build_allgatherv(ccl_sched* sched,
 
     auto algo =
         ccl::global_data::get().algorithm_selector->get<ccl_coll_allgatherv>(selector_param);
+    sched->selected_algo.allgatherv = algo;
 
     auto get_coll_param = [&]() {
         ccl_coll_param coll_param{};
@@ -575,6 +600,7 @@ ccl::status ccl_coll_build_allreduce(ccl_sched* sched,
     param.ctype = ccl_coll_allreduce;
     param.count = count;
     param.dtype = dtype;
+    param.reduction = reduction;
     param.comm = comm;
     param.stream = sched->coll_param.stream;
     param.buf = send_buf.get_ptr();
@@ -585,6 +611,7 @@ ccl::status ccl_coll_build_allreduce(ccl_sched* sched,
     param.is_scaleout = is_scaleout;
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_allreduce>(param);
+    sched->selected_algo.allreduce = algo;
 
     switch (algo) {
         case ccl_coll_allreduce_direct:
@@ -662,11 +689,15 @@ ccl::status ccl_coll_build_alltoall(ccl_sched* sched,
     param.is_scaleout = is_scaleout;
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_alltoall>(param);
+    sched->selected_algo.alltoall = algo;
 
     switch (algo) {
         case ccl_coll_alltoall_direct:
             CCL_CALL(ccl_coll_build_direct_alltoall(sched, send_buf, recv_buf, count, dtype, comm));
             break;
+        case ccl_coll_alltoall_bruck:
+            CCL_CALL(ccl_coll_build_bruck_alltoall(sched, send_buf, recv_buf, count, dtype, comm));
+            break;
         default:
             CCL_FATAL("unexpected alltoall_algo ", ccl_coll_algorithm_to_str(algo));
             return ccl::status::invalid_arguments;
@@ -697,6 +728,7 @@ ccl::status ccl_coll_build_alltoallv(ccl_sched* sched,
     param.is_scaleout = is_scaleout;
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_alltoallv>(param);
+    sched->selected_algo.alltoallv = algo;
 
     switch (algo) {
         case ccl_coll_alltoallv_direct:
@@ -722,6 +754,7 @@ ccl::status ccl_coll_build_barrier(ccl_sched* sched, ccl_comm* comm) {
     param.hint_algo = sched->hint_algo;
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_barrier>(param);
+    sched->selected_algo.barrier = algo;
 
     switch (algo) {
         case ccl_coll_barrier_direct: CCL_CALL(ccl_coll_build_direct_barrier(sched, comm)); break;
@@ -757,6 +790,7 @@ ccl::status ccl_coll_build_bcast(ccl_sched* sched,
     param.hint_algo = sched->hint_algo;
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_bcast>(param);
+    sched->selected_algo.bcast = algo;
 
     switch (algo) {
         case ccl_coll_bcast_direct:
@@ -815,6 +849,7 @@ ccl::status ccl_coll_build_broadcast(ccl_sched* sched,
     param.hint_algo = sched->hint_algo;
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_broadcast>(param);
+    sched->selected_algo.broadcast = algo;
 
     switch (algo) {
         case ccl_coll_broadcast_direct:
@@ -870,6 +905,7 @@ ccl::status ccl_coll_build_reduce(ccl_sched* sched,
     param.ctype = ccl_coll_reduce;
     param.count = count;
     param.dtype = dtype;
+    param.reduction = reduction;
     param.comm = comm;
     param.stream = sched->coll_param.stream;
     param.buf = send_buf.get_ptr();
@@ -880,6 +916,7 @@ ccl::status ccl_coll_build_reduce(ccl_sched* sched,
     param.is_scaleout = is_scaleout;
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_reduce>(param);
+    sched->selected_algo.reduce = algo;
 
     switch (algo) {
         case ccl_coll_reduce_direct:
@@ -939,6 +976,7 @@ ccl::status ccl_coll_build_reduce_scatter(ccl_sched* sched,
     param.ctype = ccl_coll_reduce_scatter;
     param.count = count;
     param.dtype = dtype;
+    param.reduction = reduction;
     param.comm = comm;
     param.stream = sched->coll_param.stream;
     param.buf = send_buf.get_ptr();
@@ -949,6 +987,7 @@ ccl::status ccl_coll_build_reduce_scatter(ccl_sched* sched,
     param.is_scaleout = is_scaleout;
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_reduce_scatter>(param);
+    sched->selected_algo.reduce_scatter = algo;
 
     switch (algo) {
         case ccl_coll_reduce_scatter_direct:
@@ -1010,6 +1049,7 @@ ccl::status ccl_coll_build_recv(ccl_sched* sched,
     param.hint_algo = sched->hint_algo;
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_recv>(param);
+    sched->selected_algo.recv = algo;
 
     switch (algo) {
         case ccl_coll_recv_direct:
@@ -1053,6 +1093,7 @@ ccl::status ccl_coll_build_send(ccl_sched* sched,
     param.hint_algo = sched->hint_algo;
 
     auto algo = ccl::global_data::get().algorithm_selector->get<ccl_coll_send>(param);
+    sched->selected_algo.send = algo;
 
     switch (algo) {
         case ccl_coll_send_direct:
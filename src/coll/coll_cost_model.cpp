@@ -0,0 +1,320 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+#include "coll/coll.hpp"
+#include "coll/coll_cost_model.hpp"
+#include "coll/coll_param.hpp"
+#include "coll/coll_tuner.hpp"
+#include "coll/selection/selection.hpp"
+#include "coll/selection/tuning.hpp"
+#include "comm/comm.hpp"
+#include "common/global/global.hpp"
+#include "exec/exec.hpp"
+
+namespace {
+
+constexpr size_t ping_pong_small_bytes = 8;
+constexpr size_t ping_pong_large_bytes = 1024 * 1024;
+constexpr size_t ping_pong_warmup_iters = 2;
+constexpr size_t ping_pong_iters = 10;
+
+/* algorithm which the selection tables choose without the cost model */
+int get_regular_algo(ccl_coll_type ctype, const ccl_selector_param& param) {
+    auto& selector = ccl::global_data::get().algorithm_selector;
+    switch (ctype) {
+        case ccl_coll_allreduce: return selector->get<ccl_coll_allreduce>(param);
+        case ccl_coll_alltoall: return selector->get<ccl_coll_alltoall>(param);
+        case ccl_coll_bcast: return selector->get<ccl_coll_bcast>(param);
+        case ccl_coll_broadcast: return selector->get<ccl_coll_broadcast>(param);
+        case ccl_coll_reduce: return selector->get<ccl_coll_reduce>(param);
+        default: return 0;
+    }
+}
+
+double get_usec(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+} // namespace
+
+ccl_coll_cost_model::ccl_coll_cost_model() : enabled(ccl::global_data::env().enable_cost_model) {}
+
+/* one-way time of the message between ranks 0 and 1 of the comm */
+double ccl_coll_cost_model::measure_ping_pong(ccl_comm* comm, size_t bytes) {
+    std::vector<char> buf(bytes);
+    int peer = 1 - comm->rank();
+    ccl_coll_attr attr{};
+    attr.is_internal = 1;
+    ccl_executor* executor = ccl::global_data::get().executor.get();
+
+    auto transfer = [&](bool is_send) {
+        ccl_request* req =
+            (is_send)
+                ? ccl_send_impl(
+                      buf.data(), bytes, ccl::datatype::int8, peer, attr, comm, nullptr, {})
+                : ccl_recv_impl(
+                      buf.data(), bytes, ccl::datatype::int8, peer, attr, comm, nullptr, {});
+        ccl_wait_impl(executor, req);
+    };
+
+    double usec = 0;
+    for (size_t iter = 0; iter < ping_pong_warmup_iters + ping_pong_iters; iter++) {
+        auto start = std::chrono::steady_clock::now();
+        transfer(comm->rank() == 0);
+        transfer(comm->rank() != 0);
+        if (iter >= ping_pong_warmup_iters) {
+            usec += get_usec(start);
+        }
+    }
+    return usec / ping_pong_iters / 2;
+}
+
+double ccl_coll_cost_model::measure_reduction() {
+    size_t count = ping_pong_large_bytes / sizeof(float);
+    std::vector<float> in(count, 1.0f), inout(count, 0.0f);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t iter = 0; iter < ping_pong_iters; iter++) {
+        for (size_t idx = 0; idx < count; idx++) {
+            inout[idx] += in[idx];
+        }
+    }
+    double usec = get_usec(start);
+
+    /* keep the loop from being optimized out */
+    CCL_THROW_IF_NOT(inout[count - 1] == static_cast<float>(ping_pong_iters),
+                     "unexpected reduction result ",
+                     inout[count - 1]);
+
+    return usec / ping_pong_iters / ping_pong_large_bytes;
+}
+
+void ccl_coll_cost_model::init(ccl_comm* comm) {
+    if (!enabled || comm->size() < 2)
+        return;
+
+    /* intra alpha, intra beta, inter alpha, inter beta, gamma, ranks per node, node count */
+    std::vector<double> values(7, 0);
+
+    std::shared_ptr<ccl_comm> link_comms[] = { comm->get_node_comm(), comm->get_r2r_comm() };
+    for (size_t idx = 0; idx < 2; idx++) {
+        ccl_comm* link_comm = link_comms[idx].get();
+        if (link_comm->size() < 2 || link_comm->rank() > 1)
+            continue;
+
+        double small_usec = measure_ping_pong(link_comm, ping_pong_small_bytes);
+        double large_usec = measure_ping_pong(link_comm, ping_pong_large_bytes);
+        values[2 * idx] = small_usec;
+        values[2 * idx + 1] = std::max(large_usec - small_usec, 0.0) /
+                              (ping_pong_large_bytes - ping_pong_small_bytes);
+    }
+    values[4] = measure_reduction();
+    values[5] = link_comms[0]->size();
+    values[6] = link_comms[1]->size();
+
+    ccl_coll_attr attr{};
+    attr.is_internal = 1;
+    auto req = ccl_allreduce_impl(values.data(),
+                                  values.data(),
+                                  values.size(),
+                                  ccl::datatype::float64,
+                                  ccl::reduction::max,
+                                  attr,
+                                  comm,
+                                  nullptr,
+                                  {});
+    ccl_wait_impl(ccl::global_data::get().executor.get(), req);
+
+    comm_size = comm->size();
+    ranks_per_node = static_cast<int>(values[5]);
+    node_count = static_cast<int>(values[6]);
+
+    /* the link which can't be measured is not used by the comm */
+    intra.alpha = values[0];
+    intra.beta = values[1];
+    inter.alpha = values[2];
+    inter.beta = values[3];
+    if (ranks_per_node < 2) {
+        intra = inter;
+    }
+    if (node_count < 2) {
+        inter = intra;
+    }
+    gamma = values[4];
+    is_ready = true;
+
+    if (comm->rank() == 0) {
+        LOG_INFO("cost model: comm size ",
+                 comm_size,
+                 ", nodes ",
+                 node_count,
+                 ", ranks per node ",
+                 ranks_per_node,
+                 ", intra alpha ",
+                 intra.alpha,
+                 " usec, beta ",
+                 intra.beta * 1e3,
+                 " usec/KB, inter alpha ",
+                 inter.alpha,
+                 " usec, beta ",
+                 inter.beta * 1e3,
+                 " usec/KB, gamma ",
+                 gamma * 1e3,
+                 " usec/KB");
+    }
+}
+
+double ccl_coll_cost_model::get_cost(ccl_coll_type ctype, int algo, size_t bytes) const {
+    double p = comm_size;
+    double log_p = std::ceil(std::log2(p));
+    double n = bytes;
+
+    /* steps of flat algorithms wait for the slowest link */
+    double a = inter.alpha;
+    double b = inter.beta;
+    double g = gamma;
+
+    /* reduce_scatter + allgather ring on q ranks with given link */
+    auto ring_allreduce = [g](double q, double n, const link_params& link) {
+        return 2 * (q - 1) * link.alpha + 2 * (q - 1) / q * n * link.beta + (q - 1) / q * n * g;
+    };
+
+    switch (ctype) {
+        case ccl_coll_allreduce:
+            switch (static_cast<ccl_coll_allreduce_algo>(algo)) {
+                case ccl_coll_allreduce_rabenseifner:
+                    return 2 * log_p * a + 2 * (p - 1) / p * n * b + (p - 1) / p * n * g;
+                case ccl_coll_allreduce_nreduce:
+                case ccl_coll_allreduce_ring:
+                case ccl_coll_allreduce_ring_rma: return ring_allreduce(p, n, inter);
+                case ccl_coll_allreduce_double_tree: return 2 * log_p * a + 2 * n * b + n * g;
+                case ccl_coll_allreduce_recursive_doubling: return log_p * (a + n * b + n * g);
+                case ccl_coll_allreduce_2d: {
+                    /* reduce_scatter and allgather inside the node, allreduce between nodes */
+                    double q = std::max(ranks_per_node, 1);
+                    return ring_allreduce(q, n, intra) + ring_allreduce(node_count, n / q, inter);
+                }
+                default: return -1;
+            }
+        case ccl_coll_alltoall:
+            /* bytes per peer */
+            switch (static_cast<ccl_coll_alltoall_algo>(algo)) {
+                case ccl_coll_alltoall_naive:
+                case ccl_coll_alltoall_scatter: return (p - 1) * (a + n * b);
+                case ccl_coll_alltoall_bruck: return log_p * (a + p / 2 * n * b);
+                default: return -1;
+            }
+        case ccl_coll_bcast:
+        case ccl_coll_broadcast:
+            /* the same values in both enums */
+            switch (static_cast<ccl_coll_bcast_algo>(algo)) {
+                case ccl_coll_bcast_ring: return (log_p + p - 1) * a + 2 * (p - 1) / p * n * b;
+                case ccl_coll_bcast_double_tree: return 2 * log_p * a + n * b;
+                case ccl_coll_bcast_naive: return (p - 1) * (a + n * b);
+                default: return -1;
+            }
+        case ccl_coll_reduce:
+            switch (static_cast<ccl_coll_reduce_algo>(algo)) {
+                case ccl_coll_reduce_rabenseifner:
+                    return 2 * log_p * a + 2 * (p - 1) / p * n * b + (p - 1) / p * n * g;
+                case ccl_coll_reduce_ring: return ring_allreduce(p, n, inter);
+                case ccl_coll_reduce_tree: return log_p * (a + n * b + n * g);
+                case ccl_coll_reduce_double_tree: return 2 * log_p * a + n * b + n * g;
+                default: return -1;
+            }
+        default: return -1;
+    }
+}
+
+bool ccl_coll_cost_model::is_modeled(const ccl_coll_param& param) {
+    /*
+       all point-to-point algorithms of allgather(v) and reduce_scatter cost the same,
+       alltoallv counts differ between ranks, so the ranks could choose different algorithms
+    */
+    switch (param.ctype) {
+        case ccl_coll_allreduce:
+        case ccl_coll_alltoall:
+        case ccl_coll_bcast:
+        case ccl_coll_broadcast:
+        case ccl_coll_reduce: break;
+        default: return false;
+    }
+    return param.comm && param.comm->size() > 1 && !param.stream && !param.hint_algo.has_value();
+}
+
+ccl_coll_algo ccl_coll_cost_model::select(const ccl_coll_param& param,
+                                          const ccl_selector_param& selector_param) {
+    ccl_coll_algo algo;
+    if (!enabled || !is_ready || !is_modeled(param))
+        return algo;
+
+    size_t count = ccl_coll_tuner::get_count(param);
+    size_t bytes = count * param.dtype.size();
+    select_key key{ param.ctype, ccl_coll_tuner::get_size_bucket(bytes) };
+
+    std::lock_guard<ccl_spinlock> lock(guard);
+    auto it = algos.find(key);
+    if (it == algos.end()) {
+        int best_algo = 0;
+
+        /* explicit selection takes precedence */
+        std::string var_name = std::string("CCL_") + ccl_coll_type_to_str(param.ctype);
+        std::transform(var_name.begin(), var_name.end(), var_name.begin(), ::toupper);
+        bool is_explicit =
+            getenv(var_name.c_str()) ||
+            ccl::global_data::get().tuning->is_tuned(param.ctype, param.comm->size());
+
+        if (!is_explicit) {
+            /* top-level selector param may have no count, e.g. for alltoall */
+            ccl_selector_param candidate_param(selector_param);
+            candidate_param.count = count;
+
+            /* the regular choice is kept if it has no model or nothing is strictly cheaper */
+            double best_cost =
+                get_cost(param.ctype, get_regular_algo(param.ctype, candidate_param), bytes);
+            if (best_cost >= 0) {
+                for (int candidate :
+                     ccl_coll_tuner::get_candidates(param.ctype, candidate_param)) {
+                    double cost = get_cost(param.ctype, candidate, bytes);
+                    if (cost >= 0 && cost < best_cost) {
+                        best_cost = cost;
+                        best_algo = candidate;
+                    }
+                }
+            }
+        }
+
+        it = algos.emplace(key, best_algo).first;
+
+        LOG_DEBUG("cost model: coll ",
+                  ccl_coll_type_to_str(param.ctype),
+                  ", size bucket ",
+                  key.second,
+                  ", selected ",
+                  (best_algo) ? ccl_coll_tuner::get_algo_name(param.ctype, best_algo)
+                              : "regular selection");
+    }
+
+    algo.value = it->second;
+    return algo;
+}
@@ -0,0 +1,96 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include <map>
+#include <utility>
+
+#include "coll/algorithms/algorithm_utils.hpp"
+#include "common/utils/spinlock.hpp"
+
+struct ccl_coll_param;
+struct ccl_selector_param;
+class ccl_comm;
+
+/*
+   algorithm selection by analytic cost (CCL_COST_MODEL=1)
+
+   on creation of the communicator ranks 0 and 1 of the node and rank-to-rank subcommunicators
+   measure latency (alpha) and time per byte (beta) of intra-node and inter-node links
+   with ping-pongs, every rank measures time per byte of the local reduction (gamma),
+   then the ranks agree on the slowest values with a small allreduce.
+
+   for every collective and power of 2 message size bucket the first call evaluates
+   the cost of the algorithms accepted by the selector, the cheapest one is cached
+   and passed to the sched as hint_algo. the regular choice is replaced only by a strictly
+   cheaper algorithm and is kept if it has no model (e.g. direct).
+   flat algorithms are bounded by the slowest link of the communicator,
+   2d allreduce is modeled per dimension.
+
+   collectives set by CCL_<COLL> or by the tuning, calls with explicit hint
+   and calls chosen by CCL_AUTOTUNE use the regular selection
+*/
+class ccl_coll_cost_model {
+public:
+    ccl_coll_cost_model();
+    ccl_coll_cost_model(const ccl_coll_cost_model& other) = delete;
+    ccl_coll_cost_model& operator=(const ccl_coll_cost_model& other) = delete;
+
+    bool is_enabled() const {
+        return enabled;
+    }
+
+    /* called on creation of the communicator, runs collectives on all its ranks */
+    void init(ccl_comm* comm);
+
+    /*
+       called for the user collective before its sched is created,
+       returns empty value if the regular selection should be used
+    */
+    ccl_coll_algo select(const ccl_coll_param& param, const ccl_selector_param& selector_param);
+
+    /* modeled time in usec, negative if the algorithm has no model */
+    double get_cost(ccl_coll_type ctype, int algo, size_t bytes) const;
+
+private:
+    struct link_params {
+        double alpha = 0; // usec
+        double beta = 0; // usec per byte
+    };
+
+    static bool is_modeled(const ccl_coll_param& param);
+    static double measure_ping_pong(ccl_comm* comm, size_t bytes);
+    static double measure_reduction();
+
+    /* cached on creation */
+    bool enabled = false;
+
+    /* set once the links are measured */
+    bool is_ready = false;
+
+    int comm_size = 0;
+    int node_count = 0;
+    int ranks_per_node = 0;
+    link_params intra;
+    link_params inter;
+    double gamma = 0; // usec per byte
+
+    /* coll type, size bucket */
+    using select_key = std::pair<ccl_coll_type, size_t>;
+
+    ccl_spinlock guard;
+    std::map<select_key, int> algos;
+};
@@ -464,7 +464,9 @@ void ccl_coll_param::validate() const {
 
             if (ctype == ccl_coll_allreduce || ctype == ccl_coll_reduce_scatter ||
                 ctype == ccl_coll_reduce) {
-                if (reduction == ccl::reduction::avg) {
+                // host algorithms handle avg on the final reduction step,
+                // device entries do not support it yet
+                if (reduction == ccl::reduction::avg && stream && stream->is_sycl_device_stream()) {
                     // CCL_THROW_IF_NOT produce and error message which CI interprets as a failed test,
                     // however in some cases we want to throw exception, catch it and skip the average test.
                     CCL_THROW("average operation is not supported for the scheduler path");
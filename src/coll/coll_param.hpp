@@ -83,6 +83,9 @@ struct ccl_coll_attr {
     /* change how user-supplied buffers have to be interpreted */
     int is_vector_buf = 0;
 
+    /* issued by the library itself, e.g. agreement of autotuner, not reported in coll stats */
+    int is_internal = 0;
+
 #ifdef CCL_ENABLE_SYCL
     int is_sycl_buf = 0;
 #endif // CCL_ENABLE_SYCL
@@ -0,0 +1,225 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+
+#include "coll/coll_param.hpp"
+#include "coll/coll_stats.hpp"
+#include "coll/selection/selection.hpp"
+#include "common/global/global.hpp"
+
+size_t ccl_latency_histogram::get_bucket_idx(uint64_t value) {
+    if (value < sub_bucket_count)
+        return value;
+
+    value = std::min(value, (uint64_t(1) << max_value_bits) - 1);
+    size_t exp = 63 - __builtin_clzll(value);
+    size_t sub_idx = (value >> (exp - sub_bucket_bits)) - sub_bucket_count;
+    return (exp - sub_bucket_bits + 1) * sub_bucket_count + sub_idx;
+}
+
+uint64_t ccl_latency_histogram::get_bucket_max_value(size_t bucket_idx) {
+    if (bucket_idx < sub_bucket_count)
+        return bucket_idx;
+
+    size_t exp = bucket_idx / sub_bucket_count + sub_bucket_bits - 1;
+    size_t sub_idx = bucket_idx % sub_bucket_count;
+    size_t shift = exp - sub_bucket_bits;
+    return ((sub_bucket_count + sub_idx + 1) << shift) - 1;
+}
+
+void ccl_latency_histogram::record(uint64_t value) {
+    counts[get_bucket_idx(value)]++;
+    count++;
+    sum += value;
+    min_value = std::min(min_value, value);
+    max_value = std::max(max_value, value);
+}
+
+void ccl_latency_histogram::reset() {
+    counts.fill(0);
+    count = 0;
+    sum = 0;
+    min_value = UINT64_MAX;
+    max_value = 0;
+}
+
+uint64_t ccl_latency_histogram::get_percentile(double percentile) const {
+    if (!count)
+        return 0;
+
+    percentile = std::min(std::max(percentile, 0.0), 100.0);
+    uint64_t target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * count));
+    target = std::max(target, uint64_t(1));
+
+    uint64_t accumulated = 0;
+    for (size_t idx = 0; idx < bucket_count; idx++) {
+        accumulated += counts[idx];
+        if (accumulated >= target) {
+            /* bucket bound may go beyond the real values */
+            return std::min(std::max(get_bucket_max_value(idx), get_min()), max_value);
+        }
+    }
+    return max_value;
+}
+
+size_t ccl_coll_stats::get_bytes(const ccl_coll_param& param) {
+    size_t send_count = std::accumulate(param.send_counts.begin(), param.send_counts.end(), 0ul);
+    size_t recv_count = std::accumulate(param.recv_counts.begin(), param.recv_counts.end(), 0ul);
+    return std::max(send_count, recv_count) * param.dtype.size();
+}
+
+size_t ccl_coll_stats::get_size_bucket(size_t bytes) {
+    /* 0 - for zero bytes, N - for [2 ^ (N - 1), 2 ^ N) */
+    size_t bucket = bytes ? (64 - __builtin_clzll(bytes)) : 0;
+    return std::min(bucket, size_bucket_count - 1);
+}
+
+ccl_coll_stats::ccl_coll_stats() : dump_enabled(ccl::global_data::env().coll_stats_dump) {}
+
+ccl_coll_stats::~ccl_coll_stats() {
+    stats_cell* cells = table.load(std::memory_order_acquire);
+    if (!cells)
+        return;
+
+    for (size_t idx = 0; idx < table_size; idx++) {
+        delete cells[idx].load(std::memory_order_relaxed);
+    }
+    delete[] cells;
+}
+
+ccl_coll_stats::stats_cell* ccl_coll_stats::get_table() {
+    stats_cell* cells = table.load(std::memory_order_acquire);
+    if (cells)
+        return cells;
+
+    stats_cell* new_cells = new stats_cell[table_size]();
+    if (table.compare_exchange_strong(cells, new_cells, std::memory_order_acq_rel)) {
+        return new_cells;
+    }
+    /* another thread has allocated the table */
+    delete[] new_cells;
+    return cells;
+}
+
+void ccl_coll_stats::record(const ccl_coll_param& param,
+                            ccl_coll_algo algo,
+                            clock_t::time_point start_time,
+                            clock_t::time_point end_time) {
+    CCL_ASSERT(param.ctype < ccl_coll_last_value, "unexpected coll type ", param.ctype);
+    CCL_ASSERT(static_cast<size_t>(algo.value) < max_algo_count, "unexpected algo ", algo.value);
+
+    size_t bytes = get_bytes(param);
+    auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
+    size_t idx = (param.ctype * max_algo_count + algo.value) * size_bucket_count +
+                 get_size_bucket(bytes);
+
+    stats_cell& cell = get_table()[idx];
+    stats_value* value = cell.load(std::memory_order_acquire);
+    if (!value) {
+        std::unique_ptr<stats_value> new_value(new stats_value());
+        if (cell.compare_exchange_strong(value, new_value.get(), std::memory_order_acq_rel)) {
+            value = new_value.release();
+        }
+    }
+
+    std::lock_guard<ccl_spinlock> lock(value->guard);
+    value->latency.record(static_cast<uint64_t>(latency.count()));
+    value->total_bytes += bytes;
+}
+
+void ccl_coll_stats::reset() {
+    stats_cell* cells = table.load(std::memory_order_acquire);
+    if (!cells)
+        return;
+
+    for (size_t idx = 0; idx < table_size; idx++) {
+        stats_value* value = cells[idx].load(std::memory_order_acquire);
+        if (value) {
+            std::lock_guard<ccl_spinlock> lock(value->guard);
+            value->latency.reset();
+            value->total_bytes = 0;
+        }
+    }
+}
+
+std::vector<ccl::coll_stats> ccl_coll_stats::get() const {
+    std::vector<ccl::coll_stats> result;
+    stats_cell* cells = table.load(std::memory_order_acquire);
+    if (!cells)
+        return result;
+
+    for (size_t idx = 0; idx < table_size; idx++) {
+        stats_value* cell_value = cells[idx].load(std::memory_order_acquire);
+        if (!cell_value)
+            continue;
+
+        auto ctype = static_cast<ccl_coll_type>(idx / (max_algo_count * size_bucket_count));
+        ccl_coll_algo algo;
+        algo.value = static_cast<int>((idx / size_bucket_count) % max_algo_count);
+        size_t size_bucket = idx % size_bucket_count;
+
+        std::lock_guard<ccl_spinlock> lock(cell_value->guard);
+        const auto& latency = cell_value->latency;
+        if (!latency.get_count())
+            continue;
+
+        ccl::coll_stats value{};
+        value.coll_name = ccl_coll_type_to_str(ctype);
+        value.algo_name = ccl_coll_algorithm_name(ctype, algo);
+        value.min_bytes = size_bucket ? (size_t(1) << (size_bucket - 1)) : 0;
+        value.max_bytes = size_bucket ? (size_t(1) << size_bucket) : 1;
+        value.call_count = latency.get_count();
+        value.total_bytes = cell_value->total_bytes;
+        value.min_usec = latency.get_min() / 1000.0;
+        value.max_usec = latency.get_max() / 1000.0;
+        value.avg_usec = latency.get_sum() / 1000.0 / std::max(latency.get_count(), uint64_t(1));
+        value.p50_usec = latency.get_percentile(50) / 1000.0;
+        value.p90_usec = latency.get_percentile(90) / 1000.0;
+        value.p99_usec = latency.get_percentile(99) / 1000.0;
+        result.push_back(value);
+    }
+
+    std::sort(result.begin(), result.end(), [](const ccl::coll_stats& a, const ccl::coll_stats& b) {
+        int coll_cmp = strcmp(a.coll_name.c_str(), b.coll_name.c_str());
+        if (coll_cmp)
+            return coll_cmp < 0;
+        int algo_cmp = strcmp(a.algo_name.c_str(), b.algo_name.c_str());
+        if (algo_cmp)
+            return algo_cmp < 0;
+        return a.min_bytes < b.min_bytes;
+    });
+    return result;
+}
+
+std::string ccl_coll_stats::to_string() const {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    for (const auto& value : get()) {
+        ss << "\n  " << value.coll_name.c_str() << " " << value.algo_name.c_str() << " ["
+           << value.min_bytes << ", " << value.max_bytes << ") bytes: calls " << value.call_count
+           << ", total bytes " << value.total_bytes << ", usec: min " << value.min_usec
+           << ", avg " << value.avg_usec << ", p50 " << value.p50_usec << ", p90 "
+           << value.p90_usec << ", p99 " << value.p99_usec << ", max " << value.max_usec;
+    }
+    return ss.str();
+}
@@ -0,0 +1,127 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "coll/algorithms/algorithm_utils.hpp"
+#include "common/utils/spinlock.hpp"
+#include "oneapi/ccl/types.hpp"
+
+struct ccl_coll_param;
+
+/*
+   HDR-style log-linear histogram of latencies in nanoseconds:
+   values are grouped by power of 2 and each group is split into sub-buckets,
+   so the relative error of any reported value is below 1 / sub_bucket_count
+*/
+class ccl_latency_histogram {
+public:
+    static constexpr size_t sub_bucket_bits = 4;
+    static constexpr size_t sub_bucket_count = 1 << sub_bucket_bits;
+    /* ~18 minutes, larger values are clamped */
+    static constexpr size_t max_value_bits = 40;
+    static constexpr size_t bucket_count =
+        (max_value_bits - sub_bucket_bits + 1) * sub_bucket_count;
+
+    void record(uint64_t value);
+    void reset();
+
+    uint64_t get_count() const {
+        return count;
+    }
+    uint64_t get_min() const {
+        return count ? min_value : 0;
+    }
+    uint64_t get_max() const {
+        return max_value;
+    }
+    uint64_t get_sum() const {
+        return sum;
+    }
+
+    /* returns the highest value equivalent to the given percentile in range [0, 100] */
+    uint64_t get_percentile(double percentile) const;
+
+private:
+    static size_t get_bucket_idx(uint64_t value);
+    static uint64_t get_bucket_max_value(size_t bucket_idx);
+
+    std::array<uint64_t, bucket_count> counts{};
+    uint64_t count = 0;
+    uint64_t min_value = UINT64_MAX;
+    uint64_t max_value = 0;
+    uint64_t sum = 0;
+};
+
+/*
+   always-on latency stats of the communicator,
+   collectives are grouped by type, algorithm and power of 2 message size bucket
+   in a flat table which is allocated on the first record
+*/
+class ccl_coll_stats {
+public:
+    using clock_t = std::chrono::steady_clock;
+
+    ccl_coll_stats();
+    ~ccl_coll_stats();
+    ccl_coll_stats(const ccl_coll_stats& other) = delete;
+    ccl_coll_stats& operator=(const ccl_coll_stats& other) = delete;
+
+    void record(const ccl_coll_param& param,
+                ccl_coll_algo algo,
+                clock_t::time_point start_time,
+                clock_t::time_point end_time);
+    void reset();
+
+    std::vector<ccl::coll_stats> get() const;
+    std::string to_string() const;
+
+    bool is_dump_enabled() const {
+        return dump_enabled;
+    }
+
+    static size_t get_bytes(const ccl_coll_param& param);
+
+private:
+    struct stats_value {
+        ccl_spinlock guard;
+        ccl_latency_histogram latency;
+        size_t total_bytes = 0;
+    };
+
+    /* algorithm values of any collective are below, 0 - algorithm is not known */
+    static constexpr size_t max_algo_count = 16;
+    /* the last bucket also takes larger sizes */
+    static constexpr size_t size_bucket_count = 41;
+    static constexpr size_t table_size = ccl_coll_last_value * max_algo_count * size_bucket_count;
+
+    using stats_cell = std::atomic<stats_value*>;
+
+    static size_t get_size_bucket(size_t bytes);
+    stats_cell* get_table();
+
+    /* cached on creation, the stats are dumped when the owner comm is destroyed */
+    bool dump_enabled = false;
+
+    /* indexed by coll type, algo and size bucket, values are created on the first record */
+    std::atomic<stats_cell*> table{ nullptr };
+};
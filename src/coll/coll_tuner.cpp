@@ -0,0 +1,351 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+
+#include "coll/coll.hpp"
+#include "coll/coll_param.hpp"
+#include "coll/coll_tuner.hpp"
+#include "coll/group/group.hpp"
+#include "coll/selection/selection.hpp"
+#include "comm/comm.hpp"
+#include "common/global/global.hpp"
+#include "exec/exec.hpp"
+
+template <typename algo_group_type>
+static std::vector<int> get_typed_candidates(const ccl_selector_param& param) {
+    static const ccl_selection_table_t<algo_group_type> empty_table;
+
+    std::vector<int> candidates;
+    for (const auto& name : ccl_algorithm_selector_helper<algo_group_type>::algo_names) {
+        if (ccl_algorithm_selector_helper<algo_group_type>::can_use(
+                name.first, param, empty_table)) {
+            candidates.push_back(static_cast<int>(name.first));
+        }
+    }
+    return candidates;
+}
+
+std::vector<int> ccl_coll_tuner::get_candidates(ccl_coll_type ctype,
+                                                const ccl_selector_param& param) {
+    switch (ctype) {
+        case ccl_coll_allgather: return get_typed_candidates<ccl_coll_allgather_algo>(param);
+        case ccl_coll_allgatherv: return get_typed_candidates<ccl_coll_allgatherv_algo>(param);
+        case ccl_coll_allreduce: return get_typed_candidates<ccl_coll_allreduce_algo>(param);
+        case ccl_coll_alltoall: return get_typed_candidates<ccl_coll_alltoall_algo>(param);
+        case ccl_coll_alltoallv: return get_typed_candidates<ccl_coll_alltoallv_algo>(param);
+        case ccl_coll_barrier: return get_typed_candidates<ccl_coll_barrier_algo>(param);
+        case ccl_coll_bcast: return get_typed_candidates<ccl_coll_bcast_algo>(param);
+        case ccl_coll_broadcast: return get_typed_candidates<ccl_coll_broadcast_algo>(param);
+        case ccl_coll_reduce: return get_typed_candidates<ccl_coll_reduce_algo>(param);
+        case ccl_coll_reduce_scatter:
+            return get_typed_candidates<ccl_coll_reduce_scatter_algo>(param);
+        default: return {};
+    }
+}
+
+std::string ccl_coll_tuner::get_algo_name(ccl_coll_type ctype, int algo) {
+    switch (ctype) {
+        case ccl_coll_allgather:
+            return ccl_coll_algorithm_to_str(static_cast<ccl_coll_allgather_algo>(algo));
+        case ccl_coll_allgatherv:
+            return ccl_coll_algorithm_to_str(static_cast<ccl_coll_allgatherv_algo>(algo));
+        case ccl_coll_allreduce:
+            return ccl_coll_algorithm_to_str(static_cast<ccl_coll_allreduce_algo>(algo));
+        case ccl_coll_alltoall:
+            return ccl_coll_algorithm_to_str(static_cast<ccl_coll_alltoall_algo>(algo));
+        case ccl_coll_alltoallv:
+            return ccl_coll_algorithm_to_str(static_cast<ccl_coll_alltoallv_algo>(algo));
+        case ccl_coll_barrier:
+            return ccl_coll_algorithm_to_str(static_cast<ccl_coll_barrier_algo>(algo));
+        case ccl_coll_bcast:
+            return ccl_coll_algorithm_to_str(static_cast<ccl_coll_bcast_algo>(algo));
+        case ccl_coll_broadcast:
+            return ccl_coll_algorithm_to_str(static_cast<ccl_coll_broadcast_algo>(algo));
+        case ccl_coll_reduce:
+            return ccl_coll_algorithm_to_str(static_cast<ccl_coll_reduce_algo>(algo));
+        case ccl_coll_reduce_scatter:
+            return ccl_coll_algorithm_to_str(static_cast<ccl_coll_reduce_scatter_algo>(algo));
+        default: return std::to_string(algo);
+    }
+}
+
+ccl_coll_tuner::ccl_coll_tuner()
+        : enabled(ccl::global_data::env().enable_autotune),
+          iters(ccl::global_data::env().autotune_iters) {}
+
+bool ccl_coll_tuner::is_tunable(const ccl_coll_param& param) {
+    /*
+       alltoallv is not tuned: counts differ between ranks, so they would land in different
+       size buckets and run different trials and agreement allreduces within the same call
+    */
+    switch (param.ctype) {
+        case ccl_coll_allgather:
+        case ccl_coll_allgatherv:
+        case ccl_coll_allreduce:
+        case ccl_coll_alltoall:
+        case ccl_coll_barrier:
+        case ccl_coll_bcast:
+        case ccl_coll_broadcast:
+        case ccl_coll_reduce:
+        case ccl_coll_reduce_scatter: break;
+        default: return false;
+    }
+
+    /* group and fused ops are started or completed out of the call order */
+    return param.comm && param.comm->size() > 1 && !param.stream && !param.hint_algo.has_value() &&
+           !group_impl::is_group_active && !ccl::global_data::env().enable_fusion;
+}
+
+/* the same count as the selection of the parts in parallelizer uses */
+size_t ccl_coll_tuner::get_count(const ccl_coll_param& param) {
+    size_t count = 0;
+    switch (param.ctype) {
+        case ccl_coll_barrier: break;
+        case ccl_coll_allgatherv:
+            count = std::accumulate(param.recv_counts.begin(),
+                                    param.recv_counts.end(),
+                                    ccl::utils::initial_count_value);
+            count /= param.comm->size();
+            break;
+        case ccl_coll_reduce_scatter: count = param.get_recv_count(); break;
+        default: count = param.get_send_count(); break;
+    }
+    return count;
+}
+
+size_t ccl_coll_tuner::get_size_bucket(size_t bytes) {
+    /* 0 - for zero bytes, N - for [2 ^ (N - 1), 2 ^ N) */
+    return bytes ? (64 - __builtin_clzll(bytes)) : 0;
+}
+
+ccl_coll_algo ccl_coll_tuner::select(const ccl_coll_param& param,
+                                     const ccl_selector_param& selector_param,
+                                     bool& is_trial) {
+    ccl_coll_algo algo;
+    is_trial = false;
+
+    if (!enabled || is_syncing || !is_tunable(param))
+        return algo;
+
+    size_t count = get_count(param);
+    tune_key key{ param.ctype, get_size_bucket(count * param.dtype.size()) };
+
+    std::unique_lock<ccl_spinlock> lock(guard);
+    auto& state = states[key];
+
+    if (state.candidates.empty() && !state.is_committed) {
+        /* top-level selector param may have no count, e.g. for alltoall */
+        ccl_selector_param candidate_param(selector_param);
+        if (param.ctype != ccl_coll_allgatherv) {
+            candidate_param.count = count;
+        }
+        state.candidates = get_candidates(param.ctype, candidate_param);
+        state.sum_nsec.assign(state.candidates.size(), 0);
+        state.counts.assign(state.candidates.size(), 0);
+        if (state.candidates.size() < 2) {
+            /* nothing to choose from */
+            state.is_committed = true;
+        }
+    }
+
+    if (!state.is_committed) {
+        size_t candidate_count = state.candidates.size();
+        if (state.issued_count < iters * candidate_count) {
+            /* interleave the candidates so they see the same system noise */
+            algo.value = state.candidates[state.issued_count % candidate_count];
+            state.issued_count++;
+            is_trial = true;
+            return algo;
+        }
+
+        lock.unlock();
+        commit(key, state, param.comm);
+        lock.lock();
+    }
+
+    algo.value = state.algo;
+    return algo;
+}
+
+void ccl_coll_tuner::record(const ccl_coll_param& param, uint64_t nsec) {
+    tune_key key{ param.ctype, get_size_bucket(get_count(param) * param.dtype.size()) };
+
+    std::lock_guard<ccl_spinlock> lock(guard);
+    auto it = states.find(key);
+    if (it == states.end() || it->second.is_committed)
+        return;
+
+    auto& state = it->second;
+    auto candidate_it =
+        std::find(state.candidates.begin(), state.candidates.end(), param.hint_algo.value);
+    if (candidate_it == state.candidates.end())
+        return;
+
+    size_t idx = std::distance(state.candidates.begin(), candidate_it);
+    state.sum_nsec[idx] += nsec;
+    state.counts[idx]++;
+    state.completed_count++;
+}
+
+void ccl_coll_tuner::commit(const tune_key& key, tune_state& state, ccl_comm* comm) {
+    /* trials may still be in flight if the user has not waited them */
+    while (true) {
+        {
+            std::lock_guard<ccl_spinlock> lock(guard);
+            if (state.is_committed || state.completed_count >= state.issued_count)
+                break;
+        }
+        ccl::global_data::get().executor->do_work();
+    }
+
+    std::vector<double> avg_usec;
+    {
+        std::lock_guard<ccl_spinlock> lock(guard);
+        if (state.is_committed)
+            return;
+        for (size_t idx = 0; idx < state.candidates.size(); idx++) {
+            avg_usec.push_back(state.counts[idx]
+                                   ? state.sum_nsec[idx] / 1000.0 / state.counts[idx]
+                                   : std::numeric_limits<double>::max());
+        }
+    }
+
+    /* the slowest rank defines the time of the collective and all ranks must agree */
+    is_syncing = true;
+    ccl_coll_attr attr{};
+    attr.is_internal = 1;
+    auto req = ccl_allreduce_impl(avg_usec.data(),
+                                  avg_usec.data(),
+                                  avg_usec.size(),
+                                  ccl::datatype::float64,
+                                  ccl::reduction::max,
+                                  attr,
+                                  comm,
+                                  nullptr,
+                                  {});
+    ccl_wait_impl(ccl::global_data::get().executor.get(), req);
+    is_syncing = false;
+
+    size_t best_idx = std::distance(avg_usec.begin(),
+                                    std::min_element(avg_usec.begin(), avg_usec.end()));
+
+    std::lock_guard<ccl_spinlock> lock(guard);
+    state.algo = state.candidates[best_idx];
+    state.is_committed = true;
+
+    if (comm->rank() == 0) {
+        std::stringstream ss;
+        for (size_t idx = 0; idx < state.candidates.size(); idx++) {
+            ss << " " << get_algo_name(key.first, state.candidates[idx]) << ":" << std::fixed
+               << std::setprecision(2) << avg_usec[idx];
+        }
+        LOG_INFO("autotune: coll ",
+                 ccl_coll_type_to_str(key.first),
+                 ", size bucket ",
+                 key.second,
+                 ", comm size ",
+                 comm->size(),
+                 ", avg usec",
+                 ss.str(),
+                 ", selected ",
+                 get_algo_name(key.first, state.algo));
+    }
+}
+
+std::string ccl_coll_tuner::to_string() const {
+    std::stringstream ss;
+    std::lock_guard<ccl_spinlock> lock(guard);
+
+    auto it = states.begin();
+    while (it != states.end()) {
+        ccl_coll_type ctype = it->first.first;
+        std::string ctype_str = ccl_coll_type_to_str(ctype);
+        std::transform(ctype_str.begin(), ctype_str.end(), ctype_str.begin(), ::toupper);
+
+        /* merge adjacent buckets with the same algorithm into one range */
+        std::vector<std::string> ranges;
+        int range_algo = 0;
+        size_t range_left = 0, range_right = 0;
+        auto add_range = [&]() {
+            if (range_algo) {
+                ranges.push_back(get_algo_name(ctype, range_algo) + ":" +
+                                 std::to_string(range_left) + "-" + std::to_string(range_right));
+            }
+        };
+
+        for (; it != states.end() && it->first.first == ctype; ++it) {
+            if (!it->second.is_committed || !it->second.algo)
+                continue;
+
+            size_t bucket = it->first.second;
+            size_t left = bucket ? (1ul << (bucket - 1)) : 0;
+            size_t right = bucket ? ((bucket < 64) ? (1ul << bucket) - 1 : SIZE_MAX) : 0;
+
+            if (range_algo == it->second.algo && range_right + 1 == left) {
+                range_right = right;
+                continue;
+            }
+            add_range();
+            range_algo = it->second.algo;
+            range_left = left;
+            range_right = right;
+        }
+        add_range();
+
+        if (!ranges.empty()) {
+            ss << "CCL_" << ctype_str << "=";
+            for (size_t idx = 0; idx < ranges.size(); idx++) {
+                ss << (idx ? ";" : "") << ranges[idx];
+            }
+            ss << "\n";
+        }
+    }
+    return ss.str();
+}
+
+void ccl_coll_tuner::dump(int comm_rank, int comm_size) const {
+    if (!enabled || comm_rank != 0)
+        return;
+
+    std::string str = to_string();
+    if (str.empty())
+        return;
+
+    LOG_INFO("autotune: selected algorithms for comm size ", comm_size, ":\n", str);
+
+    const std::string& file_name = ccl::global_data::env().autotune_file;
+    if (file_name.empty())
+        return;
+
+    std::ofstream out(file_name, std::ios::app);
+    if (!out) {
+        LOG_WARN("autotune: failed to open file ", file_name);
+        return;
+    }
+
+    out << "# comm size " << comm_size << "\n";
+    std::stringstream ss(str);
+    std::string line;
+    while (std::getline(ss, line)) {
+        out << "export " << line << "\n";
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "coll/algorithms/algorithm_utils.hpp"
+#include "common/utils/spinlock.hpp"
+
+struct ccl_coll_param;
+struct ccl_selector_param;
+class ccl_comm;
+
+/*
+   online algorithm selection of the communicator (CCL_AUTOTUNE=1)
+
+   for every collective and power of 2 message size bucket the first calls rotate through
+   all algorithms accepted by the selector, CCL_AUTOTUNE_ITERS calls per algorithm.
+   then the ranks agree on the slowest-rank average time of every algorithm
+   with a small allreduce and the fastest one is used for all following calls.
+   the chosen algorithm is passed to the sched as hint_algo,
+   calls with explicit hint from the user are not tuned
+*/
+class ccl_coll_tuner {
+public:
+    ccl_coll_tuner();
+    ccl_coll_tuner(const ccl_coll_tuner& other) = delete;
+    ccl_coll_tuner& operator=(const ccl_coll_tuner& other) = delete;
+
+    bool is_enabled() const {
+        return enabled;
+    }
+
+    /*
+       called for the user collective before its sched is created,
+       returns empty value if the regular selection should be used,
+       is_trial is set if the call is measured and must not be cached
+    */
+    ccl_coll_algo select(const ccl_coll_param& param,
+                         const ccl_selector_param& selector_param,
+                         bool& is_trial);
+
+    /* called on completion of the top-level sched */
+    void record(const ccl_coll_param& param, uint64_t nsec);
+
+    /* chosen algorithms in format of CCL_<COLL> variables, one variable per line */
+    std::string to_string() const;
+
+    /* prints the chosen algorithms and appends them to CCL_AUTOTUNE_FILE */
+    void dump(int comm_rank, int comm_size) const;
+
+    /* algorithms of the collective which the selector accepts for the param */
+    static std::vector<int> get_candidates(ccl_coll_type ctype, const ccl_selector_param& param);
+    static std::string get_algo_name(ccl_coll_type ctype, int algo);
+
+    /* message size of the collective as the selection computes it, in elements */
+    static size_t get_count(const ccl_coll_param& param);
+    static size_t get_size_bucket(size_t bytes);
+
+private:
+    struct tune_state {
+        std::vector<int> candidates;
+        std::vector<uint64_t> sum_nsec;
+        std::vector<size_t> counts;
+        size_t issued_count = 0;
+        size_t completed_count = 0;
+        bool is_committed = false;
+        /* 0 means the regular selection */
+        int algo = 0;
+    };
+
+    /* coll type, size bucket */
+    using tune_key = std::pair<ccl_coll_type, size_t>;
+
+    static bool is_tunable(const ccl_coll_param& param);
+
+    void commit(const tune_key& key, tune_state& state, ccl_comm* comm);
+
+    /* cached on creation */
+    bool enabled = false;
+    size_t iters = 0;
+
+    /* set while the ranks agree on the timings, the agreement collective is not tuned */
+    std::atomic<bool> is_syncing{ false };
+
+    mutable ccl_spinlock guard;
+    std::map<tune_key, tune_state> states;
+};
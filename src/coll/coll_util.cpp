@@ -25,6 +25,17 @@
 namespace ccl {
 
 void add_coll_entry(ccl_sched* sched, const ccl_coll_param& param) {
+    /* parts of the user collective follow the algorithm hint of the user collective */
+    const ccl_sched* master_sched = sched->parent_sched ? sched->parent_sched : sched;
+    const ccl_coll_param& master_param = master_sched->coll_param;
+    if (!param.hint_algo.has_value() && master_param.hint_algo.has_value() &&
+        param.ctype == master_param.ctype && param.comm == master_param.comm) {
+        ccl_coll_param hinted_param(param);
+        hinted_param.hint_algo = master_param.hint_algo;
+        add_coll_entry(sched, hinted_param);
+        return;
+    }
+
     ccl_selector_param selector_param;
 
     if (param.ctype == ccl_coll_send || param.ctype == ccl_coll_recv) {
@@ -24,6 +24,28 @@
 #include "sched/entry/ze/ze_primitives.hpp"
 #endif // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
 
+const char* ccl_coll_algorithm_name(ccl_coll_type ctype, ccl_coll_algo algo) {
+    if (!algo.has_value()) {
+        return "unknown";
+    }
+
+    switch (ctype) {
+        case ccl_coll_allgather: return ccl_coll_algorithm_name(algo.allgather);
+        case ccl_coll_allgatherv: return ccl_coll_algorithm_name(algo.allgatherv);
+        case ccl_coll_allreduce: return ccl_coll_algorithm_name(algo.allreduce);
+        case ccl_coll_alltoall: return ccl_coll_algorithm_name(algo.alltoall);
+        case ccl_coll_alltoallv: return ccl_coll_algorithm_name(algo.alltoallv);
+        case ccl_coll_barrier: return ccl_coll_algorithm_name(algo.barrier);
+        case ccl_coll_bcast: return ccl_coll_algorithm_name(algo.bcast);
+        case ccl_coll_broadcast: return ccl_coll_algorithm_name(algo.broadcast);
+        case ccl_coll_recv: return ccl_coll_algorithm_name(algo.recv);
+        case ccl_coll_reduce: return ccl_coll_algorithm_name(algo.reduce);
+        case ccl_coll_reduce_scatter: return ccl_coll_algorithm_name(algo.reduce_scatter);
+        case ccl_coll_send: return ccl_coll_algorithm_name(algo.send);
+        default: return "unknown";
+    }
+}
+
 std::string to_string(const ccl_selector_param& param) {
     std::stringstream ss;
 
@@ -480,8 +502,8 @@ bool ccl_can_use_topo_algo(const ccl_selector_param& param) {
 #endif // CCL_ENABLE_SYCL
 
         RETURN_FALSE_IF(
-            group_impl::is_group_active && ccl::global_data::env().atl_transport == ccl_atl_ofi,
-            "ofi transport is not supported for group API");
+            group_impl::is_group_active && ccl::global_data::env().atl_transport != ccl_atl_mpi,
+            "ofi and shm transports are not supported for group API");
     }
 
     return true;
@@ -25,6 +25,9 @@ bool ccl_can_use_topo_algo(const ccl_selector_param& param);
 
 bool ccl_can_use_datatype(ccl_coll_algo algo, const ccl_selector_param& param);
 
+/* name with static storage duration, "unknown" if algo is not set */
+const char* ccl_coll_algorithm_name(ccl_coll_type ctype, ccl_coll_algo algo);
+
 // utils
 // pt2pt: send or recv is considered like a unique "collective"
 // operation, that's why send or recv has own selector, int this case
@@ -99,9 +99,13 @@ struct ccl_algorithm_selector_base {
     ccl_selection_table_t<algo_group_type> main_table;
     ccl_selection_table_t<algo_group_type> fallback_table;
     ccl_selection_table_t<algo_group_type> scaleout_table;
+    /* main tables with the tuning applied, key is comm size, 0 for any comm size */
+    std::map<size_t, ccl_selection_table_t<algo_group_type>> tuned_tables;
     void init();
     void print() const;
     algo_group_type get(const ccl_selector_param& param) const;
+    const ccl_selection_table_t<algo_group_type>& get_main_table(
+        const ccl_selector_param& param) const;
     static void insert(ccl_selection_table_t<algo_group_type>& table,
                        size_t left,
                        size_t right,
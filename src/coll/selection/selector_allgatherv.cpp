@@ -34,14 +34,14 @@ ccl_algorithm_selector<ccl_coll_allgatherv>::ccl_algorithm_selector() {
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
     insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_allgatherv_topo);
 #else // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
-    if (ccl::global_data::env().atl_transport == ccl_atl_ofi) {
+    if (ccl::global_data::env().atl_transport != ccl_atl_mpi) {
         insert(main_table, 0, CCL_ALLGATHERV_SHORT_MSG_SIZE, ccl_coll_allgatherv_naive);
         insert(main_table,
                CCL_ALLGATHERV_SHORT_MSG_SIZE + 1,
                CCL_SELECTION_MAX_COLL_SIZE,
                ccl_coll_allgatherv_ring);
     }
-    else if (ccl::global_data::env().atl_transport == ccl_atl_mpi) {
+    else {
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_allgatherv_direct);
     }
 #endif // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
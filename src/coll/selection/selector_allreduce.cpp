@@ -34,7 +34,7 @@ std::map<ccl_coll_allreduce_algo, std::string>
 ccl_algorithm_selector<ccl_coll_allreduce>::ccl_algorithm_selector() {
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
     insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_allreduce_topo);
-    if (ccl::global_data::env().atl_transport == ccl_atl_ofi) {
+    if (ccl::global_data::env().atl_transport != ccl_atl_mpi) {
         insert(fallback_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_allreduce_ring);
         insert(
             fallback_table, 0, CCL_ALLREDUCE_SHORT_MSG_SIZE, ccl_coll_allreduce_recursive_doubling);
@@ -44,7 +44,7 @@ ccl_algorithm_selector<ccl_coll_allreduce>::ccl_algorithm_selector() {
         insert(fallback_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_allreduce_ring);
     }
 #else // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
-    if (ccl::global_data::env().atl_transport == ccl_atl_ofi) {
+    if (ccl::global_data::env().atl_transport != ccl_atl_mpi) {
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_allreduce_ring);
         insert(main_table, 0, CCL_ALLREDUCE_SHORT_MSG_SIZE, ccl_coll_allreduce_recursive_doubling);
         insert(main_table,
@@ -52,7 +52,7 @@ ccl_algorithm_selector<ccl_coll_allreduce>::ccl_algorithm_selector() {
                CCL_ALLREDUCE_MEDIUM_MSG_SIZE,
                ccl_coll_allreduce_nreduce);
     }
-    else if (ccl::global_data::env().atl_transport == ccl_atl_mpi) {
+    else {
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_allreduce_direct);
     }
     insert(fallback_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_allreduce_ring);
@@ -77,10 +77,14 @@ bool ccl_algorithm_selector_helper<ccl_coll_allreduce_algo>::can_use(
         can_use = false;
     else if (algo == ccl_coll_allreduce_ring_rma && !atl_base_comm::attr.out.enable_rma)
         can_use = false;
+    else if ((algo == ccl_coll_allreduce_ring_rma || algo == ccl_coll_allreduce_topo) &&
+             param.reduction == ccl::reduction::avg)
+        // avg is fused into the final reduction step only for host algorithms
+        can_use = false;
     else if (algo == ccl_coll_allreduce_nreduce && !(param.count / param.comm->size()))
         can_use = false;
     else if (algo == ccl_coll_allreduce_direct &&
-             (ccl::global_data::env().atl_transport == ccl_atl_ofi))
+             (ccl::global_data::env().atl_transport != ccl_atl_mpi))
         can_use = false;
     else if (algo == ccl_coll_allreduce_topo && !ccl_can_use_topo_algo(param))
         can_use = false;
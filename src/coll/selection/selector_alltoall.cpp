@@ -21,6 +21,7 @@ std::map<ccl_coll_alltoall_algo, std::string>
         std::make_pair(ccl_coll_alltoall_direct, "direct"),
         std::make_pair(ccl_coll_alltoall_naive, "naive"),
         std::make_pair(ccl_coll_alltoall_scatter, "scatter"),
+        std::make_pair(ccl_coll_alltoall_bruck, "bruck"),
 #ifdef CCL_ENABLE_SYCL
         std::make_pair(ccl_coll_alltoall_topo, "topo")
 #endif // CCL_ENABLE_SYCL
@@ -31,6 +32,12 @@ ccl_algorithm_selector<ccl_coll_alltoall>::ccl_algorithm_selector() {
     insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_alltoall_topo);
 #else // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
     insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_alltoall_scatter);
+    if (ccl::global_data::env().alltoall_bruck_max_size > 0) {
+        insert(main_table,
+               0,
+               ccl::global_data::env().alltoall_bruck_max_size,
+               ccl_coll_alltoall_bruck);
+    }
     if (ccl::global_data::env().atl_transport == ccl_atl_mpi) {
         insert(main_table, 0, CCL_ALLTOALL_MEDIUM_MSG_SIZE, ccl_coll_alltoall_direct);
     }
@@ -49,12 +56,17 @@ bool ccl_algorithm_selector_helper<ccl_coll_alltoall_algo>::can_use(
     if (algo == ccl_coll_alltoall_topo && !ccl_can_use_topo_algo(param)) {
         can_use = false;
     }
+#ifdef CCL_ENABLE_SYCL
+    else if (algo == ccl_coll_alltoall_bruck && param.is_sycl_buf) {
+        can_use = false;
+    }
+#endif // CCL_ENABLE_SYCL
     else if (param.is_vector_buf && algo != ccl_coll_alltoall_scatter &&
              algo != ccl_coll_alltoall_naive && algo != ccl_coll_alltoall_topo) {
         can_use = false;
     }
     else if (algo == ccl_coll_alltoall_direct &&
-             (ccl::global_data::env().atl_transport == ccl_atl_ofi)) {
+             (ccl::global_data::env().atl_transport != ccl_atl_mpi)) {
         can_use = false;
     }
     else if (algo == ccl_coll_alltoall_direct && param.is_scaleout) {
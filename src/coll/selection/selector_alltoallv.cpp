@@ -21,6 +21,7 @@ std::map<ccl_coll_alltoallv_algo, std::string>
         std::make_pair(ccl_coll_alltoallv_direct, "direct"),
         std::make_pair(ccl_coll_alltoallv_naive, "naive"),
         std::make_pair(ccl_coll_alltoallv_scatter, "scatter"),
+        std::make_pair(ccl_coll_alltoallv_hier, "hier"),
 #ifdef CCL_ENABLE_SYCL
         std::make_pair(ccl_coll_alltoallv_topo, "topo")
 #endif // CCL_ENABLE_SYCL
@@ -30,7 +31,7 @@ ccl_algorithm_selector<ccl_coll_alltoallv>::ccl_algorithm_selector() {
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
     insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_alltoallv_topo);
 #else // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
-    insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_alltoallv_scatter);
+    insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_alltoallv_hier);
     if (ccl::global_data::env().atl_transport == ccl_atl_mpi) {
         insert(main_table, 0, CCL_ALLTOALL_MEDIUM_MSG_SIZE, ccl_coll_alltoallv_direct);
     }
@@ -39,6 +40,24 @@ ccl_algorithm_selector<ccl_coll_alltoallv>::ccl_algorithm_selector() {
     insert(fallback_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_alltoallv_scatter);
 }
 
+static bool ccl_can_use_hier_alltoallv(const ccl_selector_param& param) {
+    RETURN_FALSE_IF(param.is_vector_buf, "vector buffer is not supported");
+#ifdef CCL_ENABLE_SYCL
+    RETURN_FALSE_IF(param.is_sycl_buf, "sycl buffer is not supported");
+#endif // CCL_ENABLE_SYCL
+    RETURN_FALSE_IF(checkers::is_gpu_stream(param), "gpu stream is not supported");
+    RETURN_FALSE_IF(param.is_scaleout, "scaleout is not supported");
+    // node_comm and r2r_comm of a sub-communicator belong to its parent
+    RETURN_FALSE_IF(param.comm->get_parent_comm(), "sub-communicator is not supported");
+
+    const ccl::topo_manager& topo_manager = param.comm->get_topo_manager();
+    RETURN_FALSE_IF(topo_manager.is_single_node, "single node is not supported");
+    RETURN_FALSE_IF(!topo_manager.has_block_layout(), "ranks are not placed in blocks by node");
+    RETURN_FALSE_IF(param.comm->get_node_comm()->size() == 1, "one rank per node");
+
+    return true;
+}
+
 template <>
 bool ccl_algorithm_selector_helper<ccl_coll_alltoallv_algo>::can_use(
     ccl_coll_alltoallv_algo algo,
@@ -49,12 +68,15 @@ bool ccl_algorithm_selector_helper<ccl_coll_alltoallv_algo>::can_use(
     if (algo == ccl_coll_alltoallv_topo && !ccl_can_use_topo_algo(param)) {
         can_use = false;
     }
+    else if (algo == ccl_coll_alltoallv_hier && !ccl_can_use_hier_alltoallv(param)) {
+        can_use = false;
+    }
     else if (param.is_vector_buf && algo != ccl_coll_alltoallv_scatter &&
              algo != ccl_coll_alltoallv_naive && algo != ccl_coll_alltoallv_topo) {
         can_use = false;
     }
     else if (algo == ccl_coll_alltoallv_direct &&
-             (ccl::global_data::env().atl_transport == ccl_atl_ofi)) {
+             (ccl::global_data::env().atl_transport != ccl_atl_mpi)) {
         can_use = false;
     }
     else if (algo == ccl_coll_alltoallv_direct && param.is_scaleout) {
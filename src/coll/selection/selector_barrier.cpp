@@ -24,9 +24,9 @@ std::map<ccl_coll_barrier_algo, std::string>
 
 ccl_algorithm_selector<ccl_coll_barrier>::ccl_algorithm_selector() {
     // TODO: make ring barrier default after MLSL-1915 is done
-    if (ccl::global_data::env().atl_transport == ccl_atl_ofi)
+    if (ccl::global_data::env().atl_transport != ccl_atl_mpi)
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_barrier_ring);
-    else if (ccl::global_data::env().atl_transport == ccl_atl_mpi)
+    else
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_barrier_direct);
     insert(fallback_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_barrier_ring);
 
@@ -42,7 +42,7 @@ bool ccl_algorithm_selector_helper<ccl_coll_barrier_algo>::can_use(
     const ccl_selection_table_t<ccl_coll_barrier_algo>& table) {
     bool can_use = true;
 
-    if (algo == ccl_coll_barrier_direct && (ccl::global_data::env().atl_transport == ccl_atl_ofi))
+    if (algo == ccl_coll_barrier_direct && (ccl::global_data::env().atl_transport != ccl_atl_mpi))
         can_use = false;
 
     return can_use;
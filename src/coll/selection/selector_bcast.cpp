@@ -31,11 +31,11 @@ ccl_algorithm_selector<ccl_coll_bcast>::ccl_algorithm_selector() {
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
     insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_bcast_topo);
 #else // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
-    if (ccl::global_data::env().atl_transport == ccl_atl_ofi) {
+    if (ccl::global_data::env().atl_transport != ccl_atl_mpi) {
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_bcast_naive);
         insert(main_table, 0, CCL_BCAST_SHORT_MSG_SIZE, ccl_coll_bcast_double_tree);
     }
-    else if (ccl::global_data::env().atl_transport == ccl_atl_mpi) {
+    else {
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_bcast_direct);
     }
 #endif // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
@@ -63,7 +63,7 @@ bool ccl_algorithm_selector_helper<ccl_coll_bcast_algo>::can_use(
         can_use = false;
     }
     else if (algo == ccl_coll_bcast_direct &&
-             (ccl::global_data::env().atl_transport == ccl_atl_ofi)) {
+             (ccl::global_data::env().atl_transport != ccl_atl_mpi)) {
         can_use = false;
     }
     else if (algo == ccl_coll_bcast_topo && !ccl_can_use_topo_algo(param)) {
@@ -96,11 +96,11 @@ ccl_algorithm_selector<ccl_coll_broadcast>::ccl_algorithm_selector() {
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
     insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_broadcast_topo);
 #else // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
-    if (ccl::global_data::env().atl_transport == ccl_atl_ofi) {
+    if (ccl::global_data::env().atl_transport != ccl_atl_mpi) {
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_broadcast_naive);
         insert(main_table, 0, CCL_BCAST_SHORT_MSG_SIZE, ccl_coll_broadcast_double_tree);
     }
-    else if (ccl::global_data::env().atl_transport == ccl_atl_mpi) {
+    else {
         insert(main_table, 0, CCL_SELECTION_MAX_COLL_SIZE, ccl_coll_broadcast_direct);
     }
 #endif // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
@@ -128,7 +128,7 @@ bool ccl_algorithm_selector_helper<ccl_coll_broadcast_algo>::can_use(
         can_use = false;
     }
     else if (algo == ccl_coll_broadcast_direct &&
-             (ccl::global_data::env().atl_transport == ccl_atl_ofi)) {
+             (ccl::global_data::env().atl_transport != ccl_atl_mpi)) {
         can_use = false;
     }
     else if (algo == ccl_coll_broadcast_topo && !ccl_can_use_topo_algo(param)) {
@@ -47,6 +47,12 @@ inline const std::string ccl_coll_algorithm_to_str(int algo) {
     return std::to_string(algo);
 }
 
+// returned name has static storage duration so it can be kept without copying
+template <typename algo_group_type>
+inline const char* ccl_coll_algorithm_name(algo_group_type algo) {
+    return ccl_algorithm_selector_helper<algo_group_type>::algo_to_str(algo).c_str();
+}
+
 template <typename algo_group_type>
 inline algo_group_type ccl_coll_algorithm_from_str(const std::string& str) {
     return ccl_algorithm_selector_helper<algo_group_type>::algo_from_str(str);
@@ -16,6 +16,7 @@
 #pragma once
 
 #include "coll/selection/selector_helper.hpp"
+#include "coll/selection/tuning.hpp"
 #include "exec/exec.hpp"
 
 #include <set>
@@ -160,12 +161,27 @@ void ccl_algorithm_selector_base<algo_group_type>::init() {
     algo_group_type elem_algo;
     ccl_selection_border_type elem_border;
 
+    /* tuning is applied first, so explicit CCL_<COLL> variables take precedence */
+    const auto& tuning = ccl::global_data::get().tuning;
+    tuned_tables.clear();
+    for (size_t comm_size : tuning->get_comm_sizes()) {
+        auto& table = tuned_tables[comm_size];
+        table = main_table;
+        fill_table_from_str<algo_group_type>(
+            tuning->get_algo_str(ccl_algorithm_selector_helper<algo_group_type>::get_coll_id(),
+                                 comm_size),
+            table);
+        fill_table_from_str<algo_group_type>(main_str_to_parse, table);
+    }
     fill_table_from_str<algo_group_type>(main_str_to_parse, main_table);
     fill_table_from_str<algo_group_type>(scaleout_str_to_parse, scaleout_table);
 
     auto tables_to_check = std::vector<const ccl_selection_table_t<algo_group_type>*>{
         &main_table, &fallback_table, &scaleout_table
     };
+    for (const auto& table : tuned_tables) {
+        tables_to_check.push_back(&table.second);
+    }
 
     for (const auto& table : tables_to_check) {
         CCL_THROW_IF_NOT(table->size() >= 2, "selection table should have at least 2 entries");
@@ -223,6 +239,11 @@ void ccl_algorithm_selector_base<algo_group_type>::print() const {
         str << "  " << table_name << std::endl;
         str << ccl_algorithm_selector_base<algo_group_type>::table_to_str(*table);
     }
+    for (const auto& table : tuned_tables) {
+        str << "  tuned table, comm_size "
+            << ((table.first) ? std::to_string(table.first) : std::string("any")) << std::endl;
+        str << ccl_algorithm_selector_base<algo_group_type>::table_to_str(table.second);
+    }
     LOG_DEBUG(str.str());
 }
 
@@ -297,7 +318,7 @@ algo_group_type ccl_algorithm_selector_base<algo_group_type>::get(
     if (param.hint_algo.has_value()) {
         elem_algo = static_cast<algo_group_type>(param.hint_algo.value);
         if (!ccl_algorithm_selector_helper<algo_group_type>::can_use(
-                elem_algo, param, main_table)) {
+                elem_algo, param, get_main_table(param))) {
             LOG_DEBUG("can not select hint algorithm: coll ",
                       ccl_coll_type_to_str(param.ctype),
                       ", count ",
@@ -337,11 +358,12 @@ algo_group_type ccl_algorithm_selector_base<algo_group_type>::get(
         }
     }
 
-    auto lower_bound = main_table.lower_bound(size);
-    ccl_selection_unpack_elem(elem_size, elem_algo, elem_border, lower_bound, main_table);
+    const auto& table = get_main_table(param);
+    auto lower_bound = table.lower_bound(size);
+    ccl_selection_unpack_elem(elem_size, elem_algo, elem_border, lower_bound, table);
 
-    if (lower_bound == main_table.end() ||
-        !ccl_algorithm_selector_helper<algo_group_type>::can_use(elem_algo, param, main_table)) {
+    if (lower_bound == table.end() ||
+        !ccl_algorithm_selector_helper<algo_group_type>::can_use(elem_algo, param, table)) {
         CCL_THROW_IF_NOT(ccl::global_data::env().enable_algo_fallback,
                          "can not select algo from main table and fallback is disabled",
                          ", coll ",
@@ -372,6 +394,19 @@ algo_group_type ccl_algorithm_selector_base<algo_group_type>::get(
     return elem_algo;
 }
 
+template <typename algo_group_type>
+const ccl_selection_table_t<algo_group_type>& ccl_algorithm_selector_base<
+    algo_group_type>::get_main_table(const ccl_selector_param& param) const {
+    if (tuned_tables.empty() || !param.comm)
+        return main_table;
+
+    /* the entry for the exact comm size wins over the one for any comm size */
+    auto it = tuned_tables.find(param.comm->size());
+    if (it == tuned_tables.end())
+        it = tuned_tables.find(0);
+    return (it != tuned_tables.end()) ? it->second : main_table;
+}
+
 template <typename algo_group_type>
 void ccl_algorithm_selector_base<algo_group_type>::insert(
     ccl_selection_table_t<algo_group_type>& table,
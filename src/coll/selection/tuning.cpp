@@ -0,0 +1,421 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#include "coll/selection/selection.hpp"
+#include "coll/selection/tuning.hpp"
+#include "common/env/vars.hpp"
+#include "common/global/global.hpp"
+#include "common/log/log.hpp"
+
+namespace {
+
+/* only what the tuning needs: no duplicate keys check, \u escapes are limited to ASCII */
+struct json_value {
+    enum class value_type { null, boolean, number, string, array, object };
+
+    value_type type = value_type::null;
+    bool boolean = false;
+    double number = 0;
+    std::string str;
+    std::vector<json_value> array;
+    std::vector<std::pair<std::string, json_value>> object;
+
+    const json_value* find(const std::string& key) const {
+        for (const auto& member : object) {
+            if (member.first == key)
+                return &member.second;
+        }
+        return nullptr;
+    }
+};
+
+class json_parser {
+public:
+    explicit json_parser(const std::string& text) : text(text) {}
+
+    json_value parse() {
+        json_value value = parse_value();
+        skip_spaces();
+        CCL_THROW_IF_NOT(pos == text.size(), "tuning: unexpected data at position ", pos);
+        return value;
+    }
+
+private:
+    void skip_spaces() {
+        while (pos < text.size() && isspace(static_cast<unsigned char>(text[pos]))) {
+            pos++;
+        }
+    }
+
+    char next() {
+        skip_spaces();
+        CCL_THROW_IF_NOT(pos < text.size(), "tuning: unexpected end of data");
+        return text[pos];
+    }
+
+    void expect(char c) {
+        CCL_THROW_IF_NOT(next() == c, "tuning: expected '", c, "' at position ", pos);
+        pos++;
+    }
+
+    bool consume(const std::string& word) {
+        if (text.compare(pos, word.size(), word) == 0) {
+            pos += word.size();
+            return true;
+        }
+        return false;
+    }
+
+    std::string parse_string() {
+        expect('"');
+        std::string str;
+        while (true) {
+            CCL_THROW_IF_NOT(pos < text.size(), "tuning: unterminated string");
+            char c = text[pos++];
+            if (c == '"')
+                break;
+            if (c != '\\') {
+                str += c;
+                continue;
+            }
+            CCL_THROW_IF_NOT(pos < text.size(), "tuning: unterminated string");
+            c = text[pos++];
+            switch (c) {
+                case 'b': str += '\b'; break;
+                case 'f': str += '\f'; break;
+                case 'n': str += '\n'; break;
+                case 'r': str += '\r'; break;
+                case 't': str += '\t'; break;
+                case 'u': {
+                    CCL_THROW_IF_NOT(pos + 4 <= text.size(), "tuning: incomplete \\u escape");
+                    long code = std::strtol(text.substr(pos, 4).c_str(), nullptr, 16);
+                    str += (code < 0x80) ? static_cast<char>(code) : '?';
+                    pos += 4;
+                    break;
+                }
+                default: str += c; break;
+            }
+        }
+        return str;
+    }
+
+    json_value parse_value() {
+        json_value value;
+        char c = next();
+        if (c == '{') {
+            value.type = json_value::value_type::object;
+            pos++;
+            if (next() == '}') {
+                pos++;
+                return value;
+            }
+            while (true) {
+                std::string key = parse_string();
+                expect(':');
+                value.object.emplace_back(key, parse_value());
+                if (next() == ',') {
+                    pos++;
+                    continue;
+                }
+                expect('}');
+                break;
+            }
+        }
+        else if (c == '[') {
+            value.type = json_value::value_type::array;
+            pos++;
+            if (next() == ']') {
+                pos++;
+                return value;
+            }
+            while (true) {
+                value.array.push_back(parse_value());
+                if (next() == ',') {
+                    pos++;
+                    continue;
+                }
+                expect(']');
+                break;
+            }
+        }
+        else if (c == '"') {
+            value.type = json_value::value_type::string;
+            value.str = parse_string();
+        }
+        else if (consume("true")) {
+            value.type = json_value::value_type::boolean;
+            value.boolean = true;
+        }
+        else if (consume("false")) {
+            value.type = json_value::value_type::boolean;
+        }
+        else if (consume("null")) {
+            value.type = json_value::value_type::null;
+        }
+        else {
+            const char* start = text.c_str() + pos;
+            char* end = nullptr;
+            value.type = json_value::value_type::number;
+            value.number = std::strtod(start, &end);
+            CCL_THROW_IF_NOT(end != start, "tuning: unexpected symbol at position ", pos);
+            pos += end - start;
+        }
+        return value;
+    }
+
+    const std::string& text;
+    size_t pos = 0;
+};
+
+const std::map<std::string, ccl_coll_type> algo_var_names = {
+    std::make_pair(CCL_ALLGATHER, ccl_coll_allgather),
+    std::make_pair(CCL_ALLGATHERV, ccl_coll_allgatherv),
+    std::make_pair(CCL_ALLREDUCE, ccl_coll_allreduce),
+    std::make_pair(CCL_ALLTOALL, ccl_coll_alltoall),
+    std::make_pair(CCL_ALLTOALLV, ccl_coll_alltoallv),
+    std::make_pair(CCL_BARRIER, ccl_coll_barrier),
+    std::make_pair(CCL_BCAST, ccl_coll_bcast),
+    std::make_pair(CCL_BROADCAST, ccl_coll_broadcast),
+    std::make_pair(CCL_REDUCE, ccl_coll_reduce),
+    std::make_pair(CCL_REDUCE_SCATTER, ccl_coll_reduce_scatter)
+};
+
+const std::map<std::string, ccl_tuning_param> param_var_names = {
+    std::make_pair(CCL_CHUNK_COUNT, ccl_tuning_param::chunk_count),
+    std::make_pair(CCL_RS_CHUNK_COUNT, ccl_tuning_param::rs_chunk_count),
+    std::make_pair(CCL_ALLREDUCE_2D_CHUNK_COUNT, ccl_tuning_param::allreduce_2d_chunk_count)
+};
+
+size_t parse_size(const std::string& str, const std::string& block) {
+    if (str == CCL_SELECTION_MAX_COLL_SIZE_STR)
+        return CCL_SELECTION_MAX_COLL_SIZE;
+
+    char* end = nullptr;
+    size_t size = std::strtoul(str.c_str(), &end, 10);
+    CCL_THROW_IF_NOT(!str.empty() && *end == '\0', "tuning: can not parse size in block ", block);
+    return size;
+}
+
+std::string value_to_str(const json_value& value) {
+    if (value.type == json_value::value_type::number)
+        return std::to_string(static_cast<size_t>(value.number));
+    return value.str;
+}
+
+bool is_set_explicitly(const std::string& name) {
+    if (!getenv(name.c_str()))
+        return false;
+    LOG_INFO("tuning: ", name, " is set explicitly, skip value from the tuning");
+    return true;
+}
+
+} // namespace
+
+void ccl_tuning::set(const std::string& json) {
+    sets.clear();
+
+    if (json.empty())
+        return;
+
+    json_value root = json_parser(json).parse();
+    const json_value* tunings = root.find("tunings");
+    CCL_THROW_IF_NOT(tunings && tunings->type == json_value::value_type::array,
+                     "tuning: no tunings array");
+
+    /* per comm size: the entry with the exact worker count, otherwise the one without it */
+    size_t worker_count = ccl::global_data::env().worker_count;
+    std::map<size_t, std::pair<const json_value*, bool>> entries;
+    for (const auto& entry : tunings->array) {
+        const json_value* entry_worker_count = entry.find("worker_count");
+        bool is_exact = (entry_worker_count != nullptr);
+        if (is_exact && static_cast<size_t>(entry_worker_count->number) != worker_count)
+            continue;
+
+        const json_value* entry_comm_size = entry.find("comm_size");
+        size_t comm_size = (entry_comm_size) ? static_cast<size_t>(entry_comm_size->number) : 0;
+        CCL_THROW_IF_NOT(!entry_comm_size || comm_size > 0, "tuning: incorrect comm_size");
+
+        auto it = entries.find(comm_size);
+        if (it == entries.end() || (is_exact && !it->second.second)) {
+            entries[comm_size] = std::make_pair(&entry, is_exact);
+        }
+    }
+
+    if (entries.empty()) {
+        LOG_WARN("tuning: no entry for worker count ", worker_count, ", the tuning is not used");
+        return;
+    }
+
+    for (const auto& entry : entries) {
+        size_t comm_size = entry.first;
+        tuning_set& set = sets[comm_size];
+
+        const json_value* vars = entry.second.first->find("vars");
+        if (vars) {
+            for (const auto& var : vars->object) {
+                const std::string& name = var.first;
+                std::string str = value_to_str(var.second);
+                if (is_set_explicitly(name))
+                    continue;
+
+                auto algo_it = algo_var_names.find(name);
+                if (algo_it != algo_var_names.end()) {
+                    set.algo_strs[algo_it->second] = str;
+                    LOG_DEBUG("tuning: comm_size ", comm_size, ", ", name, "=", str);
+                    continue;
+                }
+
+                auto param_it = param_var_names.find(name);
+                if (param_it == param_var_names.end()) {
+                    LOG_WARN("tuning: unsupported variable ", name, ", skip it");
+                    continue;
+                }
+
+                parse_param_ranges(
+                    name, str, set.params[std::make_pair(param_it->second, ccl_coll_last_value)]);
+                LOG_DEBUG("tuning: comm_size ", comm_size, ", ", name, "=", str);
+            }
+        }
+
+        const json_value* coll_vars = entry.second.first->find("coll_vars");
+        if (!coll_vars)
+            continue;
+
+        for (const auto& coll : coll_vars->object) {
+            std::string coll_var_name = "CCL_" + coll.first;
+            std::transform(
+                coll_var_name.begin(), coll_var_name.end(), coll_var_name.begin(), ::toupper);
+            auto algo_it = algo_var_names.find(coll_var_name);
+            if (algo_it == algo_var_names.end()) {
+                LOG_WARN("tuning: unsupported collective ", coll.first, ", skip it");
+                continue;
+            }
+
+            for (const auto& var : coll.second.object) {
+                const std::string& name = var.first;
+                std::string str = value_to_str(var.second);
+                if (is_set_explicitly(name))
+                    continue;
+
+                auto param_it = param_var_names.find(name);
+                if (param_it == param_var_names.end()) {
+                    LOG_WARN(
+                        "tuning: unsupported variable ", name, " of ", coll.first, ", skip it");
+                    continue;
+                }
+
+                parse_param_ranges(
+                    name, str, set.params[std::make_pair(param_it->second, algo_it->second)]);
+                LOG_DEBUG("tuning: comm_size ", comm_size, ", ", coll.first, " ", name, "=", str);
+            }
+        }
+    }
+}
+
+void ccl_tuning::parse_param_ranges(const std::string& name,
+                                    const std::string& str,
+                                    std::vector<param_range>& ranges) {
+    /* format: <value>:<size1-size2>;<value>:<size1-size2>; ... or <value> */
+    std::stringstream stream(str);
+    std::string block;
+    while (std::getline(stream, block, CCL_SELECTION_BLOCK_DELIMETER)) {
+        param_range range{ 0, CCL_SELECTION_MAX_COLL_SIZE, 0 };
+        size_t algo_pos = block.find(CCL_SELECTION_ALGO_DELIMETER);
+        range.value = parse_size(block.substr(0, algo_pos), block);
+        if (algo_pos != std::string::npos) {
+            std::string sizes = block.substr(algo_pos + 1);
+            size_t size_pos = sizes.find(CCL_SELECTION_SIZE_DELIMETER);
+            CCL_THROW_IF_NOT(
+                size_pos != std::string::npos, "tuning: can not parse sizes in block ", block);
+            range.left = parse_size(sizes.substr(0, size_pos), block);
+            range.right = parse_size(sizes.substr(size_pos + 1), block);
+        }
+        CCL_THROW_IF_NOT(range.value >= 1, "tuning: incorrect ", name, " ", range.value);
+        CCL_THROW_IF_NOT(range.left <= range.right,
+                         "tuning: left border is greater than right one in block ",
+                         block);
+        ranges.push_back(range);
+    }
+}
+
+void ccl_tuning::load_file(const std::string& path) {
+    std::ifstream file(path);
+    CCL_THROW_IF_NOT(file, "tuning: can not open file ", path);
+
+    std::stringstream content;
+    content << file.rdbuf();
+    set(content.str());
+    LOG_INFO("tuning: loaded ", path);
+}
+
+std::vector<size_t> ccl_tuning::get_comm_sizes() const {
+    std::vector<size_t> comm_sizes;
+    for (const auto& set : sets) {
+        comm_sizes.push_back(set.first);
+    }
+    return comm_sizes;
+}
+
+const std::string& ccl_tuning::get_algo_str(ccl_coll_type ctype, size_t comm_size) const {
+    static const std::string empty_str;
+    auto set_it = sets.find(comm_size);
+    if (set_it == sets.end())
+        return empty_str;
+    auto it = set_it->second.algo_strs.find(ctype);
+    return (it != set_it->second.algo_strs.end()) ? it->second : empty_str;
+}
+
+const ccl_tuning::tuning_set* ccl_tuning::find_set(size_t comm_size) const {
+    auto it = sets.find(comm_size);
+    if (it == sets.end())
+        it = sets.find(0);
+    return (it != sets.end()) ? &it->second : nullptr;
+}
+
+bool ccl_tuning::is_tuned(ccl_coll_type ctype, size_t comm_size) const {
+    const tuning_set* set = find_set(comm_size);
+    return set && set->algo_strs.find(ctype) != set->algo_strs.end();
+}
+
+size_t ccl_tuning::get_param(ccl_tuning_param param,
+                             ccl_coll_type ctype,
+                             size_t comm_size,
+                             size_t bytes,
+                             size_t default_value) const {
+    const tuning_set* set = find_set(comm_size);
+    if (!set)
+        return default_value;
+
+    /* ranges of the collective first, then ranges of any collective */
+    for (ccl_coll_type key_ctype : { ctype, ccl_coll_last_value }) {
+        auto params_it = set->params.find(std::make_pair(param, key_ctype));
+        if (params_it == set->params.end())
+            continue;
+
+        /* later ranges override earlier ones, the same as for selection strings */
+        const auto& ranges = params_it->second;
+        for (auto it = ranges.rbegin(); it != ranges.rend(); ++it) {
+            if (bytes >= it->left && bytes <= it->right)
+                return it->value;
+        }
+    }
+    return default_value;
+}
@@ -0,0 +1,113 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "coll/algorithms/algorithm_utils.hpp"
+
+/*
+   tuning of algorithm selection and chunk counts per message size (CCL_TUNING_FILE)
+
+   format:
+   {
+     "tunings": [
+       {
+         "worker_count": 1,
+         "comm_size": 4,
+         "vars": {
+           "CCL_ALLREDUCE": "recursive_doubling:0-8191;ring:8192-max",
+           "CCL_CHUNK_COUNT": "2"
+         },
+         "coll_vars": {
+           "allreduce": { "CCL_RS_CHUNK_COUNT": "1:0-65535;4:65536-max" },
+           "reduce_scatter": { "CCL_RS_CHUNK_COUNT": "2:65536-max" }
+         }
+       }
+     ]
+   }
+
+   entries with worker_count different from CCL_WORKER_COUNT are skipped,
+   the entry without worker_count is used only if there is no entry with the exact worker_count.
+   an entry applies to communicators of its comm_size, the entry without comm_size
+   applies to communicators of sizes which have no own entry, other communicators are not tuned.
+
+   vars are the CCL_<COLL> selection variables with the same syntax as the environment has,
+   and chunk counts in <value>:<size1-size2>;... syntax, a single <value> covers all sizes.
+   chunk counts of coll_vars apply to the collective only and take precedence over vars,
+   e.g. ring reduce_scatter is a part of ring allreduce and both use CCL_RS_CHUNK_COUNT.
+   sizes of CCL_<COLL> ranges are message sizes in bytes the same as the algorithm selection uses,
+   sizes of chunk count ranges are bytes of the buffer which is split into chunks:
+   per peer for alltoall(v), the whole send buffer for ring reduce_scatter and allreduce.
+
+   explicitly set environment variables take precedence over the tuning
+*/
+
+enum class ccl_tuning_param { chunk_count, rs_chunk_count, allreduce_2d_chunk_count, last_value };
+
+class ccl_tuning {
+public:
+    ccl_tuning() = default;
+    ccl_tuning(const ccl_tuning& other) = delete;
+    ccl_tuning& operator=(const ccl_tuning& other) = delete;
+
+    /*
+       replaces the current tuning, empty string drops it,
+       must not be called while collectives are built or executed
+    */
+    void set(const std::string& json);
+    void load_file(const std::string& path);
+
+    /* comm sizes which have an entry, 0 stands for the entry without comm_size */
+    std::vector<size_t> get_comm_sizes() const;
+
+    /* selection string in CCL_<COLL> format of the entry for exactly this comm size */
+    const std::string& get_algo_str(ccl_coll_type ctype, size_t comm_size) const;
+
+    /* true if the entry applied to this comm size selects algorithms of the collective */
+    bool is_tuned(ccl_coll_type ctype, size_t comm_size) const;
+
+    size_t get_param(ccl_tuning_param param,
+                     ccl_coll_type ctype,
+                     size_t comm_size,
+                     size_t bytes,
+                     size_t default_value) const;
+
+private:
+    struct param_range {
+        size_t left;
+        size_t right;
+        size_t value;
+    };
+
+    /* key of params is the collective, ccl_coll_last_value for any collective */
+    struct tuning_set {
+        std::map<ccl_coll_type, std::string> algo_strs;
+        std::map<std::pair<ccl_tuning_param, ccl_coll_type>, std::vector<param_range>> params;
+    };
+
+    static void parse_param_ranges(const std::string& name,
+                                   const std::string& str,
+                                   std::vector<param_range>& ranges);
+
+    /* the entry for the exact comm size, otherwise the one for any comm size */
+    const tuning_set* find_set(size_t comm_size) const;
+
+    /* key is comm_size of the entry, 0 for the entry without comm_size */
+    std::map<size_t, tuning_set> sets;
+};
@@ -25,6 +25,7 @@
 #include "common/event/impls/host_event.hpp"
 #include "common/request/request.hpp"
 #include "sched/sched.hpp"
+#include "sched/sched_trace.hpp"
 #include "oneapi/ccl/types.hpp"
 #include "oneapi/ccl/kvs.hpp"
 #include "oneapi/ccl/comm_split_attr_ids.hpp"
@@ -104,6 +105,18 @@ ccl_internal_comm::ccl_internal_comm(int comm_id,
     }
 }
 
+ccl_internal_comm::~ccl_internal_comm() {
+    if (coll_stats.is_dump_enabled()) {
+        std::string stats = coll_stats.to_string();
+        if (!stats.empty()) {
+            ccl_logger::get_instance().info(
+                "coll stats, comm rank ", m_rank, ", size ", m_size, ":", stats);
+        }
+    }
+
+    coll_tuner.dump(m_rank, m_size);
+}
+
 void ccl_internal_comm::reset(int rank, int size) {
     m_rank = rank;
     m_size = size;
@@ -140,6 +153,7 @@ void ccl_comm::init(int comm_id,
     }
 
     if (!is_sub_communicator) {
+        ccl::profile::trace::set_rank(comm_rank);
         topo_manager.init(atl_comm, device_ptr, context_ptr);
         if (!comm_rank && device_ptr) {
             LOG_INFO("topo_manager:", topo_manager.to_string());
@@ -157,6 +171,11 @@ void ccl_comm::init(int comm_id,
 
     env = std::make_shared<ccl_comm_env>(device_ptr);
 
+    if (!is_sub_communicator && comm_impl->cost_model.is_enabled()) {
+        /* subcommunicators use the regular selection */
+        comm_impl->cost_model.init(this);
+    }
+
     if (comm_rank == 0) {
         LOG_DEBUG(to_string_ext());
     }
@@ -19,6 +19,9 @@
 #include <unordered_map>
 
 #include "atl/atl_base_comm.hpp"
+#include "coll/coll_cost_model.hpp"
+#include "coll/coll_stats.hpp"
+#include "coll/coll_tuner.hpp"
 #include "comm/comm_interface.hpp"
 #include "comm/atl_tag.hpp"
 #include "common/log/log.hpp"
@@ -289,7 +292,7 @@ public:
     ccl_internal_comm(int comm_id, int rank, int size, std::shared_ptr<atl_base_comm> comm);
     // needed for multithreading (single process multiple devices) approach:
     ccl_internal_comm(int comm_id, int rank, int size);
-    ~ccl_internal_comm() = default;
+    ~ccl_internal_comm();
 
     int rank() const noexcept {
         return m_rank;
@@ -383,6 +386,9 @@ public:
 
     std::shared_ptr<atl_base_comm> atl_comm;
     std::unique_ptr<ccl_unordered_coll_manager> unordered_coll_manager;
+    ccl_coll_stats coll_stats;
+    ccl_coll_tuner coll_tuner;
+    ccl_coll_cost_model cost_model;
 
 private:
     int m_rank;
@@ -611,6 +617,18 @@ public:
         return comm_impl->unordered_coll_manager;
     }
 
+    ccl_coll_stats& get_coll_stats() const {
+        return comm_impl->coll_stats;
+    }
+
+    ccl_coll_tuner& get_coll_tuner() const {
+        return comm_impl->coll_tuner;
+    }
+
+    ccl_coll_cost_model& get_cost_model() const {
+        return comm_impl->cost_model;
+    }
+
     int rank() const override {
         return comm_rank;
     }
@@ -40,7 +40,9 @@ void api_wrappers_init() {
         LOG_INFO("could not initialize MPI api");
     }
 #endif //CCL_ENABLE_MPI
-    CCL_THROW_IF_NOT(ofi_inited || mpi_inited, "could not initialize any transport library");
+    CCL_THROW_IF_NOT(ofi_inited || mpi_inited ||
+                         ccl::global_data::env().atl_transport == ccl_atl_shm,
+                     "could not initialize any transport library");
     if (!ofi_inited && (ccl::global_data::env().atl_transport == ccl_atl_ofi)) {
         ccl::global_data::env().atl_transport = ccl_atl_mpi;
         LOG_WARN("OFI transport was not initialized, fallback to MPI transport");
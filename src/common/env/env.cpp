@@ -42,7 +42,8 @@ std::map<ccl_priority_mode, std::string> env_data::priority_mode_names = {
 };
 
 std::map<ccl_atl_transport, std::string> env_data::atl_transport_names = {
-    std::make_pair(ccl_atl_ofi, "ofi")
+    std::make_pair(ccl_atl_ofi, "ofi"),
+    std::make_pair(ccl_atl_shm, "shm")
 #ifdef CCL_ENABLE_MPI
         ,
     std::make_pair(ccl_atl_mpi, "mpi")
@@ -84,6 +85,11 @@ env_data::env_data()
           queue_dump(false),
           sched_dump(false),
           sched_profile(false),
+          enable_coll_stats(true),
+          coll_stats_dump(false),
+          enable_trace(false),
+          trace_file("ccl_trace"),
+          trace_buffer_size(262144),
           entry_max_update_time_sec(CCL_ENV_SIZET_NOT_SPECIFIED),
 
           fw_type(ccl_framework_none),
@@ -91,7 +97,11 @@ env_data::env_data()
           worker_count(1),
           worker_offload(true),
           worker_wait(true),
+          worker_park(false),
+          worker_park_timeout(1000),
+          worker_steal(false),
           worker_affinity_set(0),
+          worker_affinity_numa(false),
 #ifdef CCL_ENABLE_MPI
           atl_transport(ccl_atl_mpi),
 #else // CCL_ENABLE_MPI
@@ -106,6 +116,8 @@ env_data::env_data()
           enable_hmem(0),
           atl_send_proxy(ccl_atl_send_proxy_none),
           enable_atl_cache(1),
+          atl_cache_max_size(8L * 1024 * 1024 * 1024),
+          atl_cache_max_entries(1024),
           enable_sync_coll(0),
           enable_extra_ep(0),
           enable_auto_cache(0),
@@ -118,6 +130,9 @@ env_data::env_data()
           mnic_offset(ATL_MNIC_OFFSET_NONE),
 
           enable_algo_fallback(1),
+          enable_autotune(0),
+          autotune_iters(5),
+          enable_cost_model(0),
           enable_unordered_coll(0),
 
           enable_fusion(0),
@@ -127,6 +142,7 @@ env_data::env_data()
           fusion_cycle_ms(0.2),
 
           priority_mode(ccl_priority_none),
+          priority_bucket_count(1),
           spin_count(100),
           yield_type(ccl_yield_pause),
           max_short_size(0),
@@ -137,7 +153,14 @@ env_data::env_data()
 #else // CCL_ENABLE_SYCL
           enable_cache_flush(0),
 #endif // CCL_ENABLE_SYCL
+          cache_max_entries(8192),
+          cache_max_size(0),
           enable_buffer_cache(1),
+          buffer_cache_max_size(0),
+          buffer_cache_numa_node(CCL_UNDEFINED_NUMA_NODE),
+          enable_huge_pages(0),
+          enable_object_pool(1),
+          enable_sched_plan(1),
           enable_strict_order(0),
           staging_buffer(ccl_staging_regular),
           enable_op_sync(0),
@@ -229,6 +252,10 @@ env_data::env_data()
           check_inplace_aliasing(1),
 
           alltoall_scatter_max_ops(CCL_ENV_SIZET_NOT_SPECIFIED),
+          alltoall_bruck_max_size(256),
+
+          lazy_entries_threshold(1024),
+          lazy_entries_window(64),
 
           backend(backend_mode::native),
 
@@ -349,7 +376,8 @@ env_data::env_data()
           debug_timestamps_level(0),
 
           bf16_impl_type(ccl_bf16_scalar),
-          fp16_impl_type(ccl_fp16_no_compiler_support) {
+          fp16_impl_type(ccl_fp16_no_compiler_support),
+          simd_impl_type(ccl_simd_scalar) {
 }
 
 void env_data::parse() {
@@ -361,6 +389,13 @@ void env_data::parse() {
     p.env_2_type(CCL_QUEUE_DUMP, queue_dump);
     p.env_2_type(CCL_SCHED_DUMP, sched_dump);
     p.env_2_type(CCL_SCHED_PROFILE, sched_profile);
+    p.env_2_type(CCL_COLL_STATS, enable_coll_stats);
+    p.env_2_type(CCL_COLL_STATS_DUMP, coll_stats_dump);
+    p.env_2_type(CCL_TRACE, enable_trace);
+    p.env_2_type(CCL_TRACE_FILE, trace_file);
+    p.env_2_type(CCL_TRACE_BUFFER_SIZE, trace_buffer_size);
+    CCL_THROW_IF_NOT(
+        trace_buffer_size > 0, "incorrect ", CCL_TRACE_BUFFER_SIZE, " ", trace_buffer_size);
     p.env_2_type(CCL_ENTRY_MAX_UPDATE_TIME_SEC, entry_max_update_time_sec);
     CCL_THROW_IF_NOT(
         entry_max_update_time_sec == CCL_ENV_SIZET_NOT_SPECIFIED || entry_max_update_time_sec > 0,
@@ -396,6 +431,11 @@ void env_data::parse() {
     CCL_THROW_IF_NOT(worker_count >= 1, "incorrect ", CCL_WORKER_COUNT, " ", worker_count);
     p.env_2_type(CCL_WORKER_OFFLOAD, worker_offload);
     p.env_2_type(CCL_WORKER_WAIT, worker_wait);
+    p.env_2_type(CCL_WORKER_PARK, worker_park);
+    p.env_2_type(CCL_WORKER_PARK_TIMEOUT, worker_park_timeout);
+    CCL_THROW_IF_NOT(
+        worker_park_timeout > 0, "incorrect ", CCL_WORKER_PARK_TIMEOUT, " ", worker_park_timeout);
+    p.env_2_type(CCL_WORKER_STEAL, worker_steal);
 
     p.env_2_atl_transport(atl_transport_names, atl_transport);
     p.env_2_enum(CCL_KVS_MODE, kvs_mode_names, kvs_init_mode);
@@ -411,6 +451,8 @@ void env_data::parse() {
     }
     p.env_2_enum(CCL_ATL_SEND_PROXY, atl_send_proxy_names, atl_send_proxy);
     p.env_2_type(CCL_ATL_CACHE, enable_atl_cache);
+    p.env_2_type(CCL_ATL_CACHE_MAX_SIZE, atl_cache_max_size);
+    p.env_2_type(CCL_ATL_CACHE_MAX_ENTRIES, atl_cache_max_entries);
     p.env_2_type(CCL_ATL_SYNC_COLL, enable_sync_coll);
     p.env_2_type(CCL_ATL_EXTRA_EP, enable_extra_ep);
     p.env_2_type(CCL_ENABLE_AUTO_CACHE, enable_auto_cache);
@@ -427,6 +469,12 @@ void env_data::parse() {
     p.env_2_enum(CCL_MNIC_OFFSET, mnic_offset_names, mnic_offset);
 
     p.env_2_type(CCL_ALGO_FALLBACK, enable_algo_fallback);
+    p.env_2_type(CCL_AUTOTUNE, enable_autotune);
+    p.env_2_type(CCL_AUTOTUNE_ITERS, autotune_iters);
+    CCL_THROW_IF_NOT(autotune_iters > 0, "incorrect ", CCL_AUTOTUNE_ITERS, " ", autotune_iters);
+    p.env_2_type(CCL_AUTOTUNE_FILE, autotune_file);
+    p.env_2_type(CCL_TUNING_FILE, tuning_file);
+    p.env_2_type(CCL_COST_MODEL, enable_cost_model);
     // main algorithm selection
     p.env_2_type(CCL_ALLGATHER, allgather_algo_raw);
     p.env_2_type(CCL_ALLGATHERV, allgatherv_algo_raw);
@@ -450,8 +498,8 @@ void env_data::parse() {
     p.env_2_type(CCL_REDUCE_SCATTER_SCALEOUT, reduce_scatter_scaleout_algo_raw);
 
     p.env_2_type(CCL_UNORDERED_COLL, enable_unordered_coll);
-    if (enable_unordered_coll && atl_transport != ccl_atl_ofi) {
-        CCL_THROW("unordered collectives are supported for OFI transport only");
+    if (enable_unordered_coll && atl_transport == ccl_atl_mpi) {
+        CCL_THROW("unordered collectives are supported for OFI and SHM transports only");
     }
 
     p.env_2_type(CCL_FUSION, enable_fusion);
@@ -479,13 +527,26 @@ void env_data::parse() {
         spin_count = 1000;
 
     p.env_2_enum(CCL_PRIORITY, priority_mode_names, priority_mode);
+    p.env_2_type(CCL_PRIORITY_BUCKET_COUNT, priority_bucket_count);
+    CCL_THROW_IF_NOT(priority_bucket_count > 0,
+                     "incorrect ",
+                     CCL_PRIORITY_BUCKET_COUNT,
+                     " ",
+                     priority_bucket_count);
     p.env_2_type(CCL_SPIN_COUNT, spin_count);
     p.env_2_enum(CCL_YIELD, ccl_yield_type_names, yield_type);
     p.env_2_type(CCL_MAX_SHORT_SIZE, max_short_size);
     p.env_2_type(CCL_BCAST_PART_COUNT, (size_t&)bcast_part_count);
     p.env_2_enum(CCL_CACHE_KEY, ccl_sched_key::key_type_names, cache_key_type);
     p.env_2_type(CCL_CACHE_FLUSH, enable_cache_flush);
+    p.env_2_type(CCL_CACHE_MAX_ENTRIES, cache_max_entries);
+    p.env_2_type(CCL_CACHE_MAX_SIZE, cache_max_size);
     p.env_2_type(CCL_BUFFER_CACHE, enable_buffer_cache);
+    p.env_2_type(CCL_BUFFER_CACHE_MAX_SIZE, buffer_cache_max_size);
+    p.env_2_type(CCL_BUFFER_CACHE_NUMA_NODE, buffer_cache_numa_node);
+    p.env_2_type(CCL_HUGE_PAGES, enable_huge_pages);
+    p.env_2_type(CCL_OBJECT_POOL, enable_object_pool);
+    p.env_2_type(CCL_SCHED_PLAN, enable_sched_plan);
     p.env_2_type(CCL_STRICT_ORDER, enable_strict_order);
     if (enable_unordered_coll && enable_strict_order) {
         LOG_INFO("unordered collectives are requested, disable strict order");
@@ -593,6 +654,12 @@ void env_data::parse() {
     p.env_2_type(CCL_CHECK_INPLACE_ALIASING, check_inplace_aliasing);
 
     p.env_2_type(CCL_ALLTOALL_SCATTER_MAX_OPS, (size_t&)alltoall_scatter_max_ops);
+    p.env_2_type(CCL_ALLTOALL_BRUCK_MAX_SIZE, alltoall_bruck_max_size);
+
+    p.env_2_type(CCL_LAZY_ENTRIES_THRESHOLD, lazy_entries_threshold);
+    p.env_2_type(CCL_LAZY_ENTRIES_WINDOW, lazy_entries_window);
+    CCL_THROW_IF_NOT(
+        lazy_entries_window >= 1, "incorrect ", CCL_LAZY_ENTRIES_WINDOW, " ", lazy_entries_window);
 
     p.env_2_enum(CCL_BACKEND, backend_names, backend);
 
@@ -766,6 +833,13 @@ void env_data::parse() {
                      "unsupported FP16 impl type: ",
                      fp16_env_impl_names[fp16_impl_type]);
 
+    auto simd_impl_types = ccl_simd_get_impl_types();
+    simd_impl_type = *simd_impl_types.rbegin();
+    p.env_2_enum(CCL_REDUCE_SIMD, simd_impl_names, simd_impl_type);
+    CCL_THROW_IF_NOT(simd_impl_types.find(simd_impl_type) != simd_impl_types.end(),
+                     "unsupported SIMD impl type: ",
+                     simd_impl_names[simd_impl_type]);
+
     p.warn_about_unused_var();
 }
 
@@ -826,12 +900,22 @@ void env_data::print(int rank, bool is_mt_enabled) {
     LOG_INFO(CCL_WORKER_COUNT, ": ", worker_count);
     LOG_INFO(CCL_WORKER_OFFLOAD, ": ", worker_offload);
     LOG_INFO(CCL_WORKER_WAIT, ": ", worker_wait);
+    LOG_INFO(CCL_WORKER_PARK, ": ", worker_park);
+    LOG_INFO(CCL_WORKER_PARK_TIMEOUT, ": ", worker_park_timeout);
+    LOG_INFO(CCL_WORKER_STEAL, ": ", worker_steal);
 
     LOG_INFO(CCL_LOG_LEVEL, ": ", str_by_enum(ccl_logger::level_names, log_level));
     LOG_INFO(CCL_ABORT_ON_THROW, ": ", abort_on_throw);
     LOG_INFO(CCL_QUEUE_DUMP, ": ", queue_dump);
     LOG_INFO(CCL_SCHED_DUMP, ": ", sched_dump);
     LOG_INFO(CCL_SCHED_PROFILE, ": ", sched_profile);
+    LOG_INFO(CCL_COLL_STATS, ": ", enable_coll_stats);
+    LOG_INFO(CCL_COLL_STATS_DUMP, ": ", coll_stats_dump);
+    LOG_INFO(CCL_TRACE, ": ", enable_trace);
+    if (enable_trace) {
+        LOG_INFO(CCL_TRACE_FILE, ": ", trace_file);
+        LOG_INFO(CCL_TRACE_BUFFER_SIZE, ": ", trace_buffer_size);
+    }
     LOG_INFO(CCL_ENTRY_MAX_UPDATE_TIME_SEC,
              ": ",
              (entry_max_update_time_sec != CCL_ENV_SIZET_NOT_SPECIFIED)
@@ -850,6 +934,8 @@ void env_data::print(int rank, bool is_mt_enabled) {
     LOG_INFO(CCL_ATL_HMEM, ": ", enable_hmem);
     LOG_INFO(CCL_ATL_SEND_PROXY, ": ", str_by_enum(atl_send_proxy_names, atl_send_proxy));
     LOG_INFO(CCL_ATL_CACHE, ": ", enable_atl_cache);
+    LOG_INFO(CCL_ATL_CACHE_MAX_SIZE, ": ", atl_cache_max_size);
+    LOG_INFO(CCL_ATL_CACHE_MAX_ENTRIES, ": ", atl_cache_max_entries);
     LOG_DEBUG(CCL_ATL_SYNC_COLL, ": ", enable_sync_coll);
     LOG_DEBUG(CCL_ATL_EXTRA_EP, ": ", enable_extra_ep);
     LOG_DEBUG(CCL_ENABLE_AUTO_CACHE, ": ", enable_auto_cache);
@@ -864,6 +950,17 @@ void env_data::print(int rank, bool is_mt_enabled) {
     LOG_INFO(CCL_MNIC_OFFSET, ": ", str_by_enum(mnic_offset_names, mnic_offset));
 
     LOG_INFO(CCL_ALGO_FALLBACK, ": ", enable_algo_fallback);
+    LOG_INFO(CCL_AUTOTUNE, ": ", enable_autotune);
+    if (enable_autotune) {
+        LOG_INFO(CCL_AUTOTUNE_ITERS, ": ", autotune_iters);
+        LOG_INFO(CCL_AUTOTUNE_FILE,
+                 ": ",
+                 (autotune_file.length()) ? autotune_file : CCL_ENV_STR_NOT_SPECIFIED);
+    }
+    LOG_INFO(CCL_TUNING_FILE,
+             ": ",
+             (tuning_file.length()) ? tuning_file : CCL_ENV_STR_NOT_SPECIFIED);
+    LOG_INFO(CCL_COST_MODEL, ": ", enable_cost_model);
     LOG_INFO(CCL_ALLGATHER,
              ": ",
              (allgather_algo_raw.length()) ? allgather_algo_raw : CCL_ENV_STR_NOT_SPECIFIED);
@@ -931,6 +1028,7 @@ void env_data::print(int rank, bool is_mt_enabled) {
     LOG_INFO(CCL_FUSION_CYCLE_MS, ": ", fusion_cycle_ms);
 
     LOG_INFO(CCL_PRIORITY, ": ", str_by_enum(priority_mode_names, priority_mode));
+    LOG_INFO(CCL_PRIORITY_BUCKET_COUNT, ": ", priority_bucket_count);
     LOG_INFO(CCL_SPIN_COUNT, ": ", spin_count);
     LOG_INFO(CCL_YIELD, ": ", str_by_enum(ccl_yield_type_names, yield_type));
     LOG_INFO(CCL_MAX_SHORT_SIZE, ": ", max_short_size);
@@ -940,7 +1038,18 @@ void env_data::print(int rank, bool is_mt_enabled) {
                                                                : CCL_ENV_STR_NOT_SPECIFIED);
     LOG_INFO(CCL_CACHE_KEY, ": ", str_by_enum(ccl_sched_key::key_type_names, cache_key_type));
     LOG_INFO(CCL_CACHE_FLUSH, ": ", enable_cache_flush);
+    LOG_INFO(CCL_CACHE_MAX_ENTRIES, ": ", cache_max_entries);
+    LOG_INFO(CCL_CACHE_MAX_SIZE, ": ", cache_max_size);
     LOG_INFO(CCL_BUFFER_CACHE, ": ", enable_buffer_cache);
+    LOG_INFO(CCL_BUFFER_CACHE_MAX_SIZE, ": ", buffer_cache_max_size);
+    LOG_INFO(CCL_BUFFER_CACHE_NUMA_NODE,
+             ": ",
+             (buffer_cache_numa_node != CCL_UNDEFINED_NUMA_NODE)
+                 ? std::to_string(buffer_cache_numa_node)
+                 : CCL_ENV_STR_NOT_SPECIFIED);
+    LOG_INFO(CCL_HUGE_PAGES, ": ", enable_huge_pages);
+    LOG_INFO(CCL_OBJECT_POOL, ": ", enable_object_pool);
+    LOG_INFO(CCL_SCHED_PLAN, ": ", enable_sched_plan);
     LOG_INFO(CCL_STRICT_ORDER, ": ", enable_strict_order);
     LOG_INFO(CCL_STAGING_BUFFER, ": ", str_by_enum(staging_buffer_names, staging_buffer));
     LOG_INFO(CCL_OP_SYNC, ": ", enable_op_sync);
@@ -1040,6 +1149,10 @@ void env_data::print(int rank, bool is_mt_enabled) {
              (alltoall_scatter_max_ops != CCL_ENV_SIZET_NOT_SPECIFIED)
                  ? std::to_string(alltoall_scatter_max_ops)
                  : CCL_ENV_STR_NOT_SPECIFIED);
+    LOG_INFO(CCL_ALLTOALL_BRUCK_MAX_SIZE, ": ", alltoall_bruck_max_size);
+
+    LOG_INFO(CCL_LAZY_ENTRIES_THRESHOLD, ": ", lazy_entries_threshold);
+    LOG_INFO(CCL_LAZY_ENTRIES_WINDOW, ": ", lazy_entries_window);
 
     LOG_INFO(CCL_BACKEND, ": ", str_by_enum(backend_names, backend));
 
@@ -1171,6 +1284,7 @@ void env_data::print(int rank, bool is_mt_enabled) {
 
     LOG_INFO(CCL_BF16, ": ", str_by_enum(bf16_impl_names, bf16_impl_type));
     LOG_INFO(CCL_FP16, ": ", str_by_enum(fp16_impl_names, fp16_impl_type));
+    LOG_INFO(CCL_REDUCE_SIMD, ": ", str_by_enum(simd_impl_names, simd_impl_type));
 
     char* ccl_root = getenv("CCL_ROOT");
     LOG_INFO("CCL_ROOT: ", (ccl_root) ? ccl_root : CCL_ENV_STR_NOT_SPECIFIED);
@@ -1352,7 +1466,116 @@ int env_data::parse_affinity(const std::string& input,
     return 1;
 }
 
-int env_data::env_2_worker_affinity(int local_proc_idx, int local_proc_count) {
+int env_data::env_2_worker_affinity_numa(int local_proc_idx,
+                                         const std::vector<int>& worker_nic_numa_nodes) {
+    auto& hwloc_wrapper = ccl::global_data::get().hwloc_wrapper;
+    CCL_THROW_IF_NOT(hwloc_wrapper && hwloc_wrapper->is_initialized(),
+                     "hwloc is not initialized, can't set NUMA-aware worker affinity");
+
+    auto numa_nodes = hwloc_wrapper->get_numa_nodes();
+    CCL_THROW_IF_NOT(!numa_nodes.empty(), "no NUMA nodes found");
+
+    /*
+       NUMA node of worker: node of its NIC, else node of process binding, else round-robin,
+       binding of other local processes is unknown, so if process is bound to a part
+       of NUMA node only its bound cores are used, other processes are expected
+       to be bound elsewhere, otherwise local processes are assumed to share the node
+    */
+    int process_numa_node = hwloc_wrapper->get_process_numa_node();
+    std::string source = "nic";
+    if (worker_nic_numa_nodes.empty()) {
+        source = (process_numa_node != CCL_UNDEFINED_NUMA_NODE) ? "process binding" : "round-robin";
+    }
+    bool use_binding = (source == "process binding");
+    bool exclusive_binding = false;
+    if (use_binding) {
+        for (auto cpu : hwloc_wrapper->get_numa_node(process_numa_node).cpus) {
+            if (!hwloc_wrapper->is_process_bound_cpu(cpu)) {
+                exclusive_binding = true;
+                break;
+            }
+        }
+    }
+
+    auto get_worker_numa_node = [&](int proc_idx, size_t worker_idx) {
+        int numa_node = CCL_UNDEFINED_NUMA_NODE;
+        if (!worker_nic_numa_nodes.empty()) {
+            numa_node = worker_nic_numa_nodes[proc_idx * worker_count + worker_idx];
+        }
+        else if (use_binding) {
+            numa_node = process_numa_node;
+        }
+        if (numa_node == CCL_UNDEFINED_NUMA_NODE) {
+            numa_node = numa_nodes[proc_idx % numa_nodes.size()].os_idx;
+        }
+        return numa_node;
+    };
+
+    /* CPUs are grouped by cores, take the first hardware thread of each core */
+    auto get_cores = [&](int numa_node) {
+        ccl_numa_node node = hwloc_wrapper->get_numa_node(numa_node);
+        CCL_THROW_IF_NOT(!node.cpus.empty(), "no CPUs found for NUMA node ", numa_node);
+        size_t threads_per_core = std::max(node.cpus.size() / std::max(node.core_count, 1),
+                                           static_cast<size_t>(1));
+        std::vector<int> cores;
+        for (size_t idx = 0; idx < node.cpus.size(); idx += threads_per_core) {
+            if (!exclusive_binding || hwloc_wrapper->is_process_bound_cpu(node.cpus[idx])) {
+                cores.push_back(node.cpus[idx]);
+            }
+        }
+        CCL_THROW_IF_NOT(!cores.empty(), "no available cores found for NUMA node ", numa_node);
+        return cores;
+    };
+
+    /*
+       workers of all local processes are placed on their nodes in the same order,
+       so worker takes the next core of its node after ones taken by preceding workers,
+       the last cores of NUMA node are used as first ones are usually taken by application
+    */
+    std::map<int, size_t> taken_cores;
+    std::vector<ssize_t> worker_cpus;
+    std::vector<int> worker_numa_nodes;
+    int first_proc_idx = exclusive_binding ? local_proc_idx : 0;
+    for (int proc_idx = first_proc_idx; proc_idx <= local_proc_idx; proc_idx++) {
+        for (size_t idx = 0; idx < worker_count; idx++) {
+            int numa_node = get_worker_numa_node(proc_idx, idx);
+            size_t slot = taken_cores[numa_node]++;
+            if (proc_idx != local_proc_idx) {
+                continue;
+            }
+
+            std::vector<int> cores = get_cores(numa_node);
+            if (slot >= cores.size()) {
+                LOG_WARN("the number of workers on NUMA node ",
+                         numa_node,
+                         " exceeds the number of its available cores (",
+                         cores.size(),
+                         "), workers will share cores");
+            }
+            worker_affinity[local_proc_idx * worker_count + idx] =
+                cores[cores.size() - slot % cores.size() - 1];
+            worker_cpus.push_back(worker_affinity[local_proc_idx * worker_count + idx]);
+            worker_numa_nodes.push_back(numa_node);
+        }
+    }
+    worker_affinity_set = true;
+    worker_affinity_numa = true;
+
+    LOG_INFO("NUMA placement: local_proc_idx ",
+             local_proc_idx,
+             ", source ",
+             source,
+             ", worker numa_nodes: ",
+             ccl::utils::vec_to_string(worker_numa_nodes),
+             ", worker cpus: ",
+             ccl::utils::vec_to_string(worker_cpus));
+
+    return 1;
+}
+
+int env_data::env_2_worker_affinity(int local_proc_idx,
+                                    int local_proc_count,
+                                    const std::vector<int>& worker_nic_numa_nodes) {
     CCL_THROW_IF_NOT(local_proc_count > 0);
 
     size_t idx;
@@ -1387,6 +1610,11 @@ int env_data::env_2_worker_affinity(int local_proc_idx, int local_proc_count) {
         }
     }
 
+    if (strcmp(env_to_parse, "numa") == 0) {
+        worker_affinity.assign(affinity_size, CCL_UNDEFINED_CPU_ID);
+        return env_2_worker_affinity_numa(local_proc_idx, worker_nic_numa_nodes);
+    }
+
     CCL_THROW_IF_NOT(parse_affinity(env_to_parse, worker_affinity, affinity_size),
                      "failed to parse worker affinity");
     worker_affinity_set = true;
@@ -29,6 +29,7 @@
 #include "common/utils/yield.hpp"
 #include "comp/bf16/bf16_utils.hpp"
 #include "comp/fp16/fp16_utils.hpp"
+#include "comp/simd/simd_utils.hpp"
 #include "sched/cache/cache.hpp"
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
 #include "common/global/ze/ze_fd_manager.hpp"
@@ -44,7 +45,8 @@ enum ccl_priority_mode { ccl_priority_none,
                          ccl_priority_lifo };
 
 enum ccl_atl_transport { ccl_atl_ofi,
-                         ccl_atl_mpi };
+                         ccl_atl_mpi,
+                         ccl_atl_shm };
 
 enum ccl_atl_send_proxy {
     ccl_atl_send_proxy_none,
@@ -111,6 +113,11 @@ public:
     bool queue_dump;
     bool sched_dump;
     bool sched_profile;
+    bool enable_coll_stats;
+    bool coll_stats_dump;
+    bool enable_trace;
+    std::string trace_file;
+    size_t trace_buffer_size;
     ssize_t entry_max_update_time_sec;
 
     ccl_framework_type fw_type;
@@ -118,7 +125,11 @@ public:
     size_t worker_count;
     bool worker_offload;
     bool worker_wait;
+    bool worker_park;
+    size_t worker_park_timeout;
+    bool worker_steal;
     bool worker_affinity_set;
+    bool worker_affinity_numa;
     std::vector<ssize_t> worker_affinity;
     std::vector<ssize_t> worker_mem_affinity;
 
@@ -132,6 +143,8 @@ public:
     bool enable_hmem;
     ccl_atl_send_proxy atl_send_proxy;
     bool enable_atl_cache;
+    size_t atl_cache_max_size;
+    size_t atl_cache_max_entries;
     bool enable_sync_coll;
     bool enable_extra_ep;
     bool enable_auto_cache;
@@ -153,6 +166,11 @@ public:
     std::shared_ptr<ccl_selection_table_t<ccl_coll_recv_algo>> fallback_recv, store_fallback_recv;
     std::shared_ptr<ccl_selection_table_t<ccl_coll_send_algo>> fallback_send, store_fallback_send;
     bool enable_algo_fallback;
+    bool enable_autotune;
+    size_t autotune_iters;
+    std::string autotune_file;
+    std::string tuning_file;
+    bool enable_cost_model;
     // main algorithm selection
     std::string allgather_algo_raw;
     std::string allgatherv_algo_raw;
@@ -188,13 +206,21 @@ public:
     float fusion_cycle_ms;
 
     ccl_priority_mode priority_mode;
+    size_t priority_bucket_count;
     size_t spin_count;
     ccl_yield_type yield_type;
     size_t max_short_size;
     ssize_t bcast_part_count;
     ccl_cache_key_type cache_key_type;
     bool enable_cache_flush;
+    size_t cache_max_entries;
+    size_t cache_max_size;
     bool enable_buffer_cache;
+    size_t buffer_cache_max_size;
+    int buffer_cache_numa_node;
+    bool enable_huge_pages;
+    bool enable_object_pool;
+    bool enable_sched_plan;
     bool enable_strict_order;
     ccl_staging_buffer staging_buffer;
     bool enable_op_sync;
@@ -280,6 +306,10 @@ public:
     bool check_inplace_aliasing;
 
     ssize_t alltoall_scatter_max_ops;
+    size_t alltoall_bruck_max_size;
+
+    size_t lazy_entries_threshold;
+    size_t lazy_entries_window;
 
     backend_mode backend;
 
@@ -382,6 +412,7 @@ public:
 
     ccl_bf16_impl_type bf16_impl_type;
     ccl_fp16_impl_type fp16_impl_type;
+    ccl_simd_impl_type simd_impl_type;
 
     template <class T>
     static std::string str_by_enum(const std::map<T, std::string>& values, const T& val) {
@@ -404,11 +435,15 @@ public:
     static std::map<backend_mode, std::string> backend_names;
     static std::map<process_launcher_mode, std::string> process_launcher_names;
 
-    int env_2_worker_affinity(int local_proc_idx, int local_proc_count);
+    int env_2_worker_affinity(int local_proc_idx,
+                              int local_proc_count,
+                              const std::vector<int>& worker_nic_numa_nodes = {});
     int env_2_worker_mem_affinity(int local_proc_count);
 
 private:
     int env_2_worker_affinity_auto(int local_proc_idx, size_t workers_per_process);
+    int env_2_worker_affinity_numa(int local_proc_idx,
+                                   const std::vector<int>& worker_nic_numa_nodes);
     static int parse_affinity(const std::string& input,
                               std::vector<ssize_t>& output,
                               size_t expected_output_size);
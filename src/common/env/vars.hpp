@@ -57,6 +57,13 @@ constexpr const char* CCL_ABORT_ON_THROW = "CCL_ABORT_ON_THROW";
 constexpr const char* CCL_QUEUE_DUMP = "CCL_QUEUE_DUMP";
 constexpr const char* CCL_SCHED_DUMP = "CCL_SCHED_DUMP";
 constexpr const char* CCL_SCHED_PROFILE = "CCL_SCHED_PROFILE";
+// per-communicator latency histograms of collectives, see ccl::get_stats
+constexpr const char* CCL_COLL_STATS = "CCL_COLL_STATS";
+constexpr const char* CCL_COLL_STATS_DUMP = "CCL_COLL_STATS_DUMP";
+// timeline of scheds and entries in chrome trace format, one file per rank
+constexpr const char* CCL_TRACE = "CCL_TRACE";
+constexpr const char* CCL_TRACE_FILE = "CCL_TRACE_FILE";
+constexpr const char* CCL_TRACE_BUFFER_SIZE = "CCL_TRACE_BUFFER_SIZE";
 // maximum amount of time in seconds an entry can spend in update. for debug purpose
 constexpr const char* CCL_ENTRY_MAX_UPDATE_TIME_SEC = "CCL_ENTRY_MAX_UPDATE_TIME_SEC";
 
@@ -79,6 +86,9 @@ constexpr const char* CCL_WORKER_COUNT = "CCL_WORKER_COUNT";
 
 constexpr const char* CCL_WORKER_OFFLOAD = "CCL_WORKER_OFFLOAD";
 constexpr const char* CCL_WORKER_WAIT = "CCL_WORKER_WAIT";
+constexpr const char* CCL_WORKER_PARK = "CCL_WORKER_PARK";
+constexpr const char* CCL_WORKER_PARK_TIMEOUT = "CCL_WORKER_PARK_TIMEOUT";
+constexpr const char* CCL_WORKER_STEAL = "CCL_WORKER_STEAL";
 
 /**
  * @addtogroup OneCCLvars
@@ -87,11 +97,14 @@ constexpr const char* CCL_WORKER_WAIT = "CCL_WORKER_WAIT";
 /**
  * @brief Set to specify cpu affinity for oneCCL worker threads.
  *
- * @details "<value>": "auto", "<cpulist>": \n
+ * @details "<value>": "auto", "numa", "<cpulist>": \n
  * "auto" - Workers are automatically pinned to last cores of pin domain.
  * Pin domain depends from process launcher. If mpirun from oneCCL package
  * is used then pin domain is MPI process pin domain. Otherwise, pin domain
- * is all cores on the node. \n "<cpulist>" - A comma-separated list of core
+ * is all cores on the node. \n "numa" - Workers are pinned to last cores
+ * of the NUMA node closest to the NIC selected by OFI (or to NUMA node of
+ * process pin domain, or NUMA nodes are assigned to local processes round-robin),
+ * memory of workers and host scratch buffers is bound to the same NUMA node. \n "<cpulist>" - A comma-separated list of core
  * numbers and/or ranges of core numbers for all local workers, one number
  * per worker. The i-th local worker is pinned to the i-th core in the list.
  * For example 'a','b'-'c'defines list of cores contaning core with number
@@ -205,6 +218,8 @@ constexpr const char* CCL_ATL_SEND_PROXY = "CCL_ATL_SEND_PROXY";
 constexpr const char* CCL_ATL_SYNC_COLL = "CCL_ATL_SYNC_COLL";
 constexpr const char* CCL_ATL_EXTRA_EP = "CCL_ATL_EXTRA_EP";
 constexpr const char* CCL_ATL_CACHE = "CCL_ATL_CACHE";
+constexpr const char* CCL_ATL_CACHE_MAX_SIZE = "CCL_ATL_CACHE_MAX_SIZE";
+constexpr const char* CCL_ATL_CACHE_MAX_ENTRIES = "CCL_ATL_CACHE_MAX_ENTRIES";
 /**
  * @addtogroup OneCCLvars
  * @{
@@ -259,6 +274,14 @@ constexpr const char* CCL_MNIC_COUNT = "CCL_MNIC_COUNT";
 constexpr const char* CCL_MNIC_OFFSET = "CCL_MNIC_OFFSET";
 
 constexpr const char* CCL_ALGO_FALLBACK = "CCL_ALGO_FALLBACK";
+// online selection of the fastest algorithm per communicator, collective and message size
+constexpr const char* CCL_AUTOTUNE = "CCL_AUTOTUNE";
+constexpr const char* CCL_AUTOTUNE_ITERS = "CCL_AUTOTUNE_ITERS";
+constexpr const char* CCL_AUTOTUNE_FILE = "CCL_AUTOTUNE_FILE";
+// selection tables and chunk counts per message size in JSON format, see ccl_tuning
+constexpr const char* CCL_TUNING_FILE = "CCL_TUNING_FILE";
+// selection by analytic cost of algorithms, link latency and bandwidth are measured per comm
+constexpr const char* CCL_COST_MODEL = "CCL_COST_MODEL";
 /**
  * @addtogroup OneCCLvars
  * @{
@@ -325,9 +348,11 @@ constexpr const char* CCL_ALLREDUCE = "CCL_ALLREDUCE";
  *  - direct    Based on MPI_Ialltoallv
  *  - naive     Send to all, receive from all
  *  - scatter   Scatter-based algorithm
+ *  - bruck     Bruck algorithm with log2(comm_size) steps, for small messages
  *  - topo	    Topo scaleup algorithm (available if sycl and l0 are enabled)
  *
- * By-default: "topo", if sycl and l0 are enable, otherwise "scatter"
+ * By-default: "topo", if sycl and l0 are enable, otherwise "bruck" for messages
+ * up to CCL_ALLTOALL_BRUCK_MAX_SIZE bytes per rank and "scatter" for larger ones
  */
 constexpr const char* CCL_ALLTOALL = "CCL_ALLTOALL";
 /**
@@ -337,9 +362,13 @@ constexpr const char* CCL_ALLTOALL = "CCL_ALLTOALL";
  * ALLTOALLV algorithms
  *  - direct    Based on MPI_Ialltoallv
  *  - naive     Send to all, receive from all
+ *  - scatter   Scatter-based algorithm
+ *  - hier      Node-aggregated algorithm: one message per node pair between ranks
+ *              with the same local index, requires block placement of ranks by node
  *  - topo      Topo scaleup algorithm (available if sycl and l0 are enabled)
  *
- * By-default: "topo", if sycl and l0 are enable, otherwise "scatter"
+ * By-default: "topo", if sycl and l0 are enable, otherwise "hier" for multi-node runs
+ * with block rank placement and "scatter" for the rest
  */
 constexpr const char* CCL_ALLTOALLV = "CCL_ALLTOALLV";
 /**
@@ -596,13 +625,21 @@ constexpr const char* CCL_FUSION_CHECK_URGENT = "CCL_FUSION_CHECK_URGENT";
 constexpr const char* CCL_FUSION_CYCLE_MS = "CCL_FUSION_CYCLE_MS";
 
 constexpr const char* CCL_PRIORITY = "CCL_PRIORITY";
+constexpr const char* CCL_PRIORITY_BUCKET_COUNT = "CCL_PRIORITY_BUCKET_COUNT";
 constexpr const char* CCL_SPIN_COUNT = "CCL_SPIN_COUNT";
 constexpr const char* CCL_YIELD = "CCL_YIELD";
 constexpr const char* CCL_MAX_SHORT_SIZE = "CCL_MAX_SHORT_SIZE";
 constexpr const char* CCL_BCAST_PART_COUNT = "CCL_BCAST_PART_COUNT";
 constexpr const char* CCL_CACHE_KEY = "CCL_CACHE_KEY";
 constexpr const char* CCL_CACHE_FLUSH = "CCL_CACHE_FLUSH";
+constexpr const char* CCL_CACHE_MAX_ENTRIES = "CCL_CACHE_MAX_ENTRIES";
+constexpr const char* CCL_CACHE_MAX_SIZE = "CCL_CACHE_MAX_SIZE";
 constexpr const char* CCL_BUFFER_CACHE = "CCL_BUFFER_CACHE";
+constexpr const char* CCL_BUFFER_CACHE_MAX_SIZE = "CCL_BUFFER_CACHE_MAX_SIZE";
+constexpr const char* CCL_BUFFER_CACHE_NUMA_NODE = "CCL_BUFFER_CACHE_NUMA_NODE";
+constexpr const char* CCL_HUGE_PAGES = "CCL_HUGE_PAGES";
+constexpr const char* CCL_OBJECT_POOL = "CCL_OBJECT_POOL";
+constexpr const char* CCL_SCHED_PLAN = "CCL_SCHED_PLAN";
 constexpr const char* CCL_STRICT_ORDER = "CCL_STRICT_ORDER";
 constexpr const char* CCL_STAGING_BUFFER = "CCL_STAGING_BUFFER";
 constexpr const char* CCL_OP_SYNC = "CCL_OP_SYNC";
@@ -934,6 +971,10 @@ constexpr const char* CCL_DTREE_PARTITION_COUNT = "CCL_DTREE_PARTITION_COUNT";
 constexpr const char* CCL_CHECK_INPLACE_ALIASING = "CCL_CHECK_INPLACE_ALIASING";
 
 constexpr const char* CCL_ALLTOALL_SCATTER_MAX_OPS = "CCL_ALLTOALL_SCATTER_MAX_OPS";
+constexpr const char* CCL_ALLTOALL_BRUCK_MAX_SIZE = "CCL_ALLTOALL_BRUCK_MAX_SIZE";
+
+constexpr const char* CCL_LAZY_ENTRIES_THRESHOLD = "CCL_LAZY_ENTRIES_THRESHOLD";
+constexpr const char* CCL_LAZY_ENTRIES_WINDOW = "CCL_LAZY_ENTRIES_WINDOW";
 
 constexpr const char* CCL_BACKEND = "CCL_BACKEND";
 
@@ -1227,3 +1268,4 @@ constexpr const char* CCL_DEBUG_TIMESTAMPS_LEVEL = "CCL_DEBUG_TIMESTAMPS_LEVEL";
 
 constexpr const char* CCL_BF16 = "CCL_BF16";
 constexpr const char* CCL_FP16 = "CCL_FP16";
+constexpr const char* CCL_REDUCE_SIMD = "CCL_REDUCE_SIMD";
@@ -14,6 +14,7 @@
  limitations under the License.
 */
 #include "coll/selection/selection.hpp"
+#include "coll/selection/tuning.hpp"
 #include "common/api_wrapper/api_wrapper.hpp"
 #include "common/api_wrapper/pmix_api_wrapper.hpp"
 #include "common/datatype/datatype.hpp"
@@ -23,6 +24,7 @@
 #include "parallelizer/parallelizer.hpp"
 #include "sched/buffer/buffer_cache.hpp"
 #include "sched/cache/cache.hpp"
+#include "sched/cache/object_pool.hpp"
 #include "sched/cache/recycle_storage.hpp"
 
 #include <sys/utsname.h>
@@ -112,6 +114,7 @@ ccl::status global_data::init() {
     }
 
     recycle_storage.reset(new ccl::recycle_storage());
+    ccl::object_pool::set_enabled(env_object.enable_object_pool);
     shared_data.reset(new shared_resources());
 
     init_resize_dependent_objects();
@@ -137,6 +140,12 @@ void global_data::init_resize_dependent_objects() {
 void global_data::init_resize_independent_objects() {
     parallelizer.reset(new ccl_parallelizer(env_object.worker_count));
 
+    /* tuning is used by algorithm_selector init */
+    tuning.reset(new ccl_tuning());
+    if (!env_object.tuning_file.empty()) {
+        tuning->load_file(env_object.tuning_file);
+    }
+
     algorithm_selector.reset(new ccl_algorithm_selector_wrapper<CCL_COLL_LIST>());
     algorithm_selector->init();
 
@@ -157,6 +166,7 @@ void global_data::reset_resize_dependent_objects() {
 void global_data::reset_resize_independent_objects() {
     parallelizer.reset();
     algorithm_selector.reset();
+    tuning.reset();
     hwloc_wrapper.reset();
     metrics_profiler.reset();
 }
@@ -38,6 +38,7 @@ class ccl_executor;
 class ccl_sched_cache;
 class ccl_parallelizer;
 class ccl_fusion_manager;
+class ccl_tuning;
 
 template <ccl_coll_type... registered_types_id>
 class ccl_algorithm_selector_wrapper;
@@ -86,6 +87,7 @@ public:
     std::unique_ptr<ccl::buffer_cache> buffer_cache;
     std::unique_ptr<ccl_parallelizer> parallelizer;
     std::unique_ptr<ccl_fusion_manager> fusion_manager;
+    std::unique_ptr<ccl_tuning> tuning;
     std::unique_ptr<ccl_algorithm_selector_wrapper<CCL_COLL_LIST>> algorithm_selector;
     std::unique_ptr<ccl_hwloc_wrapper> hwloc_wrapper;
     std::unique_ptr<profile::metrics_manager> metrics_profiler;
@@ -19,6 +19,7 @@
 #include <functional>
 
 #include "common/utils/utils.hpp"
+#include "sched/cache/object_pool.hpp"
 
 #ifdef CCL_ENABLE_SYCL
 #include <sycl/sycl.hpp>
@@ -28,6 +29,8 @@ class ccl_sched;
 
 class alignas(CACHELINE_SIZE) ccl_request {
 public:
+    CCL_OBJECT_POOL_ALLOCATED
+
     using dump_func = std::function<void(std::ostream&)>;
 
     ccl_request(ccl_sched& sched);
@@ -0,0 +1,135 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "common/log/log.hpp"
+#include "common/utils/huge_pages.hpp"
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif // MAP_HUGE_SHIFT
+
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#endif // MAP_HUGE_2MB
+
+#ifndef MAP_HUGE_1GB
+#define MAP_HUGE_1GB (30 << MAP_HUGE_SHIFT)
+#endif // MAP_HUGE_1GB
+
+namespace ccl {
+namespace utils {
+
+namespace {
+
+size_t align_up(size_t bytes, size_t alignment) {
+    return (bytes + alignment - 1) / alignment * alignment;
+}
+
+void* map_hugetlb(size_t bytes, int page_flag) {
+    void* ptr = mmap(nullptr,
+                     bytes,
+                     PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | page_flag,
+                     -1,
+                     0);
+    return (ptr == MAP_FAILED) ? nullptr : ptr;
+}
+
+void* map_thp(size_t bytes) {
+    /* over-map to get 2MB aligned range, THP can back aligned regions only */
+    size_t map_bytes = bytes + huge_page_size_2mb;
+    void* ptr =
+        mmap(nullptr, map_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+        return nullptr;
+    }
+
+    uintptr_t start = (uintptr_t)ptr;
+    uintptr_t aligned_start = align_up(start, huge_page_size_2mb);
+    size_t head = aligned_start - start;
+    size_t tail = map_bytes - head - bytes;
+    if (head) {
+        munmap(ptr, head);
+    }
+    if (tail) {
+        munmap((void*)(aligned_start + bytes), tail);
+    }
+
+#ifdef MADV_HUGEPAGE
+    if (madvise((void*)aligned_start, bytes, MADV_HUGEPAGE)) {
+        LOG_DEBUG("madvise(MADV_HUGEPAGE) failed: ", strerror(errno));
+    }
+#endif // MADV_HUGEPAGE
+
+    return (void*)aligned_start;
+}
+
+} // namespace
+
+std::string to_string(huge_page_type type) {
+    switch (type) {
+        case huge_page_type::none: return "none";
+        case huge_page_type::thp: return "thp";
+        case huge_page_type::huge_2mb: return "2mb";
+        case huge_page_type::huge_1gb: return "1gb";
+        default: return "unknown";
+    }
+}
+
+void* huge_page_alloc(size_t bytes, size_t& mapped_bytes, huge_page_type& type) {
+    void* ptr = nullptr;
+
+    if (bytes >= huge_page_size_1gb && bytes % huge_page_size_1gb == 0) {
+        mapped_bytes = bytes;
+        ptr = map_hugetlb(mapped_bytes, MAP_HUGE_1GB);
+        if (ptr) {
+            type = huge_page_type::huge_1gb;
+            return ptr;
+        }
+    }
+
+    mapped_bytes = align_up(bytes, huge_page_size_2mb);
+    ptr = map_hugetlb(mapped_bytes, MAP_HUGE_2MB);
+    if (ptr) {
+        type = huge_page_type::huge_2mb;
+        return ptr;
+    }
+
+    LOG_DEBUG("can't map ", mapped_bytes, " bytes from hugetlb pool, fallback to THP");
+    ptr = map_thp(mapped_bytes);
+    if (ptr) {
+        type = huge_page_type::thp;
+        return ptr;
+    }
+
+    mapped_bytes = 0;
+    type = huge_page_type::none;
+    return nullptr;
+}
+
+void huge_page_free(void* ptr, size_t mapped_bytes) {
+    if (munmap(ptr, mapped_bytes)) {
+        LOG_WARN("munmap failed: ptr ", ptr, ", bytes ", mapped_bytes, ", error ", strerror(errno));
+    }
+}
+
+} // namespace utils
+} // namespace ccl
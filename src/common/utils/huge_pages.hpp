@@ -0,0 +1,44 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include <stddef.h>
+#include <string>
+
+namespace ccl {
+namespace utils {
+
+enum class huge_page_type { none, thp, huge_2mb, huge_1gb };
+
+std::string to_string(huge_page_type type);
+
+/*
+   maps anonymous memory backed by huge pages,
+   tries explicit 1GB (for multiples of 1GB only, to not round up by almost 1GB)
+   and 2MB pages from hugetlbfs pool first,
+   then falls back to 2MB-aligned mapping with transparent huge pages advice
+
+   returns nullptr if memory can't be mapped,
+   mapped_bytes should be passed to huge_page_free
+*/
+void* huge_page_alloc(size_t bytes, size_t& mapped_bytes, huge_page_type& type);
+void huge_page_free(void* ptr, size_t mapped_bytes);
+
+constexpr size_t huge_page_size_2mb = 2 * 1024 * 1024;
+constexpr size_t huge_page_size_1gb = 1024 * 1024 * 1024;
+
+} // namespace utils
+} // namespace ccl
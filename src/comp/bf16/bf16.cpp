@@ -20,11 +20,13 @@
 #include "comp/bf16/bf16_intrisics.hpp"
 #include "common/utils/enums.hpp"
 
+#define CCL_FLOATS_IN_M256 8
 #define CCL_FLOATS_IN_M512 16
 #define CCL_BF16_SHIFT     16
 
 std::map<ccl_bf16_impl_type, std::string> bf16_impl_names = {
     std::make_pair(ccl_bf16_scalar, "scalar"),
+    std::make_pair(ccl_bf16_avx2, "avx2"),
     std::make_pair(ccl_bf16_avx512f, "avx512f"),
     std::make_pair(ccl_bf16_avx512bf, "avx512bf")
 };
@@ -63,10 +65,14 @@ inline float ccl_convert_bf16_to_fp32_scalar(uint16_t val) {
 void ccl_bf16_reduce_scalar_impl(const void* in_buf,
                                  void* inout_buf,
                                  size_t in_count,
-                                 ccl::reduction op) {
+                                 ccl::reduction op,
+                                 size_t avg_divisor) {
+    float scale = (op == ccl::reduction::avg && avg_divisor > 1) ? 1.0f / avg_divisor : 1.0f;
+
     ccl_bf16_reduction_scalar_func_ptr func = nullptr;
     switch (op) {
-        case ccl::reduction::sum: func = &bf16_sum_scalar; break;
+        case ccl::reduction::sum:
+        case ccl::reduction::avg: func = &bf16_sum_scalar; break;
         case ccl::reduction::prod: func = &bf16_prod_scalar; break;
         case ccl::reduction::min: func = &bf16_min_scalar; break;
         case ccl::reduction::max: func = &bf16_max_scalar; break;
@@ -79,7 +85,7 @@ void ccl_bf16_reduce_scalar_impl(const void* in_buf,
     for (size_t i = 0; i < in_count; i++) {
         float in_value_1 = ccl_convert_bf16_to_fp32_scalar(in_buf_int[i]);
         float in_value_2 = ccl_convert_bf16_to_fp32_scalar(inout_buf_int[i]);
-        float out_value = func(in_value_1, in_value_2);
+        float out_value = func(in_value_1, in_value_2) * scale;
         inout_buf_int[i] = ccl_convert_fp32_to_bf16_scalar(out_value);
     }
 }
@@ -88,7 +94,8 @@ void ccl_bf16_reduce(const void* in_buf,
                      size_t in_count,
                      void* inout_buf,
                      size_t* out_count,
-                     ccl::reduction op) {
+                     ccl::reduction op,
+                     size_t avg_divisor) {
     LOG_DEBUG("BF16 reduction for", in_count, " elements");
 
     if (out_count != nullptr) {
@@ -98,11 +105,16 @@ void ccl_bf16_reduce(const void* in_buf,
     auto bf16_impl_type = ccl::global_data::env().bf16_impl_type;
 
     if (bf16_impl_type == ccl_bf16_scalar) {
-        ccl_bf16_reduce_scalar_impl(in_buf, inout_buf, in_count, op);
+        ccl_bf16_reduce_scalar_impl(in_buf, inout_buf, in_count, op, avg_divisor);
     }
     else {
 #ifdef CCL_BF16_COMPILER
-        ccl_bf16_reduce_impl(in_buf, inout_buf, in_count, op);
+        if (bf16_impl_type == ccl_bf16_avx2) {
+            ccl_bf16_reduce_impl_avx2(in_buf, inout_buf, in_count, op, avg_divisor);
+        }
+        else {
+            ccl_bf16_reduce_impl(in_buf, inout_buf, in_count, op, avg_divisor);
+        }
 #else // CCL_BF16_COMPILER
         CCL_THROW("unexpected bf16_impl_type: ", bf16_impl_type);
 #endif // CCL_BF16_COMPILER
@@ -134,7 +146,12 @@ void ccl_convert_fp32_to_bf16_arrays(void* fp32_buf, void* bf16_buf, size_t coun
     size_t limit = 0;
 
 #ifdef CCL_BF16_COMPILER
-    if (ccl::global_data::env().bf16_impl_type != ccl_bf16_scalar) {
+    auto bf16_impl_type = ccl::global_data::env().bf16_impl_type;
+    if (bf16_impl_type == ccl_bf16_avx2) {
+        limit = (count / CCL_FLOATS_IN_M256) * CCL_FLOATS_IN_M256;
+        ccl_convert_fp32_to_bf16_arrays_avx2(fp32_buf_float, bf16_buf_int, limit);
+    }
+    else if (bf16_impl_type != ccl_bf16_scalar) {
         limit = (count / CCL_FLOATS_IN_M512) * CCL_FLOATS_IN_M512;
         for (size_t i = 0; i < limit; i += CCL_FLOATS_IN_M512) {
             ccl_convert_fp32_to_bf16(fp32_buf_float + i, ((unsigned char*)bf16_buf) + (2 * i));
@@ -154,7 +171,12 @@ void ccl_convert_bf16_to_fp32_arrays(void* bf16_buf, float* fp32_buf, size_t cou
     size_t limit = 0;
 
 #ifdef CCL_BF16_COMPILER
-    if (ccl::global_data::env().bf16_impl_type != ccl_bf16_scalar) {
+    auto bf16_impl_type = ccl::global_data::env().bf16_impl_type;
+    if (bf16_impl_type == ccl_bf16_avx2) {
+        limit = (count / CCL_FLOATS_IN_M256) * CCL_FLOATS_IN_M256;
+        ccl_convert_bf16_to_fp32_arrays_avx2(bf16_buf_int, fp32_buf, limit);
+    }
+    else if (bf16_impl_type != ccl_bf16_scalar) {
         limit = (count / CCL_FLOATS_IN_M512) * CCL_FLOATS_IN_M512;
         for (size_t i = 0; i < limit; i += CCL_FLOATS_IN_M512) {
             ccl_convert_bf16_to_fp32((char*)bf16_buf + (2 * i), fp32_buf + i);
@@ -17,22 +17,13 @@
 
 #include "oneapi/ccl/types.hpp"
 
-#ifdef CCL_BF16_TARGET_ATTRIBUTES
-#ifdef CCL_BF16_AVX512BF_COMPILER
-__attribute__((target("avx512bw,avx512vl,avx512bf16")))
-#else
-__attribute__((target("avx512bw,avx512vl")))
-#endif
-void ccl_bf16_reduce(const void* in_buf, size_t in_cnt,
-                     void* inout_buf, size_t* out_cnt,
-                     ccl::reduction reduction_op);
-#else // CCL_BF16_TARGET_ATTRIBUTES
+/* compiled for the baseline ISA, vectorized kernels are selected at runtime by bf16_impl_type */
 void ccl_bf16_reduce(const void* in_buf,
                      size_t in_cnt,
                      void* inout_buf,
                      size_t* out_cnt,
-                     ccl::reduction reduction_op);
-#endif // CCL_BF16_TARGET_ATTRIBUTES
+                     ccl::reduction reduction_op,
+                     size_t avg_divisor = 1);
 
 void ccl_convert_fp32_to_bf16_arrays(void*, void*, size_t);
 void ccl_convert_bf16_to_fp32_arrays(void*, float*, size_t);
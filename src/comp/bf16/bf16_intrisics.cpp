@@ -37,4 +37,128 @@ BF16_TARGET_ATTRIBUTE_BWF __m512 bf16_reduce(__m512 a, __m512 b, ccl_bf16_reduct
     return (*op)(a, b);
 }
 
+BF16_TARGET_ATTRIBUTE_ALL void ccl_bf16_reduce_impl(const void* in_buf,
+                                                    void* inout_buf,
+                                                    size_t in_cnt,
+                                                    ccl::reduction op,
+                                                    size_t avg_divisor) {
+    /* avg is reduced as sum and scaled in the same pass */
+    float scale = (op == ccl::reduction::avg && avg_divisor > 1) ? 1.0f / avg_divisor : 1.0f;
+
+    ccl_bf16_reduction_func_ptr func = nullptr;
+    switch (op) {
+        case ccl::reduction::sum:
+        case ccl::reduction::avg: func = &bf16_sum_wrap; break;
+        case ccl::reduction::prod: func = &bf16_prod_wrap; break;
+        case ccl::reduction::min: func = &bf16_min_wrap; break;
+        case ccl::reduction::max: func = &bf16_max_wrap; break;
+        default: CCL_FATAL("unexpected value ", ccl::utils::enum_to_underlying(op));
+    }
+
+    auto impl_type = ccl::global_data::env().bf16_impl_type;
+
+    if (impl_type == ccl_bf16_avx512f) {
+        ccl_bf16_reduce_impl_avx512f(in_buf, inout_buf, in_cnt, func, scale);
+    }
+#ifdef CCL_BF16_AVX512BF_COMPILER
+    else if (impl_type == ccl_bf16_avx512bf) {
+        ccl_bf16_reduce_impl_avx512bf(in_buf, inout_buf, in_cnt, func, scale);
+    }
+#endif // CCL_BF16_AVX512BF_COMPILER
+    else {
+        CCL_THROW("unexpected bf16_impl_type: ", impl_type);
+    }
+}
+
+/* reduces in and inout as fp32 with the same operand order as bf16_reduce */
+#define CCL_BF16_AVX2_REDUCE_VEC(VEC_OP, in, inout) \
+    do { \
+        __m256 vfp32_out = \
+            VEC_OP(ccl_bf16_load_as_fp32_avx2(in), ccl_bf16_load_as_fp32_avx2(inout)); \
+        if (scale != 1.0f) { \
+            vfp32_out = _mm256_mul_ps(vfp32_out, vscale); \
+        } \
+        ccl_fp32_store_as_bf16_avx2(vfp32_out, inout); \
+    } while (0)
+
+#define CCL_BF16_DEFINE_AVX2_REDUCE_FUNC(op_name, VEC_OP) \
+    BF16_TARGET_ATTRIBUTE_AVX2 static void ccl_bf16_reduce_##op_name##_avx2( \
+        const uint16_t* in, uint16_t* inout, size_t in_cnt, float scale) { \
+        const __m256 vscale = _mm256_set1_ps(scale); \
+        size_t i = 0; \
+        for (; i + 4 * CCL_BF16_IN_M128 <= in_cnt; i += 4 * CCL_BF16_IN_M128) { \
+            CCL_BF16_AVX2_REDUCE_VEC(VEC_OP, in + i, inout + i); \
+            CCL_BF16_AVX2_REDUCE_VEC( \
+                VEC_OP, in + i + CCL_BF16_IN_M128, inout + i + CCL_BF16_IN_M128); \
+            CCL_BF16_AVX2_REDUCE_VEC( \
+                VEC_OP, in + i + 2 * CCL_BF16_IN_M128, inout + i + 2 * CCL_BF16_IN_M128); \
+            CCL_BF16_AVX2_REDUCE_VEC( \
+                VEC_OP, in + i + 3 * CCL_BF16_IN_M128, inout + i + 3 * CCL_BF16_IN_M128); \
+        } \
+        for (; i + CCL_BF16_IN_M128 <= in_cnt; i += CCL_BF16_IN_M128) { \
+            CCL_BF16_AVX2_REDUCE_VEC(VEC_OP, in + i, inout + i); \
+        } \
+        if (i < in_cnt) { \
+            /* AVX2 has no masked 16-bit loads, reduce the tail through a local tile */ \
+            size_t len = in_cnt - i; \
+            uint16_t a[CCL_BF16_IN_M128] = { 0 }; \
+            uint16_t b[CCL_BF16_IN_M128] = { 0 }; \
+            memcpy(a, in + i, len * sizeof(uint16_t)); \
+            memcpy(b, inout + i, len * sizeof(uint16_t)); \
+            CCL_BF16_AVX2_REDUCE_VEC(VEC_OP, a, b); \
+            memcpy(inout + i, b, len * sizeof(uint16_t)); \
+        } \
+    }
+
+CCL_BF16_DEFINE_AVX2_REDUCE_FUNC(sum, _mm256_add_ps);
+CCL_BF16_DEFINE_AVX2_REDUCE_FUNC(prod, _mm256_mul_ps);
+CCL_BF16_DEFINE_AVX2_REDUCE_FUNC(min, _mm256_min_ps);
+CCL_BF16_DEFINE_AVX2_REDUCE_FUNC(max, _mm256_max_ps);
+
+BF16_TARGET_ATTRIBUTE_AVX2 void ccl_bf16_reduce_impl_avx2(const void* in_buf,
+                                                          void* inout_buf,
+                                                          size_t in_cnt,
+                                                          ccl::reduction op,
+                                                          size_t avg_divisor) {
+    /* avg is reduced as sum and scaled in the same pass */
+    float scale = (op == ccl::reduction::avg && avg_divisor > 1) ? 1.0f / avg_divisor : 1.0f;
+
+    const uint16_t* in = static_cast<const uint16_t*>(in_buf);
+    uint16_t* inout = static_cast<uint16_t*>(inout_buf);
+
+    switch (op) {
+        case ccl::reduction::sum:
+        case ccl::reduction::avg: ccl_bf16_reduce_sum_avx2(in, inout, in_cnt, scale); break;
+        case ccl::reduction::prod: ccl_bf16_reduce_prod_avx2(in, inout, in_cnt, scale); break;
+        case ccl::reduction::min: ccl_bf16_reduce_min_avx2(in, inout, in_cnt, scale); break;
+        case ccl::reduction::max: ccl_bf16_reduce_max_avx2(in, inout, in_cnt, scale); break;
+        default: CCL_FATAL("unexpected value ", ccl::utils::enum_to_underlying(op));
+    }
+}
+
+BF16_TARGET_ATTRIBUTE_AVX2 void ccl_convert_fp32_to_bf16_arrays_avx2(const float* fp32_buf,
+                                                                     uint16_t* bf16_buf,
+                                                                     size_t count) {
+    size_t i = 0;
+    for (; i + 2 * CCL_BF16_IN_M128 <= count; i += 2 * CCL_BF16_IN_M128) {
+        /* pack two vectors at once and fix up the lane order with a single permute */
+        __m256i lo = _mm256_srli_epi32(_mm256_loadu_si256((__m256i const*)(fp32_buf + i)), 16);
+        __m256i hi = _mm256_srli_epi32(
+            _mm256_loadu_si256((__m256i const*)(fp32_buf + i + CCL_BF16_IN_M128)), 16);
+        _mm256_storeu_si256((__m256i*)(bf16_buf + i),
+                            _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xD8));
+    }
+    for (; i + CCL_BF16_IN_M128 <= count; i += CCL_BF16_IN_M128) {
+        ccl_fp32_store_as_bf16_avx2(_mm256_loadu_ps(fp32_buf + i), bf16_buf + i);
+    }
+}
+
+BF16_TARGET_ATTRIBUTE_AVX2 void ccl_convert_bf16_to_fp32_arrays_avx2(const uint16_t* bf16_buf,
+                                                                     float* fp32_buf,
+                                                                     size_t count) {
+    for (size_t i = 0; i + CCL_BF16_IN_M128 <= count; i += CCL_BF16_IN_M128) {
+        _mm256_storeu_ps(fp32_buf + i, ccl_bf16_load_as_fp32_avx2(bf16_buf + i));
+    }
+}
+
 #endif // CCL_BF16_COMPILER
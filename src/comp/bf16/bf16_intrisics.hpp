@@ -30,6 +30,9 @@
 #define BF16_INLINE_TARGET_ATTRIBUTE __attribute__((__always_inline__, target("avx512bf16"))) inline
 #define BF16_INLINE_TARGET_ATTRIBUTE_ALL \
     __attribute__((__always_inline__, target(BF16_ALL_ATTRS))) inline
+#define BF16_TARGET_ATTRIBUTE_AVX2 __attribute__((target("avx2")))
+#define BF16_INLINE_TARGET_ATTRIBUTE_AVX2 \
+    __attribute__((__always_inline__, target("avx2"))) inline
 
 #else // CCL_BF16_TARGET_ATTRIBUTES
 
@@ -38,6 +41,8 @@
 #define BF16_INLINE_TARGET_ATTRIBUTE_BW  __attribute__((__always_inline__)) inline
 #define BF16_INLINE_TARGET_ATTRIBUTE     __attribute__((__always_inline__)) inline
 #define BF16_INLINE_TARGET_ATTRIBUTE_ALL __attribute__((__always_inline__)) inline
+#define BF16_TARGET_ATTRIBUTE_AVX2
+#define BF16_INLINE_TARGET_ATTRIBUTE_AVX2 __attribute__((__always_inline__)) inline
 
 #endif // CCL_BF16_TARGET_ATTRIBUTES
 
@@ -45,12 +50,14 @@
 
 #include <immintrin.h>
 #include <inttypes.h>
+#include <string.h>
 
 #include "common/global/global.hpp"
 #include "comp/bf16/bf16_utils.hpp"
 #include "oneapi/ccl/types.hpp"
 
 #define CCL_BF16_IN_M256 16
+#define CCL_BF16_IN_M128 8
 
 typedef __m512 (*ccl_bf16_reduction_func_ptr)(__m512 a, __m512 b);
 BF16_TARGET_ATTRIBUTE_BWF __m512 bf16_sum_wrap(__m512 a, __m512 b);
@@ -75,42 +82,75 @@ BF16_INLINE_TARGET_ATTRIBUTE void ccl_fp32_store_as_bf16_avx512bf(const void* sr
 }
 #endif // CCL_BF16_AVX512BF_COMPILER
 
+BF16_INLINE_TARGET_ATTRIBUTE_AVX2 __m256 ccl_bf16_load_as_fp32_avx2(const void* src) {
+    __m256i y = _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i const*)src));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(y, 16));
+}
+
+BF16_INLINE_TARGET_ATTRIBUTE_AVX2 void ccl_fp32_store_as_bf16_avx2(__m256 src, void* dst) {
+    /* truncation, the same as in ccl_fp32_store_as_bf16_avx512f */
+    __m256i y = _mm256_srli_epi32(_mm256_castps_si256(src), 16);
+    /* packus works within 128-bit lanes, gather both halves into the low lane */
+    y = _mm256_permute4x64_epi64(_mm256_packus_epi32(y, y), 0xD8);
+    _mm_storeu_si128((__m128i*)dst, _mm256_castsi256_si128(y));
+}
+
+BF16_TARGET_ATTRIBUTE_AVX2 void ccl_bf16_reduce_impl_avx2(const void* in_buf,
+                                                          void* inout_buf,
+                                                          size_t in_cnt,
+                                                          ccl::reduction op,
+                                                          size_t avg_divisor);
+BF16_TARGET_ATTRIBUTE_AVX2 void ccl_convert_fp32_to_bf16_arrays_avx2(const float* fp32_buf,
+                                                                     uint16_t* bf16_buf,
+                                                                     size_t count);
+BF16_TARGET_ATTRIBUTE_AVX2 void ccl_convert_bf16_to_fp32_arrays_avx2(const uint16_t* bf16_buf,
+                                                                     float* fp32_buf,
+                                                                     size_t count);
+
 #define CCL_BF16_DEFINE_REDUCE_FUNC(impl_type) \
 \
     BF16_INLINE_TARGET_ATTRIBUTE_ALL void ccl_bf16_reduce_inputs_##impl_type( \
-        const void* a, const void* b, void* res, ccl_bf16_reduction_func_ptr op) { \
+        const void* a, const void* b, void* res, ccl_bf16_reduction_func_ptr op, float scale) { \
         __m512 vfp32_in, vfp32_inout; \
         ccl_bf16_load_as_fp32(a, (void*)&vfp32_in); \
         ccl_bf16_load_as_fp32(b, (void*)&vfp32_inout); \
         __m512 vfp32_out = bf16_reduce(vfp32_in, vfp32_inout, op); \
+        if (scale != 1.0f) { \
+            vfp32_out = _mm512_mul_ps(vfp32_out, _mm512_set1_ps(scale)); \
+        } \
         ccl_fp32_store_as_bf16_##impl_type((const void*)&vfp32_out, res); \
     } \
 \
     BF16_INLINE_TARGET_ATTRIBUTE_ALL void ccl_bf16_reduce_main_##impl_type( \
-        const void* in, const void* inout, ccl_bf16_reduction_func_ptr op) { \
-        ccl_bf16_reduce_inputs_##impl_type(in, inout, (void*)(inout), op); \
+        const void* in, const void* inout, ccl_bf16_reduction_func_ptr op, float scale) { \
+        ccl_bf16_reduce_inputs_##impl_type(in, inout, (void*)(inout), op, scale); \
     } \
 \
     BF16_INLINE_TARGET_ATTRIBUTE_ALL void ccl_bf16_reduce_tile_##impl_type( \
-        const void* in, void* inout, uint8_t len, ccl_bf16_reduction_func_ptr op) { \
+        const void* in, void* inout, uint8_t len, ccl_bf16_reduction_func_ptr op, float scale) { \
         if (len == 0) \
             return; \
         uint16_t mask = ((uint16_t)0xFFFF) >> (CCL_BF16_IN_M256 - len); \
         __m256i a = _mm256_maskz_loadu_epi16(mask, in); \
         __m256i b = _mm256_maskz_loadu_epi16(mask, inout); \
         __m256i res; \
-        ccl_bf16_reduce_inputs_##impl_type(&a, &b, &res, op); \
+        ccl_bf16_reduce_inputs_##impl_type(&a, &b, &res, op, scale); \
         _mm256_mask_storeu_epi16(inout, (__mmask16)mask, res); \
     } \
 \
     BF16_INLINE_TARGET_ATTRIBUTE_ALL void ccl_bf16_reduce_impl_##impl_type( \
-        const void* in_buf, void* inout_buf, size_t in_cnt, ccl_bf16_reduction_func_ptr op) { \
+        const void* in_buf, \
+        void* inout_buf, \
+        size_t in_cnt, \
+        ccl_bf16_reduction_func_ptr op, \
+        float scale) { \
         int i = 0; \
         for (i = 0; i <= (int)in_cnt - CCL_BF16_IN_M256; i += CCL_BF16_IN_M256) { \
-            ccl_bf16_reduce_main_##impl_type((uint16_t*)in_buf + i, (uint16_t*)inout_buf + i, op); \
+            ccl_bf16_reduce_main_##impl_type( \
+                (uint16_t*)in_buf + i, (uint16_t*)inout_buf + i, op, scale); \
         } \
         ccl_bf16_reduce_tile_##impl_type( \
-            (uint16_t*)in_buf + i, (uint16_t*)inout_buf + i, (uint8_t)(in_cnt - i), op); \
+            (uint16_t*)in_buf + i, (uint16_t*)inout_buf + i, (uint8_t)(in_cnt - i), op, scale); \
     }
 
 CCL_BF16_DEFINE_REDUCE_FUNC(avx512f);
@@ -118,32 +158,10 @@ CCL_BF16_DEFINE_REDUCE_FUNC(avx512f);
 CCL_BF16_DEFINE_REDUCE_FUNC(avx512bf);
 #endif // CCL_BF16_AVX512BF_COMPILER
 
-BF16_INLINE_TARGET_ATTRIBUTE_ALL void ccl_bf16_reduce_impl(const void* in_buf,
-                                                           void* inout_buf,
-                                                           size_t in_cnt,
-                                                           ccl::reduction op) {
-    ccl_bf16_reduction_func_ptr func = nullptr;
-    switch (op) {
-        case ccl::reduction::sum: func = &bf16_sum_wrap; break;
-        case ccl::reduction::prod: func = &bf16_prod_wrap; break;
-        case ccl::reduction::min: func = &bf16_min_wrap; break;
-        case ccl::reduction::max: func = &bf16_max_wrap; break;
-        default: CCL_FATAL("unexpected value ", ccl::utils::enum_to_underlying(op));
-    }
-
-    auto impl_type = ccl::global_data::env().bf16_impl_type;
-
-    if (impl_type == ccl_bf16_avx512f) {
-        ccl_bf16_reduce_impl_avx512f(in_buf, inout_buf, in_cnt, func);
-    }
-#ifdef CCL_BF16_AVX512BF_COMPILER
-    else if (impl_type == ccl_bf16_avx512bf) {
-        ccl_bf16_reduce_impl_avx512bf(in_buf, inout_buf, in_cnt, func);
-    }
-#endif // CCL_BF16_AVX512BF_COMPILER
-    else {
-        CCL_THROW("unexpected bf16_impl_type: ", impl_type);
-    }
-}
+BF16_TARGET_ATTRIBUTE_ALL void ccl_bf16_reduce_impl(const void* in_buf,
+                                                    void* inout_buf,
+                                                    size_t in_cnt,
+                                                    ccl::reduction op,
+                                                    size_t avg_divisor);
 
 #endif // CCL_BF16_COMPILER
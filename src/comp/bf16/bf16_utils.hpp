@@ -23,7 +23,12 @@
 #include <immintrin.h>
 #endif // CCL_BF16_COMPILER
 
-typedef enum { ccl_bf16_scalar = 0, ccl_bf16_avx512f, ccl_bf16_avx512bf } ccl_bf16_impl_type;
+typedef enum {
+    ccl_bf16_scalar = 0,
+    ccl_bf16_avx2,
+    ccl_bf16_avx512f,
+    ccl_bf16_avx512bf
+} ccl_bf16_impl_type;
 
 extern std::map<ccl_bf16_impl_type, std::string> bf16_impl_names;
 
@@ -33,11 +38,14 @@ __attribute__((__always_inline__)) inline std::set<ccl_bf16_impl_type> ccl_bf16_
     result.insert(ccl_bf16_scalar);
 
 #ifdef CCL_BF16_COMPILER
+    int is_avx2_enabled = 0;
     int is_avx512f_enabled = 0;
     int is_avx512bf_enabled = 0;
 
     uint32_t reg[4];
 
+    /* AVX2 capabilities for BF16 implementation */
+    /* CPUID.(EAX=07H, ECX=0):EBX.AVX2     [bit 05] */
     /* baseline AVX512 capabilities for BF16 implementation */
     /* CPUID.(EAX=07H, ECX=0):EBX.AVX512F  [bit 16] */
     /* CPUID.(EAX=07H, ECX=0):EBX.AVX512BW [bit 30] */
@@ -45,6 +53,7 @@ __attribute__((__always_inline__)) inline std::set<ccl_bf16_impl_type> ccl_bf16_
     __asm__ __volatile__("cpuid"
                          : "=a"(reg[0]), "=b"(reg[1]), "=c"(reg[2]), "=d"(reg[3])
                          : "a"(7), "c"(0));
+    is_avx2_enabled = (reg[1] & (1u << 5)) >> 5;
     is_avx512f_enabled = ((reg[1] & (1u << 16)) >> 16) & ((reg[1] & (1u << 30)) >> 30) &
                          ((reg[1] & (1u << 31)) >> 31);
 
@@ -57,6 +66,9 @@ __attribute__((__always_inline__)) inline std::set<ccl_bf16_impl_type> ccl_bf16_
     is_avx512bf_enabled = (reg[0] & (1 << 5)) >> 5;
 #endif // CCL_BF16_AVX512BF_COMPILER
 
+    if (is_avx2_enabled)
+        result.insert(ccl_bf16_avx2);
+
     if (is_avx512f_enabled)
         result.insert(ccl_bf16_avx512f);
 
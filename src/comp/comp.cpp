@@ -16,6 +16,7 @@
 #include "comp/bf16/bf16.hpp"
 #include "comp/comp.hpp"
 #include "comp/fp16/fp16.hpp"
+#include "comp/simd/simd.hpp"
 #include "common/log/log.hpp"
 #include "common/global/global.hpp"
 #include "common/utils/enums.hpp"
@@ -28,6 +29,20 @@
 #include <sycl/sycl.hpp>
 #endif // CCL_ENABLE_SYCL
 
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value, T>::type ccl_avg_value(T value,
+                                                                                  size_t divisor) {
+    using wide_t = typename std::conditional<std::is_signed<T>::value, int64_t, uint64_t>::type;
+    return static_cast<T>(static_cast<wide_t>(value) / static_cast<wide_t>(divisor));
+}
+
+template <typename T>
+inline typename std::enable_if<std::is_floating_point<T>::value, T>::type ccl_avg_value(
+    T value,
+    size_t divisor) {
+    return value / static_cast<T>(divisor);
+}
+
 #define CCL_REDUCE(type) \
     do { \
         type* in_buf_##type = (type*)in_buf; \
@@ -53,10 +68,31 @@
                     inout_buf_##type[i] = std::max(in_buf_##type[i], inout_buf_##type[i]); \
                 } \
                 break; \
+            case ccl::reduction::avg: \
+                if (avg_divisor > 1) { \
+                    for (i = 0; i < in_count; i++) { \
+                        inout_buf_##type[i] = ccl_avg_value<type>( \
+                            (type)(inout_buf_##type[i] + in_buf_##type[i]), avg_divisor); \
+                    } \
+                } \
+                else { \
+                    for (i = 0; i < in_count; i++) { \
+                        inout_buf_##type[i] += in_buf_##type[i]; \
+                    } \
+                } \
+                break; \
             default: CCL_FATAL("unexpected value ", ccl::utils::enum_to_underlying(reduction)); \
         } \
     } while (0)
 
+#define CCL_AVERAGE(type) \
+    do { \
+        type* buf_##type = (type*)buf; \
+        for (size_t i = 0; i < count; i++) { \
+            buf_##type[i] = ccl_avg_value<type>(buf_##type[i], divisor); \
+        } \
+    } while (0)
+
 ccl::status ccl_comp_copy(const void* in_buf, void* out_buf, size_t bytes, bool use_nontemporal) {
     if (bytes == 0) {
         return ccl::status::success;
@@ -80,7 +116,8 @@ ccl::status ccl_comp_reduce_regular(const void* in_buf,
                                     const ccl_datatype& dtype,
                                     ccl::reduction reduction,
                                     ccl::reduction_fn reduction_fn,
-                                    const ccl::fn_context* context) {
+                                    const ccl::fn_context* context,
+                                    size_t avg_divisor = 1) {
     if (reduction == ccl::reduction::custom) {
         CCL_THROW_IF_NOT(reduction_fn, "custom reduction requires user callback");
         reduction_fn(in_buf, in_count, inout_buf, out_count, dtype.idx(), context);
@@ -92,25 +129,34 @@ ccl::status ccl_comp_reduce_regular(const void* in_buf,
     ccl::profile::itt::event_start(comp_reduce_itt_event);
 #endif // CCL_ENABLE_ITT
 
+    /* vectorized kernel selected by CCL_REDUCE_SIMD, nullptr if there is no such kernel */
+    ccl_simd_reduce_fn simd_reduce_fn =
+        ccl_simd_get_reduce_fn(dtype.idx(), reduction, avg_divisor);
+
     size_t i;
-    switch (dtype.idx()) {
-        case ccl::datatype::int8: CCL_REDUCE(int8_t); break;
-        case ccl::datatype::uint8: CCL_REDUCE(uint8_t); break;
-        case ccl::datatype::int16: CCL_REDUCE(int16_t); break;
-        case ccl::datatype::uint16: CCL_REDUCE(uint16_t); break;
-        case ccl::datatype::int32: CCL_REDUCE(int32_t); break;
-        case ccl::datatype::uint32: CCL_REDUCE(uint32_t); break;
-        case ccl::datatype::int64: CCL_REDUCE(int64_t); break;
-        case ccl::datatype::uint64: CCL_REDUCE(uint64_t); break;
-        case ccl::datatype::float16:
-            ccl_fp16_reduce(in_buf, in_count, inout_buf, out_count, reduction);
-            break;
-        case ccl::datatype::float32: CCL_REDUCE(float); break;
-        case ccl::datatype::float64: CCL_REDUCE(double); break;
-        case ccl::datatype::bfloat16:
-            ccl_bf16_reduce(in_buf, in_count, inout_buf, out_count, reduction);
-            break;
-        default: CCL_FATAL("unexpected value ", dtype.idx()); break;
+    if (simd_reduce_fn) {
+        simd_reduce_fn(in_buf, inout_buf, in_count, avg_divisor);
+    }
+    else {
+        switch (dtype.idx()) {
+            case ccl::datatype::int8: CCL_REDUCE(int8_t); break;
+            case ccl::datatype::uint8: CCL_REDUCE(uint8_t); break;
+            case ccl::datatype::int16: CCL_REDUCE(int16_t); break;
+            case ccl::datatype::uint16: CCL_REDUCE(uint16_t); break;
+            case ccl::datatype::int32: CCL_REDUCE(int32_t); break;
+            case ccl::datatype::uint32: CCL_REDUCE(uint32_t); break;
+            case ccl::datatype::int64: CCL_REDUCE(int64_t); break;
+            case ccl::datatype::uint64: CCL_REDUCE(uint64_t); break;
+            case ccl::datatype::float16:
+                ccl_fp16_reduce(in_buf, in_count, inout_buf, out_count, reduction, avg_divisor);
+                break;
+            case ccl::datatype::float32: CCL_REDUCE(float); break;
+            case ccl::datatype::float64: CCL_REDUCE(double); break;
+            case ccl::datatype::bfloat16:
+                ccl_bf16_reduce(in_buf, in_count, inout_buf, out_count, reduction, avg_divisor);
+                break;
+            default: CCL_FATAL("unexpected value ", dtype.idx()); break;
+        }
     }
 
 #ifdef CCL_ENABLE_ITT
@@ -120,6 +166,49 @@ ccl::status ccl_comp_reduce_regular(const void* in_buf,
     return ccl::status::success;
 }
 
+ccl::status ccl_comp_average(void* buf, size_t count, const ccl_datatype& dtype, size_t divisor) {
+    if (count == 0 || divisor <= 1) {
+        return ccl::status::success;
+    }
+
+    CCL_ASSERT(buf, "buf is null");
+
+    switch (dtype.idx()) {
+        case ccl::datatype::int8: CCL_AVERAGE(int8_t); break;
+        case ccl::datatype::uint8: CCL_AVERAGE(uint8_t); break;
+        case ccl::datatype::int16: CCL_AVERAGE(int16_t); break;
+        case ccl::datatype::uint16: CCL_AVERAGE(uint16_t); break;
+        case ccl::datatype::int32: CCL_AVERAGE(int32_t); break;
+        case ccl::datatype::uint32: CCL_AVERAGE(uint32_t); break;
+        case ccl::datatype::int64: CCL_AVERAGE(int64_t); break;
+        case ccl::datatype::uint64: CCL_AVERAGE(uint64_t); break;
+        case ccl::datatype::float32: CCL_AVERAGE(float); break;
+        case ccl::datatype::float64: CCL_AVERAGE(double); break;
+        case ccl::datatype::float16:
+        case ccl::datatype::bfloat16: {
+            // reuse vectorized lp kernels: buf = (buf + 0) / divisor
+            static const uint16_t zeros[1024] = {};
+            const size_t zeros_count = sizeof(zeros) / sizeof(zeros[0]);
+            for (size_t offset = 0; offset < count; offset += zeros_count) {
+                size_t part_count = std::min(zeros_count, count - offset);
+                void* part_buf = static_cast<uint16_t*>(buf) + offset;
+                if (dtype.idx() == ccl::datatype::float16) {
+                    ccl_fp16_reduce(
+                        zeros, part_count, part_buf, nullptr, ccl::reduction::avg, divisor);
+                }
+                else {
+                    ccl_bf16_reduce(
+                        zeros, part_count, part_buf, nullptr, ccl::reduction::avg, divisor);
+                }
+            }
+            break;
+        }
+        default: CCL_FATAL("unexpected value ", dtype.idx()); break;
+    }
+
+    return ccl::status::success;
+}
+
 ccl::status ccl_comp_reduce(ccl_sched* sched,
                             const void* in_buf,
                             size_t in_count,
@@ -128,7 +217,8 @@ ccl::status ccl_comp_reduce(ccl_sched* sched,
                             const ccl_datatype& dtype,
                             ccl::reduction reduction,
                             ccl::reduction_fn reduction_fn,
-                            const ccl::fn_context* context) {
+                            const ccl::fn_context* context,
+                            size_t avg_divisor) {
     if (!in_count) {
         return ccl::status::success;
     }
@@ -137,8 +227,15 @@ ccl::status ccl_comp_reduce(ccl_sched* sched,
     ccl_stream* stream = (ccl_stream*)sched->coll_param.stream;
 
     if (!stream) {
-        return ccl_comp_reduce_regular(
-            in_buf, in_count, inout_buf, out_count, dtype, reduction, reduction_fn, context);
+        return ccl_comp_reduce_regular(in_buf,
+                                       in_count,
+                                       inout_buf,
+                                       out_count,
+                                       dtype,
+                                       reduction,
+                                       reduction_fn,
+                                       context,
+                                       avg_divisor);
     }
 
     sycl::queue* q = stream->get_native_stream(sched->queue->get_idx());
@@ -156,8 +253,15 @@ ccl::status ccl_comp_reduce(ccl_sched* sched,
               in_count)
 
     if ((in_ptr_type != sycl::usm::alloc::device) && (inout_ptr_type != sycl::usm::alloc::device)) {
-        return ccl_comp_reduce_regular(
-            in_buf, in_count, inout_buf, out_count, dtype, reduction, reduction_fn, context);
+        return ccl_comp_reduce_regular(in_buf,
+                                       in_count,
+                                       inout_buf,
+                                       out_count,
+                                       dtype,
+                                       reduction,
+                                       reduction_fn,
+                                       context,
+                                       avg_divisor);
     }
 
     void* host_in_buf = (void*)in_buf;
@@ -177,8 +281,15 @@ ccl::status ccl_comp_reduce(ccl_sched* sched,
         q->memcpy(host_inout_buf, inout_buf, bytes).wait();
     }
 
-    ccl_comp_reduce_regular(
-        host_in_buf, in_count, host_inout_buf, out_count, dtype, reduction, reduction_fn, context);
+    ccl_comp_reduce_regular(host_in_buf,
+                            in_count,
+                            host_inout_buf,
+                            out_count,
+                            dtype,
+                            reduction,
+                            reduction_fn,
+                            context,
+                            avg_divisor);
 
     if (host_in_buf != in_buf) {
         dealloc_param.ptr = host_in_buf;
@@ -194,8 +305,15 @@ ccl::status ccl_comp_reduce(ccl_sched* sched,
     return ccl::status::success;
 
 #else // CCL_ENABLE_SYCL
-    return ccl_comp_reduce_regular(
-        in_buf, in_count, inout_buf, out_count, dtype, reduction, reduction_fn, context);
+    return ccl_comp_reduce_regular(in_buf,
+                                   in_count,
+                                   inout_buf,
+                                   out_count,
+                                   dtype,
+                                   reduction,
+                                   reduction_fn,
+                                   context,
+                                   avg_divisor);
 #endif // CCL_ENABLE_SYCL
 }
 
@@ -254,6 +372,7 @@ const char* ccl_reduction_to_str(ccl::reduction type) {
         case ccl::reduction::prod: return "prod";
         case ccl::reduction::min: return "min";
         case ccl::reduction::max: return "max";
+        case ccl::reduction::avg: return "avg";
         case ccl::reduction::custom: return "custom";
         default: return "unknown";
     }
@@ -25,6 +25,8 @@ ccl::status ccl_comp_copy(const void* in_buf,
                           size_t count,
                           bool use_nontemporal = false);
 
+/* avg is reduced as sum, the result is additionally divided
+   by avg_divisor on the final reduction step (avg_divisor > 1) */
 ccl::status ccl_comp_reduce(ccl_sched* sched,
                             const void* in_buf,
                             size_t in_count,
@@ -33,7 +35,12 @@ ccl::status ccl_comp_reduce(ccl_sched* sched,
                             const ccl_datatype& dtype,
                             ccl::reduction reduction,
                             ccl::reduction_fn reduction_fn,
-                            const ccl::fn_context* context = nullptr);
+                            const ccl::fn_context* context = nullptr,
+                            size_t avg_divisor = 1);
+
+/* in-place division of already reduced data, used when the final step
+   is done outside of ccl_comp_reduce (e.g. by ATL) */
+ccl::status ccl_comp_average(void* buf, size_t count, const ccl_datatype& dtype, size_t divisor);
 
 ccl::status ccl_comp_batch_reduce(const void* in_buf,
                                   const std::vector<size_t>& offsets,
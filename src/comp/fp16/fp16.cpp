@@ -42,14 +42,15 @@ void ccl_fp16_reduce(const void* in_buf,
                      size_t in_cnt,
                      void* inout_buf,
                      size_t* out_cnt,
-                     ccl::reduction op) {
+                     ccl::reduction op,
+                     size_t avg_divisor) {
     LOG_DEBUG("FP16 reduction for ", in_cnt, " elements");
 
     if (out_cnt != nullptr) {
         *out_cnt = in_cnt;
     }
 
-    ccl_fp16_reduce_impl(in_buf, inout_buf, in_cnt, op);
+    ccl_fp16_reduce_impl(in_buf, inout_buf, in_cnt, op, avg_divisor);
 }
 
 void ccl_convert_fp32_to_fp16(const void* src, void* dst) {
@@ -66,7 +67,8 @@ void ccl_fp16_reduce(const void* in_buf,
                      size_t in_cnt,
                      void* inout_buf,
                      size_t* out_cnt,
-                     ccl::reduction op) {
+                     ccl::reduction op,
+                     size_t avg_divisor) {
     CCL_FATAL("FP16 reduction was requested but CCL was compiled w/o FP16 support");
 }
 
@@ -22,7 +22,8 @@ void ccl_fp16_reduce(const void* in_buf,
                      size_t in_cnt,
                      void* inout_buf,
                      size_t* out_cnt,
-                     ccl::reduction reduction_op);
+                     ccl::reduction reduction_op,
+                     size_t avg_divisor = 1);
 __attribute__((target("f16c"))) void ccl_convert_fp32_to_fp16(const void* src, void* dst);
 __attribute__((target("f16c"))) void ccl_convert_fp16_to_fp32(const void* src, void* dst);
 #else // CCL_FP16_TARGET_ATTRIBUTES
@@ -30,7 +31,8 @@ void ccl_fp16_reduce(const void* in_buf,
                      size_t in_cnt,
                      void* inout_buf,
                      size_t* out_cnt,
-                     ccl::reduction reduction_op);
+                     ccl::reduction reduction_op,
+                     size_t avg_divisor = 1);
 void ccl_convert_fp32_to_fp16(const void* src, void* dst);
 void ccl_convert_fp16_to_fp32(const void* src, void* dst);
 #endif // CCL_FP16_TARGET_ATTRIBUTES
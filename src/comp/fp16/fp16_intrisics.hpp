@@ -96,11 +96,15 @@ FP16_INLINE_TARGET_ATTRIBUTE_F16C void ccl_fp16_reduce_inputs_256(
     const void* a,
     const void* b,
     void* res,
-    ccl_fp16_reduction_func_ptr_256 op) {
+    ccl_fp16_reduction_func_ptr_256 op,
+    float scale) {
     __m256 vfp32_in, vfp32_inout;
     vfp32_in = (__m256)(_mm256_cvtph_ps(_mm_loadu_si128((__m128i*)a)));
     vfp32_inout = (__m256)(_mm256_cvtph_ps(_mm_loadu_si128((__m128i*)b)));
     __m256 vfp32_out = fp16_reduce_256(vfp32_in, vfp32_inout, op);
+    if (scale != 1.0f) {
+        vfp32_out = _mm256_mul_ps(vfp32_out, _mm256_set1_ps(scale));
+    }
     _mm_storeu_si128((__m128i*)(res), _mm256_cvtps_ph(vfp32_out, 0));
 }
 
@@ -108,7 +112,8 @@ FP16_INLINE_TARGET_ATTRIBUTE_F16C void ccl_fp16_reduce_tile_256(
     const void* in,
     void* inout,
     uint8_t len,
-    ccl_fp16_reduction_func_ptr_256 op) {
+    ccl_fp16_reduction_func_ptr_256 op,
+    float scale) {
     if (len == 0)
         return;
     uint16_t a[CCL_FP16_STEP_256];
@@ -116,7 +121,7 @@ FP16_INLINE_TARGET_ATTRIBUTE_F16C void ccl_fp16_reduce_tile_256(
     uint16_t res[CCL_FP16_STEP_256];
     memcpy(a, in, len * sizeof(uint16_t));
     memcpy(b, inout, len * sizeof(uint16_t));
-    ccl_fp16_reduce_inputs_256(a, b, res, op);
+    ccl_fp16_reduce_inputs_256(a, b, res, op, scale);
     memcpy(inout, res, len * sizeof(uint16_t));
 }
 
@@ -124,11 +129,15 @@ FP16_INLINE_TARGET_ATTRIBUTE_AVX512F void ccl_fp16_reduce_inputs_512(
     const void* a,
     const void* b,
     void* res,
-    ccl_fp16_reduction_func_ptr_512 op) {
+    ccl_fp16_reduction_func_ptr_512 op,
+    float scale) {
     __m512 vfp32_in, vfp32_inout;
     vfp32_in = (__m512)(_mm512_cvtph_ps(_mm256_loadu_si256((__m256i*)a)));
     vfp32_inout = (__m512)(_mm512_cvtph_ps(_mm256_loadu_si256((__m256i*)b)));
     __m512 vfp32_out = fp16_reduce_512(vfp32_in, vfp32_inout, op);
+    if (scale != 1.0f) {
+        vfp32_out = _mm512_mul_ps(vfp32_out, _mm512_set1_ps(scale));
+    }
     _mm256_storeu_si256((__m256i*)(res), _mm512_cvtps_ph(vfp32_out, 0));
 }
 
@@ -136,14 +145,15 @@ FP16_INLINE_TARGET_ATTRIBUTE_AVX512F void ccl_fp16_reduce_tile_512(
     const void* in,
     void* inout,
     uint8_t len,
-    ccl_fp16_reduction_func_ptr_512 op) {
+    ccl_fp16_reduction_func_ptr_512 op,
+    float scale) {
     if (len == 0)
         return;
     uint16_t mask = ((uint16_t)0xFFFF) >> (CCL_FP16_STEP_512 - len);
     __m256i a = _mm256_maskz_loadu_epi16(mask, in);
     __m256i b = _mm256_maskz_loadu_epi16(mask, inout);
     __m256i res;
-    ccl_fp16_reduce_inputs_512(&a, &b, &res, op);
+    ccl_fp16_reduce_inputs_512(&a, &b, &res, op, scale);
     _mm256_mask_storeu_epi16(inout, (__mmask16)mask, res);
 }
 
@@ -152,11 +162,15 @@ FP16_INLINE_TARGET_ATTRIBUTE_AVX512FP16 void ccl_fp16_reduce_inputs_512FP16(
     const void* a,
     const void* b,
     void* res,
-    ccl_fp16_reduction_func_ptr_512FP16 op) {
+    ccl_fp16_reduction_func_ptr_512FP16 op,
+    float scale) {
     __m512h vfp16_in, vfp16_inout;
     vfp16_in = _mm512_loadu_ph(a);
     vfp16_inout = _mm512_loadu_ph(b);
     __m512h vfp16_out = fp16_reduce_512FP16(vfp16_in, vfp16_inout, op);
+    if (scale != 1.0f) {
+        vfp16_out = _mm512_mul_ph(vfp16_out, _mm512_set1_ph((_Float16)scale));
+    }
     _mm512_storeu_ph(res, vfp16_out);
 }
 
@@ -164,35 +178,40 @@ FP16_INLINE_TARGET_ATTRIBUTE_AVX512FP16 void ccl_fp16_reduce_tile_512FP16(
     const void* in,
     void* inout,
     uint8_t len,
-    ccl_fp16_reduction_func_ptr_512FP16 op) {
+    ccl_fp16_reduction_func_ptr_512FP16 op,
+    float scale) {
     if (len == 0)
         return;
     uint32_t mask = ((uint32_t)0xFFFFFFFF) >> (CCL_FP16_STEP_512FP16 - len);
     __m512i a = _mm512_maskz_loadu_epi16(mask, in);
     __m512i b = _mm512_maskz_loadu_epi16(mask, inout);
     __m512i res;
-    ccl_fp16_reduce_inputs_512FP16(&a, &b, &res, op);
+    ccl_fp16_reduce_inputs_512FP16(&a, &b, &res, op, scale);
     _mm512_mask_storeu_epi16(inout, (__mmask32)mask, res);
 }
 #endif // CCL_FP16_AVX512FP16_COMPILER
 
 #define CCL_FP16_DEFINE_REDUCE_FUNC(VLEN) \
 \
-    void inline ccl_fp16_reduce_main_##VLEN( \
-        const void* in, const void* inout, ccl_fp16_reduction_func_ptr_##VLEN op) { \
-        ccl_fp16_reduce_inputs_##VLEN(in, inout, (void*)inout, op); \
+    void inline ccl_fp16_reduce_main_##VLEN(const void* in, \
+                                            const void* inout, \
+                                            ccl_fp16_reduction_func_ptr_##VLEN op, \
+                                            float scale) { \
+        ccl_fp16_reduce_inputs_##VLEN(in, inout, (void*)inout, op, scale); \
     } \
 \
     void inline ccl_fp16_reduce_impl_##VLEN(const void* in_buf, \
                                             void* inout_buf, \
                                             size_t in_cnt, \
-                                            ccl_fp16_reduction_func_ptr_##VLEN op) { \
+                                            ccl_fp16_reduction_func_ptr_##VLEN op, \
+                                            float scale) { \
         int i = 0; \
         for (i = 0; i <= (int)in_cnt - CCL_FP16_STEP_##VLEN; i += CCL_FP16_STEP_##VLEN) { \
-            ccl_fp16_reduce_main_##VLEN((uint16_t*)in_buf + i, (uint16_t*)inout_buf + i, op); \
+            ccl_fp16_reduce_main_##VLEN( \
+                (uint16_t*)in_buf + i, (uint16_t*)inout_buf + i, op, scale); \
         } \
         ccl_fp16_reduce_tile_##VLEN( \
-            (uint16_t*)in_buf + i, (uint16_t*)inout_buf + i, (uint8_t)(in_cnt - i), op); \
+            (uint16_t*)in_buf + i, (uint16_t*)inout_buf + i, (uint8_t)(in_cnt - i), op, scale); \
     }
 
 #ifdef CCL_FP16_AVX512FP16_COMPILER
@@ -204,7 +223,11 @@ CCL_FP16_DEFINE_REDUCE_FUNC(256);
 void inline ccl_fp16_reduce_impl(const void* in_buf,
                                  void* inout_buf,
                                  size_t in_cnt,
-                                 ccl::reduction op) {
+                                 ccl::reduction op,
+                                 size_t avg_divisor) {
+    /* avg is reduced as sum and scaled in the same pass */
+    float scale = (op == ccl::reduction::avg && avg_divisor > 1) ? 1.0f / avg_divisor : 1.0f;
+
     ccl_fp16_reduction_func_ptr_256 func_256 = nullptr;
     ccl_fp16_reduction_func_ptr_512 func_512 = nullptr;
 #ifdef CCL_FP16_AVX512FP16_COMPILER
@@ -215,34 +238,37 @@ void inline ccl_fp16_reduce_impl(const void* in_buf,
 
     if (impl_type == ccl_fp16_f16c) {
         switch (op) {
-            case ccl::reduction::sum: func_256 = &fp16_sum_wrap_256; break;
+            case ccl::reduction::sum:
+            case ccl::reduction::avg: func_256 = &fp16_sum_wrap_256; break;
             case ccl::reduction::prod: func_256 = &fp16_prod_wrap_256; break;
             case ccl::reduction::min: func_256 = &fp16_min_wrap_256; break;
             case ccl::reduction::max: func_256 = &fp16_max_wrap_256; break;
             default: CCL_FATAL("unexpected value ", ccl::utils::enum_to_underlying(op));
         }
-        ccl_fp16_reduce_impl_256(in_buf, inout_buf, in_cnt, func_256);
+        ccl_fp16_reduce_impl_256(in_buf, inout_buf, in_cnt, func_256, scale);
     }
     else if (impl_type == ccl_fp16_avx512f) {
         switch (op) {
-            case ccl::reduction::sum: func_512 = &fp16_sum_wrap_512; break;
+            case ccl::reduction::sum:
+            case ccl::reduction::avg: func_512 = &fp16_sum_wrap_512; break;
             case ccl::reduction::prod: func_512 = &fp16_prod_wrap_512; break;
             case ccl::reduction::min: func_512 = &fp16_min_wrap_512; break;
             case ccl::reduction::max: func_512 = &fp16_max_wrap_512; break;
             default: CCL_FATAL("unexpected value ", ccl::utils::enum_to_underlying(op));
         }
-        ccl_fp16_reduce_impl_512(in_buf, inout_buf, in_cnt, func_512);
+        ccl_fp16_reduce_impl_512(in_buf, inout_buf, in_cnt, func_512, scale);
     }
 #ifdef CCL_FP16_AVX512FP16_COMPILER
     else if (impl_type == ccl_fp16_avx512fp16) {
         switch (op) {
-            case ccl::reduction::sum: func_512FP16 = &fp16_sum_wrap_512FP16; break;
+            case ccl::reduction::sum:
+            case ccl::reduction::avg: func_512FP16 = &fp16_sum_wrap_512FP16; break;
             case ccl::reduction::prod: func_512FP16 = &fp16_prod_wrap_512FP16; break;
             case ccl::reduction::min: func_512FP16 = &fp16_min_wrap_512FP16; break;
             case ccl::reduction::max: func_512FP16 = &fp16_max_wrap_512FP16; break;
             default: CCL_FATAL("unexpected value ", ccl::utils::enum_to_underlying(op));
         }
-        ccl_fp16_reduce_impl_512FP16(in_buf, inout_buf, in_cnt, func_512FP16);
+        ccl_fp16_reduce_impl_512FP16(in_buf, inout_buf, in_cnt, func_512FP16, scale);
     }
 #endif // CCL_FP16_AVX512FP16_COMPILER
 }
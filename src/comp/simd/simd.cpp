@@ -0,0 +1,367 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include "common/global/global.hpp"
+#include "common/log/log.hpp"
+#include "comp/simd/simd.hpp"
+#include "comp/simd/simd_utils.hpp"
+
+#include <algorithm>
+
+#ifdef CCL_AVX_COMPILER
+#include <immintrin.h>
+#endif // CCL_AVX_COMPILER
+
+std::map<ccl_simd_impl_type, std::string> simd_impl_names = {
+    std::make_pair(ccl_simd_scalar, "scalar"),
+    std::make_pair(ccl_simd_avx2, "avx2"),
+    std::make_pair(ccl_simd_avx512, "avx512")
+};
+
+#ifdef CCL_AVX_COMPILER
+
+#ifdef CCL_AVX_TARGET_ATTRIBUTES
+#define SIMD_TARGET_ATTRIBUTE_avx2   __attribute__((target("avx2")))
+#define SIMD_TARGET_ATTRIBUTE_avx512 __attribute__((target("avx512f,avx512bw,avx512dq")))
+#else // CCL_AVX_TARGET_ATTRIBUTES
+#define SIMD_TARGET_ATTRIBUTE_avx2
+#define SIMD_TARGET_ATTRIBUTE_avx512
+#endif // CCL_AVX_TARGET_ATTRIBUTES
+
+/* number of vectors processed per iteration of the main loop */
+#define SIMD_UNROLL 4
+
+/* vector type and unaligned memory access per ISA and element kind:
+   si - integers, ps - float, pd - double */
+#define SIMD_VEC_avx2_si           __m256i
+#define SIMD_VEC_avx2_ps           __m256
+#define SIMD_VEC_avx2_pd           __m256d
+#define SIMD_LOAD_avx2_si(p)       _mm256_loadu_si256((const __m256i*)(p))
+#define SIMD_LOAD_avx2_ps(p)       _mm256_loadu_ps((const float*)(p))
+#define SIMD_LOAD_avx2_pd(p)       _mm256_loadu_pd((const double*)(p))
+#define SIMD_STORE_avx2_si(p, v)   _mm256_storeu_si256((__m256i*)(p), v)
+#define SIMD_STORE_avx2_ps(p, v)   _mm256_storeu_ps((float*)(p), v)
+#define SIMD_STORE_avx2_pd(p, v)   _mm256_storeu_pd((double*)(p), v)
+#define SIMD_VEC_avx512_si         __m512i
+#define SIMD_VEC_avx512_ps         __m512
+#define SIMD_VEC_avx512_pd         __m512d
+#define SIMD_LOAD_avx512_si(p)     _mm512_loadu_si512((const void*)(p))
+#define SIMD_LOAD_avx512_ps(p)     _mm512_loadu_ps((const void*)(p))
+#define SIMD_LOAD_avx512_pd(p)     _mm512_loadu_pd((const void*)(p))
+#define SIMD_STORE_avx512_si(p, v) _mm512_storeu_si512((void*)(p), v)
+#define SIMD_STORE_avx512_ps(p, v) _mm512_storeu_ps((void*)(p), v)
+#define SIMD_STORE_avx512_pd(p, v) _mm512_storeu_pd((void*)(p), v)
+
+/* scalar ops for head/tail, a is inout, b is in (same order as in CCL_REDUCE) */
+#define SIMD_SCALAR_SUM(a, b)  static_cast<elem_t>((a) + (b))
+#define SIMD_SCALAR_PROD(a, b) static_cast<elem_t>((a) * (b))
+#define SIMD_SCALAR_MIN(a, b)  std::min((b), (a))
+#define SIMD_SCALAR_MAX(a, b)  std::max((b), (a))
+#define SIMD_SCALAR_AVG(a, b)  (((a) + (b)) / elem_div)
+
+/* avg is defined only for floating point types, integer avg uses scalar code */
+#define SIMD_AVG_avx2_ps(a, b)   _mm256_div_ps(_mm256_add_ps(a, b), vec_div)
+#define SIMD_AVG_avx2_pd(a, b)   _mm256_div_pd(_mm256_add_pd(a, b), vec_div)
+#define SIMD_AVG_avx512_ps(a, b) _mm512_div_ps(_mm512_add_ps(a, b), vec_div)
+#define SIMD_AVG_avx512_pd(a, b) _mm512_div_pd(_mm512_add_pd(a, b), vec_div)
+
+#define SIMD_NO_INIT (void)0
+
+#define SIMD_DEFINE_REDUCE_FUNC(isa, kind, type, name, VEC_OP, SCALAR_OP, VEC_INIT) \
+    SIMD_TARGET_ATTRIBUTE_##isa void ccl_simd_reduce_##name##_##type##_##isa( \
+        const void* in_buf, void* inout_buf, size_t count, size_t avg_divisor) { \
+        typedef type elem_t; \
+        typedef SIMD_VEC_##isa##_##kind vec_t; \
+        const elem_t* in = static_cast<const elem_t*>(in_buf); \
+        elem_t* inout = static_cast<elem_t*>(inout_buf); \
+        const elem_t elem_div = static_cast<elem_t>(avg_divisor); \
+        (void)elem_div; \
+        VEC_INIT; \
+        const size_t step = sizeof(vec_t) / sizeof(elem_t); \
+        size_t i = 0; \
+        /* scalar head to align inout on vector size */ \
+        uintptr_t inout_addr = reinterpret_cast<uintptr_t>(inout); \
+        if (inout_addr % sizeof(elem_t) == 0) { \
+            size_t head = ((sizeof(vec_t) - inout_addr % sizeof(vec_t)) % sizeof(vec_t)) / \
+                          sizeof(elem_t); \
+            for (head = std::min(head, count); i < head; i++) { \
+                inout[i] = SCALAR_OP(inout[i], in[i]); \
+            } \
+        } \
+        for (; i + SIMD_UNROLL * step <= count; i += SIMD_UNROLL * step) { \
+            vec_t a0 = SIMD_LOAD_##isa##_##kind(inout + i); \
+            vec_t a1 = SIMD_LOAD_##isa##_##kind(inout + i + step); \
+            vec_t a2 = SIMD_LOAD_##isa##_##kind(inout + i + 2 * step); \
+            vec_t a3 = SIMD_LOAD_##isa##_##kind(inout + i + 3 * step); \
+            vec_t b0 = SIMD_LOAD_##isa##_##kind(in + i); \
+            vec_t b1 = SIMD_LOAD_##isa##_##kind(in + i + step); \
+            vec_t b2 = SIMD_LOAD_##isa##_##kind(in + i + 2 * step); \
+            vec_t b3 = SIMD_LOAD_##isa##_##kind(in + i + 3 * step); \
+            SIMD_STORE_##isa##_##kind(inout + i, VEC_OP(a0, b0)); \
+            SIMD_STORE_##isa##_##kind(inout + i + step, VEC_OP(a1, b1)); \
+            SIMD_STORE_##isa##_##kind(inout + i + 2 * step, VEC_OP(a2, b2)); \
+            SIMD_STORE_##isa##_##kind(inout + i + 3 * step, VEC_OP(a3, b3)); \
+        } \
+        for (; i + step <= count; i += step) { \
+            vec_t a = SIMD_LOAD_##isa##_##kind(inout + i); \
+            vec_t b = SIMD_LOAD_##isa##_##kind(in + i); \
+            SIMD_STORE_##isa##_##kind(inout + i, VEC_OP(a, b)); \
+        } \
+        /* scalar tail */ \
+        for (; i < count; i++) { \
+            inout[i] = SCALAR_OP(inout[i], in[i]); \
+        } \
+    }
+
+/* AVX2 has no 64-bit integer min/max, emulate them through compare + blend */
+SIMD_TARGET_ATTRIBUTE_avx2 static inline __m256i ccl_simd_cmpgt_epu64_avx2(__m256i a, __m256i b) {
+    const __m256i sign = _mm256_set1_epi64x(static_cast<long long>(1ULL << 63));
+    return _mm256_cmpgt_epi64(_mm256_xor_si256(a, sign), _mm256_xor_si256(b, sign));
+}
+SIMD_TARGET_ATTRIBUTE_avx2 static inline __m256i ccl_simd_min_epi64_avx2(__m256i a, __m256i b) {
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+}
+SIMD_TARGET_ATTRIBUTE_avx2 static inline __m256i ccl_simd_max_epi64_avx2(__m256i a, __m256i b) {
+    return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+}
+SIMD_TARGET_ATTRIBUTE_avx2 static inline __m256i ccl_simd_min_epu64_avx2(__m256i a, __m256i b) {
+    return _mm256_blendv_epi8(a, b, ccl_simd_cmpgt_epu64_avx2(a, b));
+}
+SIMD_TARGET_ATTRIBUTE_avx2 static inline __m256i ccl_simd_max_epu64_avx2(__m256i a, __m256i b) {
+    return _mm256_blendv_epi8(b, a, ccl_simd_cmpgt_epu64_avx2(a, b));
+}
+
+#define SIMD_DEFINE_INT_FUNCS(isa, type, add_op, mul_op, min_op, max_op) \
+    SIMD_DEFINE_REDUCE_FUNC(isa, si, type, sum, add_op, SIMD_SCALAR_SUM, SIMD_NO_INIT) \
+    SIMD_DEFINE_REDUCE_FUNC(isa, si, type, prod, mul_op, SIMD_SCALAR_PROD, SIMD_NO_INIT) \
+    SIMD_DEFINE_REDUCE_FUNC(isa, si, type, min, min_op, SIMD_SCALAR_MIN, SIMD_NO_INIT) \
+    SIMD_DEFINE_REDUCE_FUNC(isa, si, type, max, max_op, SIMD_SCALAR_MAX, SIMD_NO_INIT)
+
+/* for types without vector multiplication */
+#define SIMD_DEFINE_INT_FUNCS_NO_PROD(isa, type, add_op, min_op, max_op) \
+    SIMD_DEFINE_REDUCE_FUNC(isa, si, type, sum, add_op, SIMD_SCALAR_SUM, SIMD_NO_INIT) \
+    SIMD_DEFINE_REDUCE_FUNC(isa, si, type, min, min_op, SIMD_SCALAR_MIN, SIMD_NO_INIT) \
+    SIMD_DEFINE_REDUCE_FUNC(isa, si, type, max, max_op, SIMD_SCALAR_MAX, SIMD_NO_INIT)
+
+#define SIMD_DEFINE_FP_FUNCS(isa, kind, type, add_op, mul_op, min_op, max_op, set1) \
+    SIMD_DEFINE_REDUCE_FUNC(isa, kind, type, sum, add_op, SIMD_SCALAR_SUM, SIMD_NO_INIT) \
+    SIMD_DEFINE_REDUCE_FUNC(isa, kind, type, prod, mul_op, SIMD_SCALAR_PROD, SIMD_NO_INIT) \
+    SIMD_DEFINE_REDUCE_FUNC(isa, kind, type, min, min_op, SIMD_SCALAR_MIN, SIMD_NO_INIT) \
+    SIMD_DEFINE_REDUCE_FUNC(isa, kind, type, max, max_op, SIMD_SCALAR_MAX, SIMD_NO_INIT) \
+    SIMD_DEFINE_REDUCE_FUNC(isa, \
+                            kind, \
+                            type, \
+                            avg, \
+                            SIMD_AVG_##isa##_##kind, \
+                            SIMD_SCALAR_AVG, \
+                            const vec_t vec_div = set1(elem_div))
+
+SIMD_DEFINE_INT_FUNCS_NO_PROD(avx2, int8_t, _mm256_add_epi8, _mm256_min_epi8, _mm256_max_epi8);
+SIMD_DEFINE_INT_FUNCS_NO_PROD(avx2, uint8_t, _mm256_add_epi8, _mm256_min_epu8, _mm256_max_epu8);
+SIMD_DEFINE_INT_FUNCS(avx2,
+                      int16_t,
+                      _mm256_add_epi16,
+                      _mm256_mullo_epi16,
+                      _mm256_min_epi16,
+                      _mm256_max_epi16);
+SIMD_DEFINE_INT_FUNCS(avx2,
+                      uint16_t,
+                      _mm256_add_epi16,
+                      _mm256_mullo_epi16,
+                      _mm256_min_epu16,
+                      _mm256_max_epu16);
+SIMD_DEFINE_INT_FUNCS(avx2,
+                      int32_t,
+                      _mm256_add_epi32,
+                      _mm256_mullo_epi32,
+                      _mm256_min_epi32,
+                      _mm256_max_epi32);
+SIMD_DEFINE_INT_FUNCS(avx2,
+                      uint32_t,
+                      _mm256_add_epi32,
+                      _mm256_mullo_epi32,
+                      _mm256_min_epu32,
+                      _mm256_max_epu32);
+SIMD_DEFINE_INT_FUNCS_NO_PROD(avx2,
+                              int64_t,
+                              _mm256_add_epi64,
+                              ccl_simd_min_epi64_avx2,
+                              ccl_simd_max_epi64_avx2);
+SIMD_DEFINE_INT_FUNCS_NO_PROD(avx2,
+                              uint64_t,
+                              _mm256_add_epi64,
+                              ccl_simd_min_epu64_avx2,
+                              ccl_simd_max_epu64_avx2);
+SIMD_DEFINE_FP_FUNCS(avx2,
+                     ps,
+                     float,
+                     _mm256_add_ps,
+                     _mm256_mul_ps,
+                     _mm256_min_ps,
+                     _mm256_max_ps,
+                     _mm256_set1_ps);
+SIMD_DEFINE_FP_FUNCS(avx2,
+                     pd,
+                     double,
+                     _mm256_add_pd,
+                     _mm256_mul_pd,
+                     _mm256_min_pd,
+                     _mm256_max_pd,
+                     _mm256_set1_pd);
+
+SIMD_DEFINE_INT_FUNCS_NO_PROD(avx512, int8_t, _mm512_add_epi8, _mm512_min_epi8, _mm512_max_epi8);
+SIMD_DEFINE_INT_FUNCS_NO_PROD(avx512, uint8_t, _mm512_add_epi8, _mm512_min_epu8, _mm512_max_epu8);
+SIMD_DEFINE_INT_FUNCS(avx512,
+                      int16_t,
+                      _mm512_add_epi16,
+                      _mm512_mullo_epi16,
+                      _mm512_min_epi16,
+                      _mm512_max_epi16);
+SIMD_DEFINE_INT_FUNCS(avx512,
+                      uint16_t,
+                      _mm512_add_epi16,
+                      _mm512_mullo_epi16,
+                      _mm512_min_epu16,
+                      _mm512_max_epu16);
+SIMD_DEFINE_INT_FUNCS(avx512,
+                      int32_t,
+                      _mm512_add_epi32,
+                      _mm512_mullo_epi32,
+                      _mm512_min_epi32,
+                      _mm512_max_epi32);
+SIMD_DEFINE_INT_FUNCS(avx512,
+                      uint32_t,
+                      _mm512_add_epi32,
+                      _mm512_mullo_epi32,
+                      _mm512_min_epu32,
+                      _mm512_max_epu32);
+SIMD_DEFINE_INT_FUNCS(avx512,
+                      int64_t,
+                      _mm512_add_epi64,
+                      _mm512_mullo_epi64,
+                      _mm512_min_epi64,
+                      _mm512_max_epi64);
+SIMD_DEFINE_INT_FUNCS(avx512,
+                      uint64_t,
+                      _mm512_add_epi64,
+                      _mm512_mullo_epi64,
+                      _mm512_min_epu64,
+                      _mm512_max_epu64);
+SIMD_DEFINE_FP_FUNCS(avx512,
+                     ps,
+                     float,
+                     _mm512_add_ps,
+                     _mm512_mul_ps,
+                     _mm512_min_ps,
+                     _mm512_max_ps,
+                     _mm512_set1_ps);
+SIMD_DEFINE_FP_FUNCS(avx512,
+                     pd,
+                     double,
+                     _mm512_add_pd,
+                     _mm512_mul_pd,
+                     _mm512_min_pd,
+                     _mm512_max_pd,
+                     _mm512_set1_pd);
+
+#define SIMD_FN(name, type, isa) &ccl_simd_reduce_##name##_##type##_##isa
+
+#define SIMD_SELECT(sum_fn, prod_fn, min_fn, max_fn, avg_fn) \
+    do { \
+        switch (reduction) { \
+            case ccl::reduction::sum: return sum_fn; \
+            case ccl::reduction::prod: return prod_fn; \
+            case ccl::reduction::min: return min_fn; \
+            case ccl::reduction::max: return max_fn; \
+            case ccl::reduction::avg: return avg_fn; \
+            default: return nullptr; \
+        } \
+    } while (0)
+
+#define SIMD_SELECT_INT(type, isa) \
+    SIMD_SELECT(SIMD_FN(sum, type, isa), \
+                SIMD_FN(prod, type, isa), \
+                SIMD_FN(min, type, isa), \
+                SIMD_FN(max, type, isa), \
+                nullptr)
+
+#define SIMD_SELECT_INT_NO_PROD(type, isa) \
+    SIMD_SELECT(SIMD_FN(sum, type, isa), \
+                nullptr, \
+                SIMD_FN(min, type, isa), \
+                SIMD_FN(max, type, isa), \
+                nullptr)
+
+#define SIMD_SELECT_FP(type, isa) \
+    SIMD_SELECT(SIMD_FN(sum, type, isa), \
+                SIMD_FN(prod, type, isa), \
+                SIMD_FN(min, type, isa), \
+                SIMD_FN(max, type, isa), \
+                SIMD_FN(avg, type, isa))
+
+static ccl_simd_reduce_fn ccl_simd_get_reduce_fn_avx2(ccl::datatype dtype,
+                                                      ccl::reduction reduction) {
+    switch (dtype) {
+        case ccl::datatype::int8: SIMD_SELECT_INT_NO_PROD(int8_t, avx2);
+        case ccl::datatype::uint8: SIMD_SELECT_INT_NO_PROD(uint8_t, avx2);
+        case ccl::datatype::int16: SIMD_SELECT_INT(int16_t, avx2);
+        case ccl::datatype::uint16: SIMD_SELECT_INT(uint16_t, avx2);
+        case ccl::datatype::int32: SIMD_SELECT_INT(int32_t, avx2);
+        case ccl::datatype::uint32: SIMD_SELECT_INT(uint32_t, avx2);
+        case ccl::datatype::int64: SIMD_SELECT_INT_NO_PROD(int64_t, avx2);
+        case ccl::datatype::uint64: SIMD_SELECT_INT_NO_PROD(uint64_t, avx2);
+        case ccl::datatype::float32: SIMD_SELECT_FP(float, avx2);
+        case ccl::datatype::float64: SIMD_SELECT_FP(double, avx2);
+        default: return nullptr;
+    }
+}
+
+static ccl_simd_reduce_fn ccl_simd_get_reduce_fn_avx512(ccl::datatype dtype,
+                                                        ccl::reduction reduction) {
+    switch (dtype) {
+        case ccl::datatype::int8: SIMD_SELECT_INT_NO_PROD(int8_t, avx512);
+        case ccl::datatype::uint8: SIMD_SELECT_INT_NO_PROD(uint8_t, avx512);
+        case ccl::datatype::int16: SIMD_SELECT_INT(int16_t, avx512);
+        case ccl::datatype::uint16: SIMD_SELECT_INT(uint16_t, avx512);
+        case ccl::datatype::int32: SIMD_SELECT_INT(int32_t, avx512);
+        case ccl::datatype::uint32: SIMD_SELECT_INT(uint32_t, avx512);
+        case ccl::datatype::int64: SIMD_SELECT_INT(int64_t, avx512);
+        case ccl::datatype::uint64: SIMD_SELECT_INT(uint64_t, avx512);
+        case ccl::datatype::float32: SIMD_SELECT_FP(float, avx512);
+        case ccl::datatype::float64: SIMD_SELECT_FP(double, avx512);
+        default: return nullptr;
+    }
+}
+
+#endif // CCL_AVX_COMPILER
+
+ccl_simd_reduce_fn ccl_simd_get_reduce_fn(ccl::datatype dtype,
+                                          ccl::reduction reduction,
+                                          size_t avg_divisor) {
+    if (reduction == ccl::reduction::avg && avg_divisor <= 1) {
+        /* not the final step, avg is reduced as sum */
+        reduction = ccl::reduction::sum;
+    }
+
+#ifdef CCL_AVX_COMPILER
+    switch (ccl::global_data::env().simd_impl_type) {
+        case ccl_simd_avx2: return ccl_simd_get_reduce_fn_avx2(dtype, reduction);
+        case ccl_simd_avx512: return ccl_simd_get_reduce_fn_avx512(dtype, reduction);
+        default: return nullptr;
+    }
+#else // CCL_AVX_COMPILER
+    return nullptr;
+#endif // CCL_AVX_COMPILER
+}
@@ -0,0 +1,32 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include "common/datatype/datatype.hpp"
+#include "oneapi/ccl/types.hpp"
+
+/* vectorized kernel for in-place reduction of regular datatypes,
+   avg_divisor is applied only by avg kernels */
+typedef void (*ccl_simd_reduce_fn)(const void* in_buf,
+                                   void* inout_buf,
+                                   size_t count,
+                                   size_t avg_divisor);
+
+/* returns nullptr if there is no vectorized kernel for the given
+   datatype/reduction on the selected SIMD implementation */
+ccl_simd_reduce_fn ccl_simd_get_reduce_fn(ccl::datatype dtype,
+                                          ccl::reduction reduction,
+                                          size_t avg_divisor);
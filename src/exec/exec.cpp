@@ -19,7 +19,9 @@
 #include "exec/thread/service_worker.hpp"
 #include "exec/thread/worker.hpp"
 #include "common/env/env.hpp"
+#include "sched/buffer/buffer_cache.hpp"
 #include "sched/sched.hpp"
+#include "sched/sched_trace.hpp"
 
 size_t ccl_executor::get_worker_idx_by_sched_id(ccl_sched* sched) {
     if (sched->get_scaleout_flag()) {
@@ -31,11 +33,19 @@ size_t ccl_executor::get_worker_idx_by_sched_id(ccl_sched* sched) {
     return sched->sched_id % workers.size();
 }
 
+size_t ccl_executor::get_lane_count(size_t worker_count) {
+    auto& env = ccl::global_data::env();
+    if (env.worker_steal && env.worker_offload && (worker_count > 1)) {
+        return CCL_WORKER_STEAL_LANE_COUNT;
+    }
+    return 1;
+}
+
 size_t ccl_executor::calculate_atl_ep_count(size_t worker_count) {
-    size_t ep_count = worker_count;
+    size_t ep_count = worker_count * get_lane_count(worker_count);
 
     if (ccl::global_data::env().priority_mode != ccl_priority_none) {
-        ep_count *= CCL_PRIORITY_BUCKET_COUNT;
+        ep_count *= ccl::global_data::env().priority_bucket_count;
     }
 
     return ep_count;
@@ -60,17 +70,34 @@ atl_attr_t ccl_executor::generate_atl_attr(const ccl::env_data& env) {
     attr.in.mnic_count = env.mnic_count;
     attr.in.mnic_offset = env.mnic_offset;
 
-    memset(&attr.out, 0, sizeof(attr.out));
+    attr.out.enable_shm = 0;
+    attr.out.enable_rma = 0;
+    attr.out.enable_hmem = 0;
+    attr.out.mnic_type = ATL_MNIC_NONE;
+    attr.out.mnic_count = 0;
+    attr.out.tag_bits = 0;
+    attr.out.max_tag = 0;
+    attr.out.max_order_waw_size = 0;
+    attr.out.nic_numa_nodes.clear();
 
     return attr;
 }
 
-std::unique_ptr<ccl_sched_queue> ccl_executor::create_sched_queue(size_t idx,
-                                                                  size_t ep_per_worker) {
-    std::vector<size_t> ep_vec(ep_per_worker);
-    std::iota(std::begin(ep_vec), std::end(ep_vec), idx * ep_per_worker);
-    std::unique_ptr<ccl_sched_queue> sched_queue{ new ccl_sched_queue(idx, std::move(ep_vec)) };
-    return sched_queue;
+std::vector<std::unique_ptr<ccl_sched_queue>> ccl_executor::create_sched_queues(
+    size_t idx,
+    size_t ep_per_worker,
+    size_t lane_count) {
+    /* each lane gets own eps, all lane queues keep worker idx */
+    size_t ep_per_lane = ep_per_worker / lane_count;
+    std::vector<std::unique_ptr<ccl_sched_queue>> sched_queues;
+    for (size_t lane_idx = 0; lane_idx < lane_count; lane_idx++) {
+        std::vector<size_t> ep_vec(ep_per_lane);
+        std::iota(std::begin(ep_vec),
+                  std::end(ep_vec),
+                  idx * ep_per_worker + lane_idx * ep_per_lane);
+        sched_queues.emplace_back(new ccl_sched_queue(idx, std::move(ep_vec)));
+    }
+    return sched_queues;
 }
 
 ccl_executor::ccl_executor(const char* main_addr) {
@@ -79,6 +106,8 @@ ccl_executor::ccl_executor(const char* main_addr) {
     /* generate ATL attr for all future communicators */
     atl_comm_manager::set_internal_env(generate_atl_attr(env));
     atl_comm_manager::set_executor(this);
+
+    ccl::profile::trace::init();
 }
 
 void ccl_executor::start_workers(atl_proc_coord_t& coord) {
@@ -101,8 +130,32 @@ void ccl_executor::start_workers(atl_proc_coord_t& coord) {
                  " are set by ATL transport");
     }
 
-    CCL_THROW_IF_NOT(env.env_2_worker_affinity(global_data.get_local_proc_idx(),
-                                               global_data.get_local_proc_count()));
+    size_t local_idx = global_data.get_local_proc_idx();
+    size_t local_count = global_data.get_local_proc_count();
+    size_t ep_per_worker = ep_count / worker_count;
+
+    /*
+       NUMA node of NIC used by the first ep of each worker of each local process,
+       with mnic offset by local_proc_idx the NIC order of other local processes
+       is rotated relative to the order of this process
+    */
+    std::vector<int> worker_nic_numa_nodes;
+    const auto& nic_numa_nodes = atl_base_comm::attr.out.nic_numa_nodes;
+    if (!nic_numa_nodes.empty()) {
+        size_t nic_count = nic_numa_nodes.size();
+        bool rotate = (atl_base_comm::attr.in.mnic_offset == ATL_MNIC_OFFSET_LOCAL_PROC_IDX);
+        for (size_t proc_idx = 0; proc_idx < local_count; proc_idx++) {
+            for (size_t idx = 0; idx < worker_count; idx++) {
+                size_t nic_idx = idx * ep_per_worker;
+                if (rotate) {
+                    nic_idx += proc_idx + nic_count - local_idx % nic_count;
+                }
+                worker_nic_numa_nodes.push_back(nic_numa_nodes[nic_idx % nic_count]);
+            }
+        }
+    }
+
+    CCL_THROW_IF_NOT(env.env_2_worker_affinity(local_idx, local_count, worker_nic_numa_nodes));
     CCL_THROW_IF_NOT(env.env_2_worker_mem_affinity(global_data.get_local_proc_count()));
 
     if (env.worker_offload) {
@@ -114,15 +167,18 @@ void ccl_executor::start_workers(atl_proc_coord_t& coord) {
             global_data.get_local_proc_count() * worker_count);
     }
 
-    size_t ep_per_worker = ep_count / worker_count;
+    size_t lane_count = get_lane_count(worker_count);
     for (size_t idx = 0; idx < worker_count; idx++) {
         if (env.enable_fusion && idx == 0) {
             LOG_DEBUG("create service worker");
-            workers.emplace_back(new ccl_service_worker(
-                idx, create_sched_queue(idx, ep_per_worker), *global_data.fusion_manager));
+            workers.emplace_back(
+                new ccl_service_worker(idx,
+                                       create_sched_queues(idx, ep_per_worker, lane_count),
+                                       *global_data.fusion_manager));
         }
         else {
-            workers.emplace_back(new ccl_worker(idx, create_sched_queue(idx, ep_per_worker)));
+            workers.emplace_back(
+                new ccl_worker(idx, create_sched_queues(idx, ep_per_worker, lane_count)));
         }
 
         if (env.worker_offload) {
@@ -131,6 +187,15 @@ void ccl_executor::start_workers(atl_proc_coord_t& coord) {
             size_t mem_affinity =
                 env.worker_mem_affinity[global_data.get_local_proc_idx() * worker_count + idx];
 
+            /* with NUMA-aware affinity scratch memory of worker follows its cores */
+            int numa_node = env.buffer_cache_numa_node;
+            if (numa_node == CCL_UNDEFINED_NUMA_NODE && env.worker_affinity_numa &&
+                static_cast<int>(mem_affinity) != CCL_UNDEFINED_NUMA_NODE &&
+                global_data.hwloc_wrapper->get_numa_node(mem_affinity).membind_support) {
+                numa_node = mem_affinity;
+            }
+            global_data.buffer_cache->set_numa_node(idx, numa_node);
+
             CCL_THROW_IF_NOT(
                 workers.back()->start(cpu_affinity, mem_affinity) == ccl::status::success,
                 "failed to start worker # ",
@@ -146,6 +211,17 @@ void ccl_executor::start_workers(atl_proc_coord_t& coord) {
                       mem_affinity);
         }
     }
+
+    if (lane_count > 1) {
+        for (size_t idx = 0; idx < worker_count; idx++) {
+            std::vector<ccl_worker*> victims;
+            for (size_t victim_idx = 1; victim_idx < worker_count; victim_idx++) {
+                victims.push_back(workers[(idx + victim_idx) % worker_count].get());
+            }
+            workers[idx]->set_steal_victims(victims);
+        }
+    }
+
     workers_started = true;
 }
 
@@ -160,6 +236,7 @@ ccl_executor::~ccl_executor() {
     //    }
     //    listener.reset();
 
+    /* stop all workers before destroying any of them, thieves may access other workers */
     for (size_t idx = 0; idx < workers.size(); idx++) {
         if (ccl::global_data::env().worker_offload) {
             if (workers[idx]->stop() != ccl::status::success) {
@@ -168,13 +245,19 @@ ccl_executor::~ccl_executor() {
             else
                 LOG_DEBUG("stopped worker # ", idx);
         }
+    }
 
+    for (size_t idx = 0; idx < workers.size(); idx++) {
         while (!workers[idx]->can_reset()) {
             ccl_yield(ccl::global_data::env().yield_type);
         }
 
         workers[idx].reset();
     }
+
+    if (ccl::profile::trace::is_enabled()) {
+        ccl::profile::trace::dump();
+    }
 }
 
 void ccl_executor::lock_workers() {
@@ -210,11 +293,12 @@ void ccl_executor::unlock_workers() {
 void ccl_executor::update_workers() {
     size_t ep_count = calculate_atl_ep_count(workers.size());
     size_t ep_per_worker = ep_count / workers.size();
+    size_t lane_count = get_lane_count(workers.size());
 
     LOG_INFO("atl ep_count ", ep_count);
 
     for (size_t idx = 0; idx < workers.size(); idx++) {
-        workers[idx]->reset_queue(create_sched_queue(idx, ep_per_worker));
+        workers[idx]->reset_queues(create_sched_queues(idx, ep_per_worker, lane_count));
     }
 }
 
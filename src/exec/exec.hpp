@@ -97,6 +97,7 @@ public:
     void unlock_workers();
     bool is_locked = false;
 
+    static size_t get_lane_count(size_t worker_count);
     static size_t calculate_atl_ep_count(size_t worker_count);
     static atl_attr_t generate_atl_attr(const ccl::env_data& env);
 
@@ -104,7 +105,9 @@ private:
     size_t get_worker_idx_round_robin(ccl_sched* sched);
     size_t get_worker_idx_by_sched_id(ccl_sched* sched);
 
-    std::unique_ptr<ccl_sched_queue> create_sched_queue(size_t idx, size_t ep_per_worker);
+    std::vector<std::unique_ptr<ccl_sched_queue>> create_sched_queues(size_t idx,
+                                                                      size_t ep_per_worker,
+                                                                      size_t lane_count);
 
     std::vector<std::unique_ptr<ccl_worker>> workers;
     // TODO: Rework to support listener
@@ -16,9 +16,9 @@
 #include "exec/thread/service_worker.hpp"
 
 ccl_service_worker::ccl_service_worker(size_t idx,
-                                       std::unique_ptr<ccl_sched_queue> data_queue,
+                                       std::vector<std::unique_ptr<ccl_sched_queue>> data_queues,
                                        ccl_fusion_manager& fusion_manager)
-        : ccl_worker(idx, std::move(data_queue)),
+        : ccl_worker(idx, std::move(data_queues)),
           fusion_manager(fusion_manager) {}
 
 ccl_service_worker::~ccl_service_worker() {
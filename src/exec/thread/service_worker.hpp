@@ -22,7 +22,7 @@
 class ccl_service_worker : public ccl_worker {
 public:
     ccl_service_worker(size_t idx,
-                       std::unique_ptr<ccl_sched_queue> data_queue,
+                       std::vector<std::unique_ptr<ccl_sched_queue>> data_queues,
                        ccl_fusion_manager& fusion_manager);
     ~ccl_service_worker();
 
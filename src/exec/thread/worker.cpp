@@ -19,21 +19,72 @@
 #include "exec/thread/worker.hpp"
 
 #include "sched/sched_timer.hpp"
+#include "sched/sched_trace.hpp"
 
 #define CCL_WORKER_CHECK_STOP_ITERS     (16384)
 #define CCL_WORKER_CHECK_UPDATE_ITERS   (16384)
 #define CCL_WORKER_CHECK_AFFINITY_ITERS (16384)
 #define CCL_WORKER_PROCESS_ALL_ITERS    (4096)
 
+#define CCL_WORKER_PARK_MIN_SPIN_ITERS  (16)
+#define CCL_WORKER_PARK_INIT_SPIN_ITERS (1024)
+#define CCL_WORKER_PARK_MAX_SPIN_ITERS  (65536)
+
+#define CCL_WORKER_STEAL_ITERS     (64)
+#define CCL_WORKER_STEAL_WAIT_MSEC (1)
+
 static void* ccl_worker_func(void* args);
 
-ccl_worker::ccl_worker(size_t idx, std::unique_ptr<ccl_sched_queue> queue)
+ccl_worker::ccl_worker(size_t idx, std::vector<std::unique_ptr<ccl_sched_queue>> queues)
         : ccl_base_thread(idx, ccl_worker_func),
           should_lock(false),
           is_locked(false),
           process_atl(true),
-          strict_sched_queue(std::unique_ptr<ccl_strict_sched_queue>(new ccl_strict_sched_queue())),
-          sched_queue(std::move(queue)) {}
+          park_spin_limit(CCL_WORKER_PARK_INIT_SPIN_ITERS),
+          strict_sched_queue(
+              std::unique_ptr<ccl_strict_sched_queue>(new ccl_strict_sched_queue())) {
+    CCL_THROW_IF_NOT(!queues.empty(), "worker ", idx, " should have at least one sched queue");
+    for (auto& queue : queues) {
+        lanes.emplace_back(new sched_lane());
+        lanes.back()->queue = std::move(queue);
+    }
+}
+
+ccl_worker::sched_lane* ccl_worker::get_lane(ccl_sched* sched) {
+    if ((lanes.size() == 1) || sched->strict_order || (sched->sched_type != ccl_sched_regular)) {
+        return lanes[0].get();
+    }
+
+    /*
+       peers expect messages on the ATL ep of the same lane,
+       so the lane is derived from the same key as the worker index on all ranks
+    */
+    size_t key = sched->get_scaleout_flag() ? sched->get_op_id() : sched->sched_id;
+    return lanes[(key / ccl::global_data::env().worker_count) % lanes.size()].get();
+}
+
+bool ccl_worker::has_queued_work() {
+    for (auto& lane : lanes) {
+        if (lane->queue->peek()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ccl_worker::reset_queues(std::vector<std::unique_ptr<ccl_sched_queue>>&& queues) {
+    CCL_THROW_IF_NOT(queues.size() == lanes.size(),
+                     "unexpected queue count ",
+                     queues.size(),
+                     ", expected ",
+                     lanes.size());
+    strict_sched_queue->clear();
+    for (size_t idx = 0; idx < lanes.size(); idx++) {
+        std::lock_guard<ccl_spinlock> lock(lanes[idx]->progress_guard);
+        lanes[idx]->queue->clear();
+        lanes[idx]->queue = std::move(queues[idx]);
+    }
+}
 
 void ccl_worker::add(ccl_sched* sched) {
     LOG_DEBUG("add sched ",
@@ -48,6 +99,7 @@ void ccl_worker::add(ccl_sched* sched) {
     CCL_ASSERT(sched->get_in_bin_status() != ccl_sched_in_bin_added);
 
     update_wait_condition(ccl_base_thread::wait_data::update_type::increment, 1);
+    add_count.fetch_add(1, std::memory_order_relaxed);
 
     if (sched->strict_order) {
         /* to keep valid non-completed req until safe releasing */
@@ -55,25 +107,43 @@ void ccl_worker::add(ccl_sched* sched) {
         strict_sched_queue->add(sched);
     }
     else {
-        sched_queue->add(sched);
+        get_lane(sched)->queue->add(sched);
     }
 }
 
 ccl::status ccl_worker::do_work(size_t& processed_count) {
+    /* new submissions count as progress, so the worker doesn't park right before them */
+    size_t cur_add_count = add_count.load(std::memory_order_relaxed);
+    is_progressed = (cur_add_count != seen_add_count);
+    seen_add_count = cur_add_count;
+
+    processed_count = 0;
     do_work_counter++;
 
     auto ret = process_strict_sched_queue();
     if (ret != ccl::status::success)
         return ret;
 
-    ret = process_sched_queue(processed_count,
-                              (do_work_counter % CCL_WORKER_PROCESS_ALL_ITERS) ? false : true);
-    if (ret != ccl::status::success)
-        return ret;
+    bool process_all = (do_work_counter % CCL_WORKER_PROCESS_ALL_ITERS) ? false : true;
+    for (size_t idx = 0; idx < lanes.size(); idx++) {
+        /* the first lane is never stolen, other lanes are skipped while thief progresses them */
+        std::unique_lock<ccl_spinlock> progress_lock(lanes[idx]->progress_guard, std::defer_lock);
+        if (idx && !progress_lock.try_lock()) {
+            continue;
+        }
+
+        size_t lane_processed_count = 0;
+        ret = process_sched_queue(lanes[idx]->queue.get(), lane_processed_count, process_all);
+        processed_count += lane_processed_count;
+        if (ret != ccl::status::success)
+            return ret;
+    }
 
     if ((do_work_counter % (4 * CCL_WORKER_PROCESS_ALL_ITERS) == 0) &&
         ccl::global_data::env().queue_dump) {
-        sched_queue->dump(std::cout);
+        for (auto& lane : lanes) {
+            lane->queue->dump(std::cout);
+        }
     }
 
     return ccl::status::success;
@@ -110,7 +180,7 @@ ccl::status ccl_worker::process_strict_sched_queue() {
                       sched,
                       " from strict_queue to exec_queue, req ",
                       sched->get_request());
-            sched_queue->add(sched);
+            lanes[0]->queue->add(sched);
         }
 
         CCL_THROW_IF_NOT(sched->get_in_bin_status() == ccl_sched_in_bin_added,
@@ -141,16 +211,19 @@ ccl::status ccl_worker::process_strict_sched_queue() {
     return ccl::status::success;
 }
 
-ccl::status ccl_worker::process_sched_queue(size_t& completed_sched_count, bool process_all) {
+ccl::status ccl_worker::process_sched_queue(ccl_sched_queue* sched_queue,
+                                            size_t& completed_sched_count,
+                                            bool process_all) {
     completed_sched_count = 0;
     if (process_all) {
-        auto bins = sched_queue->peek_all();
+        sched_queue->peek_all(priority_bins);
 
-        if (bins.empty())
+        if (priority_bins.empty())
             return ccl::status::success;
 
+        /* bins go from the highest priority, nothing yields here to avoid starvation */
         size_t completed_sched_count_local = 0;
-        for (auto& bin : bins) {
+        for (auto& bin : priority_bins) {
             process_sched_bin(bin, completed_sched_count_local);
             completed_sched_count += completed_sched_count_local;
         }
@@ -164,11 +237,35 @@ ccl::status ccl_worker::process_sched_queue(size_t& completed_sched_count, bool
         ccl_sched_bin* bin = sched_queue->peek();
         if (!bin)
             return ccl::status::success;
-        return process_sched_bin(bin, completed_sched_count);
+
+        size_t top_priority = bin->get_priority();
+        auto ret = process_sched_bin(bin, completed_sched_count);
+        if (ret != ccl::status::success || sched_queue->get_bin_count() < 2)
+            return ret;
+
+        /*
+           lower priority bins keep their in-flight entries moving
+           but don't start next chunks while higher priority work is queued
+        */
+        sched_queue->peek_all(priority_bins);
+        size_t completed_sched_count_local = 0;
+        for (auto& lower_bin : priority_bins) {
+            if (lower_bin->get_priority() == top_priority)
+                continue;
+            ccl_sched_bin* top_bin = sched_queue->peek();
+            bool yield = top_bin && (top_bin->get_priority() > lower_bin->get_priority());
+            ret = process_sched_bin(lower_bin, completed_sched_count_local, yield);
+            completed_sched_count += completed_sched_count_local;
+            if (ret != ccl::status::success)
+                return ret;
+        }
+        return ccl::status::success;
     }
 }
 
-ccl::status ccl_worker::process_sched_bin(ccl_sched_bin* bin, size_t& completed_sched_count) {
+ccl::status ccl_worker::process_sched_bin(ccl_sched_bin* bin,
+                                          size_t& completed_sched_count,
+                                          bool yield) {
     CCL_ASSERT(bin);
     completed_sched_count = 0;
 
@@ -203,7 +300,7 @@ ccl::status ccl_worker::process_sched_bin(ccl_sched_bin* bin, size_t& completed_
         ccl_sched* sched = bin->get(sched_idx);
         CCL_ASSERT(sched && bin == sched->bin);
 
-        sched->do_progress();
+        is_progressed |= sched->do_progress(yield);
 
         if (sched->start_idx == sched->entries.size()) {
             // the last entry in the schedule has been completed, clean up the schedule and complete its request
@@ -217,7 +314,7 @@ ccl::status ccl_worker::process_sched_bin(ccl_sched_bin* bin, size_t& completed_
                       sched->entries.size());
 
             // remove completed schedule from the bin
-            sched_queue->erase(bin, sched_idx);
+            bin->get_queue()->erase(bin, sched_idx);
             CCL_ASSERT(!sched->bin);
             bin_size--;
             LOG_DEBUG("completing request ", sched->get_request(), " for ", sched);
@@ -236,7 +333,9 @@ ccl::status ccl_worker::process_sched_bin(ccl_sched_bin* bin, size_t& completed_
 
 void ccl_worker::clear_queue() {
     strict_sched_queue->clear();
-    sched_queue->clear();
+    for (auto& lane : lanes) {
+        lane->queue->clear();
+    }
 }
 
 void ccl_worker::update_wait_condition(ccl_base_thread::wait_data::update_type type, size_t delta) {
@@ -267,10 +366,29 @@ void ccl_worker::update_wait_condition(ccl_base_thread::wait_data::update_type t
 bool ccl_worker::check_wait_condition(size_t iter) {
     if (ccl::global_data::env().worker_wait && (wait.value == 0)) {
         std::unique_lock<std::mutex> lock(wait.mtx);
-        wait.var.wait(lock, [this] {
+        auto pred = [this] {
             bool cond = ((wait.value == 0) && (check_stop_condition(0) == false));
             return !cond;
-        });
+        };
+        if (ccl::global_data::env().worker_steal) {
+            /* wake up periodically to look for work of other workers */
+            wait.var.wait_for(lock, std::chrono::milliseconds(CCL_WORKER_STEAL_WAIT_MSEC), pred);
+        }
+        else {
+            wait.var.wait(lock, pred);
+        }
+    }
+    else if (ccl::global_data::env().worker_park && has_queued_work()) {
+        if (park_idle_iters++ == 0) {
+            park_spin_start = std::chrono::steady_clock::now();
+        }
+
+        if (park_idle_iters >= park_spin_limit) {
+            park();
+        }
+        else {
+            ccl_yield(ccl::global_data::env().yield_type);
+        }
     }
     else {
         ccl_yield(ccl::global_data::env().yield_type);
@@ -279,6 +397,173 @@ bool ccl_worker::check_wait_condition(size_t iter) {
     return true;
 }
 
+void ccl_worker::reset_park_condition() {
+    if (park_idle_iters == 0)
+        return;
+
+    park_counters.spin_usec += std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::steady_clock::now() - park_spin_start)
+                                   .count();
+    park_idle_iters = 0;
+}
+
+void ccl_worker::park() {
+    auto park_start = std::chrono::steady_clock::now();
+    size_t spin_usec =
+        std::chrono::duration_cast<std::chrono::microseconds>(park_start - park_spin_start).count();
+    park_counters.spin_usec += spin_usec;
+    park_idle_iters = 0;
+
+    size_t timeout_usec = ccl::global_data::env().worker_park_timeout;
+    atl_status_t atl_status = ATL_STATUS_UNSUPPORTED;
+
+    /*
+       only a single ep can be waited on, so block only when one lane has work
+       and don't block on ep which is being progressed by thief
+    */
+    sched_lane* busy_lane = nullptr;
+    size_t busy_lane_count = 0;
+    for (auto& lane : lanes) {
+        if (lane->queue->peek()) {
+            busy_lane = lane.get();
+            busy_lane_count++;
+        }
+    }
+    std::unique_lock<ccl_spinlock> progress_lock;
+    bool is_owner = (busy_lane_count == 1);
+    if (is_owner && (busy_lane != lanes[0].get())) {
+        progress_lock = std::unique_lock<ccl_spinlock>(busy_lane->progress_guard, std::try_to_lock);
+        is_owner = progress_lock.owns_lock();
+    }
+
+    ccl_sched_bin* bin = is_owner ? busy_lane->queue->peek() : nullptr;
+    if (is_owner && process_atl && bin && bin->size()) {
+        ccl_comm* comm = bin->get(0)->coll_param.comm;
+        int timeout_ms = (int)((timeout_usec + 999) / 1000);
+        atl_status = comm->get_atl_comm()->poll_wait(bin->get_atl_ep(), timeout_ms);
+        CCL_THROW_IF_NOT(atl_status == ATL_STATUS_SUCCESS || atl_status == ATL_STATUS_AGAIN ||
+                             atl_status == ATL_STATUS_UNSUPPORTED,
+                         "bad status ",
+                         atl_status);
+    }
+
+    if (atl_status == ATL_STATUS_UNSUPPORTED) {
+        /*
+           no wait object or several eps to progress, sleeping would only delay
+           the completions, so keep spinning and try to park rarely
+        */
+        if (is_owner && process_atl) {
+            park_spin_limit = CCL_WORKER_PARK_MAX_SPIN_ITERS;
+        }
+        ccl_yield(ccl::global_data::env().yield_type);
+        return;
+    }
+
+    auto park_end = std::chrono::steady_clock::now();
+    size_t park_usec =
+        std::chrono::duration_cast<std::chrono::microseconds>(park_end - park_start).count();
+    park_counters.park_count++;
+    park_counters.park_usec += park_usec;
+
+    if (ccl::profile::trace::is_enabled()) {
+        auto to_ns = [](std::chrono::steady_clock::time_point t) {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch())
+                .count();
+        };
+        ccl::profile::trace::add_span("park", "worker", to_ns(park_start), to_ns(park_end));
+    }
+
+    if (atl_status == ATL_STATUS_AGAIN) {
+        /* nothing arrived for the whole timeout, park earlier next time */
+        park_counters.timeout_count++;
+        park_spin_limit = std::max(park_spin_limit / 2, (size_t)CCL_WORKER_PARK_MIN_SPIN_ITERS);
+    }
+    else if (atl_status == ATL_STATUS_SUCCESS && park_usec < spin_usec) {
+        /* completion came soon after parking, a bit longer spin would have caught it */
+        park_spin_limit = std::min(park_spin_limit * 2, (size_t)CCL_WORKER_PARK_MAX_SPIN_ITERS);
+    }
+
+    LOG_TRACE("worker ",
+              get_idx(),
+              " parked for ",
+              park_usec,
+              " usec after ",
+              spin_usec,
+              " usec of spin, status ",
+              atl_status_to_str(atl_status),
+              ", new spin limit ",
+              park_spin_limit);
+}
+
+void ccl_worker::set_steal_victims(const std::vector<ccl_worker*>& victims) {
+    steal_victims = victims;
+    steal_ready.store(true, std::memory_order_release);
+}
+
+size_t ccl_worker::steal_work() {
+    if (!steal_ready.load(std::memory_order_acquire) || has_queued_work()) {
+        return 0;
+    }
+
+    /* start from the next worker to spread thieves over victims */
+    for (size_t idx = 0; idx < steal_victims.size(); idx++) {
+        ccl_worker* victim = steal_victims[(get_idx() + idx) % steal_victims.size()];
+        size_t stolen_count = 0;
+        if (steal_from(victim, stolen_count)) {
+            return stolen_count;
+        }
+    }
+
+    steal_counters.idle_iters++;
+    return 0;
+}
+
+bool ccl_worker::steal_from(ccl_worker* victim, size_t& stolen_count) {
+    stolen_count = 0;
+
+    /*
+       scheds can't be moved to our own queue since peers expect their messages
+       on victim's ATL ep, so take over a whole non-first lane together with its eps,
+       victim keeps progressing its other lanes in parallel
+    */
+    for (size_t idx = 1; idx < victim->lanes.size(); idx++) {
+        sched_lane* lane = victim->lanes[idx].get();
+        if (!lane->queue->peek()) {
+            continue;
+        }
+
+        std::unique_lock<ccl_spinlock> lane_lock(lane->progress_guard, std::try_to_lock);
+        if (!lane_lock.owns_lock()) {
+            continue;
+        }
+
+        for (size_t iter = 0; (iter < CCL_WORKER_STEAL_ITERS) && lane->queue->peek(); iter++) {
+            size_t completed_count = 0;
+            process_sched_queue(lane->queue.get(), completed_count, false);
+            stolen_count += completed_count;
+        }
+
+        victim->update_wait_condition(ccl_base_thread::wait_data::update_type::decrement,
+                                      stolen_count);
+
+        steal_counters.steal_count++;
+        steal_counters.stolen_sched_count += stolen_count;
+
+        LOG_TRACE("worker ",
+                  get_idx(),
+                  " completed ",
+                  stolen_count,
+                  " scheds in lane ",
+                  idx,
+                  " of worker ",
+                  victim->get_idx());
+
+        return true;
+    }
+
+    return false;
+}
+
 bool ccl_worker::check_stop_condition(size_t iter) {
     bool stop_signal = false;
 
@@ -336,6 +621,13 @@ static void* ccl_worker_func(void* args) {
 
     ccl::global_data::get().is_worker_thread = true;
 
+    /* busy span covers the iterations while the worker has active scheds */
+    bool use_trace = ccl::profile::trace::is_enabled();
+    uint64_t busy_start_ns = 0;
+    if (use_trace) {
+        ccl::profile::trace::set_thread_name(worker->name() + " " + std::to_string(worker_idx));
+    }
+
     worker->started = true;
 
     do {
@@ -348,6 +640,23 @@ static void* ccl_worker_func(void* args) {
 
             worker->update_wait_condition(ccl_base_thread::wait_data::update_type::decrement,
                                           processed_count);
+
+            if ((processed_count == 0) && ccl::global_data::env().worker_steal) {
+                processed_count = worker->steal_work();
+            }
+
+            if (use_trace) {
+                bool is_busy = (worker->wait.value != 0);
+                if (is_busy && !busy_start_ns) {
+                    busy_start_ns = ccl::profile::trace::now();
+                }
+                else if (!is_busy && busy_start_ns) {
+                    ccl::profile::trace::add_span(
+                        "busy", "worker", busy_start_ns, ccl::profile::trace::now());
+                    busy_start_ns = 0;
+                }
+                ccl::profile::trace::check_dump_request();
+            }
         }
         catch (ccl::exception& ccl_e) {
             CCL_FATAL("worker ", worker_idx, " caught internal exception: ", ccl_e.what());
@@ -361,6 +670,11 @@ static void* ccl_worker_func(void* args) {
 
         iter++;
 
+        if (worker->has_progress()) {
+            /* entries are moving even if no sched completed, the worker is not idle */
+            worker->reset_park_condition();
+        }
+
         if (processed_count == 0) {
             spin_count--;
             if (!spin_count) {
@@ -370,9 +684,40 @@ static void* ccl_worker_func(void* args) {
         }
         else {
             spin_count = max_spin_count;
+            worker->reset_park_condition();
         }
     } while (true);
 
+    if (busy_start_ns) {
+        ccl::profile::trace::add_span("busy", "worker", busy_start_ns, ccl::profile::trace::now());
+    }
+
+    if (ccl::global_data::env().worker_park) {
+        const auto& stats = worker->get_park_stats();
+        LOG_INFO("worker ",
+                 worker_idx,
+                 " park stats: parks ",
+                 stats.park_count,
+                 ", timeouts ",
+                 stats.timeout_count,
+                 ", spin usec ",
+                 stats.spin_usec,
+                 ", park usec ",
+                 stats.park_usec);
+    }
+
+    if (ccl::global_data::env().worker_steal) {
+        const auto& stats = worker->get_steal_stats();
+        LOG_INFO("worker ",
+                 worker_idx,
+                 " steal stats: steals ",
+                 stats.steal_count,
+                 ", stolen scheds ",
+                 stats.stolen_sched_count,
+                 ", idle iters ",
+                 stats.idle_iters);
+    }
+
     worker->started = false;
 
     return nullptr;
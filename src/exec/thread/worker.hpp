@@ -20,22 +20,26 @@
 #include "sched/queue/queue.hpp"
 #include "internal_types.hpp"
 
+#include <chrono>
 #include <memory>
 #include <list>
 #include <pthread.h>
 
 class ccl_executor;
 
+/* lanes per worker in steal mode, each lane is a sched queue with own ATL eps */
+#define CCL_WORKER_STEAL_LANE_COUNT (2)
+
 class ccl_worker : public ccl_base_thread {
 public:
     ccl_worker() = delete;
     ccl_worker(const ccl_worker& other) = delete;
     ccl_worker& operator=(const ccl_worker& other) = delete;
-    ccl_worker(size_t idx, std::unique_ptr<ccl_sched_queue> queue);
+    ccl_worker(size_t idx, std::vector<std::unique_ptr<ccl_sched_queue>> queues);
 
     virtual ~ccl_worker() {
         strict_sched_queue.reset();
-        sched_queue.reset();
+        lanes.clear();
     }
 
     virtual void* get_this() override {
@@ -53,10 +57,7 @@ public:
 
     void clear_queue();
 
-    void reset_queue(std::unique_ptr<ccl_sched_queue>&& queue) {
-        clear_queue();
-        sched_queue = std::move(queue);
-    }
+    void reset_queues(std::vector<std::unique_ptr<ccl_sched_queue>>&& queues);
 
     std::atomic<bool> should_lock;
     std::atomic<bool> is_locked;
@@ -68,13 +69,81 @@ public:
     bool check_affinity_condition(size_t iter);
     bool check_stop_condition(size_t iter);
 
+    void reset_park_condition();
+
+    /* true if the last do_work changed status of any entry or found new scheds */
+    bool has_progress() const {
+        return is_progressed;
+    }
+
+    struct park_stats {
+        size_t park_count = 0;
+        size_t timeout_count = 0;
+        size_t spin_usec = 0;
+        size_t park_usec = 0;
+    };
+
+    const park_stats& get_park_stats() const {
+        return park_counters;
+    }
+
+    void set_steal_victims(const std::vector<ccl_worker*>& victims);
+    size_t steal_work();
+
+    struct steal_stats {
+        size_t steal_count = 0; /* lanes of other workers taken over */
+        size_t stolen_sched_count = 0; /* scheds completed in those lanes */
+        size_t idle_iters = 0;
+    };
+
+    const steal_stats& get_steal_stats() const {
+        return steal_counters;
+    }
+
 private:
+    /*
+       scheds of a lane are progressed only by the thread which holds its guard,
+       in steal mode an idle worker takes a whole lane of busy worker together with its ATL eps
+       while the owner keeps progressing its other lanes
+    */
+    struct sched_lane {
+        std::unique_ptr<ccl_sched_queue> queue;
+        ccl_spinlock progress_guard;
+    };
+
+    sched_lane* get_lane(ccl_sched* sched);
+    bool has_queued_work();
+
     ccl::status process_strict_sched_queue();
-    ccl::status process_sched_queue(size_t& processed_count, bool process_all);
-    ccl::status process_sched_bin(ccl_sched_bin* bin, size_t& processed_count);
+    ccl::status process_sched_queue(ccl_sched_queue* sched_queue,
+                                    size_t& processed_count,
+                                    bool process_all);
+    ccl::status process_sched_bin(ccl_sched_bin* bin, size_t& processed_count, bool yield = false);
+
+    void park();
+
+    bool steal_from(ccl_worker* victim, size_t& stolen_count);
 
     size_t do_work_counter = 0;
 
+    /* reused between iterations to progress lower priority bins without allocation */
+    std::vector<ccl_sched_bin*> priority_bins;
+
+    /* spin-then-park state, spin limit adapts to observed completion latency */
+    size_t park_spin_limit;
+    size_t park_idle_iters = 0;
+    bool is_progressed = false;
+    std::atomic<size_t> add_count{ 0 };
+    size_t seen_add_count = 0;
+    std::chrono::steady_clock::time_point park_spin_start{};
+    park_stats park_counters{};
+
+    std::vector<ccl_worker*> steal_victims;
+    std::atomic<bool> steal_ready{ false };
+    steal_stats steal_counters{};
+
     std::unique_ptr<ccl_strict_sched_queue> strict_sched_queue;
-    std::unique_ptr<ccl_sched_queue> sched_queue;
+
+    /* the first lane is never stolen, strict order and service scheds are kept there */
+    std::vector<std::unique_ptr<sched_lane>> lanes;
 };
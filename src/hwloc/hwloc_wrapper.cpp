@@ -223,6 +223,42 @@ void ccl_hwloc_wrapper::membind_thread(int numa_node) {
     hwloc_bitmap_free(nodeset);
 }
 
+/* binds not yet touched pages of existing mapping, e.g. from mmap */
+void ccl_hwloc_wrapper::membind_memory(void* ptr, size_t size, int numa_node) {
+    if (!is_initialized()) {
+        LOG_WARN("hwloc is not initialized, skip memory membind for NUMA node ", numa_node);
+        return;
+    }
+
+    if (!is_valid_numa_node(numa_node) || !get_numa_node(numa_node).membind_support) {
+        LOG_WARN("invalid NUMA node or no membind support for NUMA node ",
+                 numa_node,
+                 ", skip memory membind");
+        return;
+    }
+
+    hwloc_obj_t numa_node_obj = hwloc_get_numanode_obj_by_os_index(topology, numa_node);
+    if (hwloc_set_area_membind(topology,
+                               ptr,
+                               size,
+                               numa_node_obj->nodeset,
+                               HWLOC_MEMBIND_BIND,
+                               HWLOC_MEMBIND_BYNODESET) < 0) {
+        LOG_WARN("failed to bind memory ",
+                 ptr,
+                 ", bytes ",
+                 size,
+                 " to NUMA node ",
+                 numa_node,
+                 " (",
+                 strerror(errno),
+                 ")");
+    }
+    else {
+        LOG_DEBUG("bound memory ", ptr, ", bytes ", size, " to NUMA node ", numa_node);
+    }
+}
+
 int ccl_hwloc_wrapper::get_numa_node_by_cpu(int cpu) {
     if (!is_initialized()) {
         LOG_WARN("hwloc is not initialized, can't get numa NUMA for CPU ", cpu);
@@ -244,6 +280,60 @@ int ccl_hwloc_wrapper::get_numa_node_by_cpu(int cpu) {
     return CCL_UNDEFINED_NUMA_NODE;
 }
 
+int ccl_hwloc_wrapper::get_numa_node_by_pci(int domain, int bus, int dev, int func) {
+    if (!is_initialized()) {
+        LOG_WARN("hwloc is not initialized, can't get NUMA node for device: [",
+                 domain,
+                 ":",
+                 bus,
+                 ":",
+                 dev,
+                 ":",
+                 func,
+                 "]");
+        return CCL_UNDEFINED_NUMA_NODE;
+    }
+
+    /* device may be absent in topology (e.g. virtual NIC), don't throw in this case */
+    hwloc_obj_t io_device = hwloc_get_pcidev_by_busid(topology, domain, bus, dev, func);
+    hwloc_obj_t first_non_io =
+        (io_device) ? hwloc_get_non_io_ancestor_obj(topology, io_device) : nullptr;
+    if (!first_non_io || hwloc_bitmap_iszero(first_non_io->cpuset)) {
+        return CCL_UNDEFINED_NUMA_NODE;
+    }
+
+    return get_numa_node_by_cpu(hwloc_bitmap_first(first_non_io->cpuset));
+}
+
+/* NUMA node which contains all CPUs of process binding, if any */
+int ccl_hwloc_wrapper::get_process_numa_node() {
+    if (!is_initialized() || hwloc_bitmap_iszero(bindset)) {
+        return CCL_UNDEFINED_NUMA_NODE;
+    }
+
+    int numa_node = get_numa_node_by_cpu(hwloc_bitmap_first(bindset));
+    unsigned cpu;
+    hwloc_bitmap_foreach_begin(cpu, bindset) {
+        if (get_numa_node_by_cpu(cpu) != numa_node) {
+            return CCL_UNDEFINED_NUMA_NODE;
+        }
+    }
+    hwloc_bitmap_foreach_end();
+
+    return numa_node;
+}
+
+bool ccl_hwloc_wrapper::is_process_bound_cpu(int cpu) {
+    if (!is_initialized() || cpu == CCL_UNDEFINED_CPU_ID) {
+        return false;
+    }
+    return hwloc_bitmap_isset(bindset, unsigned(cpu)) == 1;
+}
+
+std::vector<ccl_numa_node> ccl_hwloc_wrapper::get_numa_nodes() {
+    return numa_nodes;
+}
+
 ccl_numa_node ccl_hwloc_wrapper::get_numa_node(int numa_node) {
     if (!is_initialized()) {
         LOG_WARN("hwloc is not initialized, can't get info for NUMA node ", numa_node);
@@ -312,7 +402,8 @@ void* ccl_hwloc_wrapper::alloc_memory(size_t alignment, size_t size, int numa_no
     CCL_THROW_IF_NOT((((uintptr_t)ret) % alignment) == 0);
 
     // Add size and potential misalignement to allocated_memory_map for later freeing.
-    allocated_memory_map[ret] = std::make_pair(buffer, size);
+    std::lock_guard<std::mutex> lock{ allocated_memory_guard };
+    allocated_memory_map[ret] = std::make_pair(buffer, size + alignment);
 
     return ret;
 }
@@ -320,12 +411,14 @@ void* ccl_hwloc_wrapper::alloc_memory(size_t alignment, size_t size, int numa_no
 void ccl_hwloc_wrapper::dealloc_memory(void* buffer) {
     // TODO: do a better job at allocating with alignment.
     CCL_THROW_IF_NOT(buffer != nullptr, "We were asked to dealloc a nullptr");
+    std::lock_guard<std::mutex> lock{ allocated_memory_guard };
     auto it = allocated_memory_map.find(buffer);
     CCL_THROW_IF_NOT(it != allocated_memory_map.end(),
                      "We were asked to dealloc memory that hasn't been allocated");
     if (hwloc_free(topology, it->second.first, it->second.second) < 0) {
         LOG_WARN("hwloc_free failed (", strerror(errno), ")");
     }
+    allocated_memory_map.erase(it);
 }
 
 bool ccl_hwloc_wrapper::check_membind(int numa_node) {
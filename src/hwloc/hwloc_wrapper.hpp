@@ -17,6 +17,8 @@
 
 #include "hwloc.h"
 
+#include <map>
+#include <mutex>
 #include <vector>
 #include <string>
 
@@ -53,8 +55,13 @@ public:
     bool is_dev_close_by_pci(int domain, int bus, int dev, int func);
 
     void membind_thread(int numa_node);
+    void membind_memory(void* ptr, size_t size, int numa_node);
     int get_numa_node_by_cpu(int cpu);
+    int get_numa_node_by_pci(int domain, int bus, int dev, int func);
+    int get_process_numa_node();
+    bool is_process_bound_cpu(int cpu);
     ccl_numa_node get_numa_node(int numa_node);
+    std::vector<ccl_numa_node> get_numa_nodes();
 
     void* alloc_memory(size_t alignment, size_t size, int numa_node_os_idx);
     void dealloc_memory(void* buffer);
@@ -75,4 +82,5 @@ private:
     // maps from aligned ptr (which was returned to the user by alloc_memory)
     //      to <misaligned ptr (returned by hwloc_alloc_membind), len>
     std::map<void*, std::pair<void*, size_t>> allocated_memory_map;
+    std::mutex allocated_memory_guard;
 };
@@ -217,6 +217,7 @@ ccl::status ccl_parallelizer::process_base(ccl_sched* sched, bool update_sched_i
 #ifdef CCL_ENABLE_SYCL
     selector_param.is_sycl_buf = coll_attr.is_sycl_buf;
 #endif // CCL_ENABLE_SYCL
+    selector_param.hint_algo = coll_param.hint_algo;
 
     switch (coll_type) {
         case ccl_coll_barrier: part_count = max_data_partition_count; break;
@@ -246,7 +247,9 @@ ccl::status ccl_parallelizer::process_base(ccl_sched* sched, bool update_sched_i
         case ccl_coll_alltoall:
             selector_param.is_scaleout = coll_param.is_scaleout;
             algo.alltoall = data.algorithm_selector->get<ccl_coll_alltoall>(selector_param);
-            if (algo.alltoall == ccl_coll_alltoall_direct) {
+            sched->selected_algo.alltoall = algo.alltoall;
+            if (algo.alltoall == ccl_coll_alltoall_direct ||
+                algo.alltoall == ccl_coll_alltoall_bruck) {
                 part_count = 1;
             }
             else {
@@ -256,7 +259,9 @@ ccl::status ccl_parallelizer::process_base(ccl_sched* sched, bool update_sched_i
         case ccl_coll_alltoallv:
             selector_param.is_scaleout = coll_param.is_scaleout;
             algo.alltoallv = data.algorithm_selector->get<ccl_coll_alltoallv>(selector_param);
-            if (algo.alltoallv == ccl_coll_alltoallv_direct) {
+            sched->selected_algo.alltoallv = algo.alltoallv;
+            if (algo.alltoallv == ccl_coll_alltoallv_direct ||
+                algo.alltoallv == ccl_coll_alltoallv_hier) {
                 part_count = 1;
             }
             else {
@@ -269,9 +274,11 @@ ccl::status ccl_parallelizer::process_base(ccl_sched* sched, bool update_sched_i
             selector_param.recv_counts = coll_param.recv_counts.data();
             if (coll_type == ccl_coll_allgatherv) {
                 algo.allgatherv = data.algorithm_selector->get<ccl_coll_allgatherv>(selector_param);
+                sched->selected_algo.allgatherv = algo.allgatherv;
             }
             else {
                 algo.allgather = data.algorithm_selector->get<ccl_coll_allgather>(selector_param);
+                sched->selected_algo.allgather = algo.allgather;
             }
 
             if (algo.allgather == ccl_coll_allgather_direct ||
@@ -324,7 +331,26 @@ ccl::status ccl_parallelizer::process_base(ccl_sched* sched, bool update_sched_i
                 CCL_FATAL("unexpected allgatherv_algo ", algo.allgatherv);
             }
             break;
-        case ccl_coll_reduce_scatter: part_count = 1; break;
+        case ccl_coll_reduce_scatter:
+            /* the same count as in ccl_coll_build_reduce_scatter */
+            selector_param.count = coll_param.get_recv_count();
+            selector_param.is_scaleout = coll_param.is_scaleout;
+            algo.reduce_scatter =
+                data.algorithm_selector->get<ccl_coll_reduce_scatter>(selector_param);
+            sched->selected_algo.reduce_scatter = algo.reduce_scatter;
+            if ((algo.reduce_scatter != ccl_coll_reduce_scatter_ring &&
+                 algo.reduce_scatter != ccl_coll_reduce_scatter_naive) ||
+                (coll_param.get_recv_count() * dtype_size <=
+                 ccl::global_data::env().max_short_size) ||
+                (coll_param.get_recv_count() < max_data_partition_count) ||
+                ccl_is_device_side_algo(selector_param)) {
+                part_count = 1;
+            }
+            else {
+                /* split the block of each rank into sub-blocks, one per part sched */
+                part_count = max_data_partition_count;
+            }
+            break;
         case ccl_coll_recv:
         case ccl_coll_send:
             part_count = (coll_param.get_send_count() * dtype_size) / CCL_ATL_LARGE_MSG_SIZE;
@@ -538,12 +564,31 @@ ccl::status ccl_parallelizer::process_base(ccl_sched* sched, bool update_sched_i
             for (idx = 0; idx < part_count; idx++) {
                 ccl_coll_param param{ false };
                 param.ctype = ccl_coll_reduce_scatter;
-                // TODO: passing offset for send_buf is case of partitioning
-                // needs to be reviewed
                 param.send_buf = ccl_buffer(coll_param.get_send_buf_ptr(),
                                             coll_param.get_send_count() * dtype_size,
-                                            offsets[idx],
+                                            0,
                                             ccl_buffer_type::INDIRECT);
+                if (part_count > 1) {
+                    /*
+                        sub-blocks of the part are strided over the blocks of all ranks,
+                        pack them into a contiguous buffer to get a regular reduce_scatter
+                    */
+                    ccl_sched* part_sched = part_scheds[idx].get();
+                    size_t block_bytes = coll_param.get_recv_count() * dtype_size;
+                    size_t part_bytes = counts[idx] * dtype_size;
+                    ccl_buffer pack_buf =
+                        part_sched->alloc_buffer({ part_bytes * comm_size, param.send_buf });
+                    for (size_t rank_idx = 0; rank_idx < comm_size; rank_idx++) {
+                        entry_factory::create<copy_entry>(
+                            part_sched,
+                            param.send_buf + rank_idx * block_bytes + offsets[idx],
+                            pack_buf + rank_idx * part_bytes,
+                            counts[idx],
+                            dtype);
+                    }
+                    part_sched->add_barrier();
+                    param.send_buf = pack_buf;
+                }
                 param.recv_buf = ccl_buffer(coll_param.get_recv_buf_ptr(),
                                             coll_param.get_recv_count() * dtype_size,
                                             offsets[idx],
@@ -679,6 +724,10 @@ ccl::status ccl_parallelizer::process_base(ccl_sched* sched, bool update_sched_i
                      algo.alltoallv == ccl_coll_alltoallv_scatter) {
                 ccl_coll_build_scatter_alltoallv(sched, part_scheds_vector, coll_param);
             }
+            else if (coll_type == ccl_coll_alltoallv &&
+                     algo.alltoallv == ccl_coll_alltoallv_hier) {
+                ccl_coll_build_hier_alltoallv(sched, part_scheds_vector, coll_param);
+            }
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
             else if (algo.alltoall == ccl_coll_alltoall_topo ||
                      algo.alltoallv == ccl_coll_alltoallv_topo) {
@@ -14,8 +14,20 @@
  limitations under the License.
 */
 #include "common/global/global.hpp"
+#include "common/utils/huge_pages.hpp"
 #include "sched/buffer/buffer_cache.hpp"
 
+#include <algorithm>
+#include <sstream>
+
+#define CCL_BUFFER_CACHE_MIN_CLASS_POW     (6) /* 64 bytes */
+#define CCL_BUFFER_CACHE_MIN_CLASS_BYTES   ((size_t)1 << CCL_BUFFER_CACHE_MIN_CLASS_POW)
+#define CCL_BUFFER_CACHE_CLASS_SPLIT_POW   (2)
+#define CCL_BUFFER_CACHE_CLASSES_PER_POW   (1 << CCL_BUFFER_CACHE_CLASS_SPLIT_POW)
+#define CCL_BUFFER_CACHE_CLASS_COUNT \
+    ((64 - CCL_BUFFER_CACHE_MIN_CLASS_POW) * CCL_BUFFER_CACHE_CLASSES_PER_POW + 1)
+#define CCL_BUFFER_CACHE_LOW_WATER_PERCENT (75)
+
 namespace ccl {
 
 buffer_cache::buffer_cache(size_t instance_count)
@@ -25,6 +37,11 @@ buffer_cache::buffer_cache(size_t instance_count)
           sycl_buffers(instance_count)
 #endif // CCL_ENABLE_SYCL
 {
+    /* global limit is split evenly between instances */
+    size_t max_bytes = global_data::env().buffer_cache_max_size;
+    for (auto& instance : reg_buffers) {
+        instance.init((max_bytes + instance_count - 1) / instance_count);
+    }
 }
 
 buffer_cache::~buffer_cache() {
@@ -47,6 +64,10 @@ void buffer_cache::push(size_t idx, size_t bytes, void* ptr) {
     reg_buffers.at(idx % reg_buffers.size()).push(bytes, ptr);
 }
 
+void buffer_cache::set_numa_node(size_t idx, int numa_node) {
+    reg_buffers.at(idx % reg_buffers.size()).set_numa_node(numa_node);
+}
+
 #ifdef CCL_ENABLE_SYCL
 void buffer_cache::get(size_t idx, size_t bytes, const sycl::context& ctx, void** pptr) {
     sycl_buffers.at(idx % sycl_buffers.size()).get(bytes, ctx, pptr);
@@ -57,52 +78,114 @@ void buffer_cache::push(size_t idx, size_t bytes, const sycl::context& ctx, void
 }
 #endif // CCL_ENABLE_SYCL
 
+regular_buffer_cache::regular_buffer_cache() : free_lists(CCL_BUFFER_CACHE_CLASS_COUNT) {}
+
 regular_buffer_cache::~regular_buffer_cache() {
-    if (!cache.empty()) {
-        LOG_WARN("buffer cache is not empty, size: ", cache.size());
+    if (stats.cached_bytes) {
+        LOG_WARN("buffer cache is not empty, size: ", stats.cached_bytes);
         clear();
     }
 }
 
-void regular_buffer_cache::clear() {
-    std::lock_guard<buffer_cache::lock_t> lock{ guard };
-    LOG_DEBUG("clear buffer cache: size: ", cache.size());
-    for (auto& key_value : cache) {
-        CCL_FREE(key_value.second);
+std::string regular_buffer_cache::stats_t::to_string() const {
+    std::stringstream ss;
+    ss << "{ hits: " << hit_count << ", misses: " << miss_count << ", trims: " << trim_count
+       << ", cached_bytes: " << cached_bytes << ", peak_cached_bytes: " << peak_cached_bytes;
+    if (huge_page_request_count) {
+        ss << ", huge_pages: " << huge_page_count << "/" << huge_page_request_count
+           << " (hit rate " << 100 * huge_page_count / huge_page_request_count
+           << "%), thp: " << thp_count;
     }
-    cache.clear();
+    ss << " }";
+    return ss.str();
 }
 
-void regular_buffer_cache::get(size_t bytes, void** pptr) {
-    if (global_data::env().enable_buffer_cache) {
-        std::lock_guard<buffer_cache::lock_t> lock{ guard };
-        key_t key(bytes);
-        auto key_value = cache.find(key);
-        if (key_value != cache.end()) {
-            *pptr = key_value->second;
-            cache.erase(key_value);
-            LOG_DEBUG("loaded from buffer cache: bytes: ", bytes, ", ptr: ", *pptr);
-            return;
+size_t regular_buffer_cache::get_class_idx(size_t bytes) {
+    if (bytes <= CCL_BUFFER_CACHE_MIN_CLASS_BYTES) {
+        return 0;
+    }
+    /* 2^pow < bytes <= 2^(pow+1), split this range into equal steps */
+    size_t pow = 63 - __builtin_clzll(bytes - 1);
+    size_t step = (size_t)1 << (pow - CCL_BUFFER_CACHE_CLASS_SPLIT_POW);
+    size_t step_idx = (bytes - ((size_t)1 << pow) + step - 1) / step;
+    return (pow - CCL_BUFFER_CACHE_MIN_CLASS_POW) * CCL_BUFFER_CACHE_CLASSES_PER_POW + step_idx;
+}
+
+size_t regular_buffer_cache::get_class_bytes(size_t class_idx) {
+    size_t pow = CCL_BUFFER_CACHE_MIN_CLASS_POW + class_idx / CCL_BUFFER_CACHE_CLASSES_PER_POW;
+    size_t step_idx = class_idx % CCL_BUFFER_CACHE_CLASSES_PER_POW;
+    return ((size_t)1 << pow) + step_idx * ((size_t)1 << (pow - CCL_BUFFER_CACHE_CLASS_SPLIT_POW));
+}
+
+void regular_buffer_cache::init(size_t max_bytes) {
+    max_cached_bytes = max_bytes;
+    numa_node = global_data::env().buffer_cache_numa_node;
+}
+
+void regular_buffer_cache::set_numa_node(int node) {
+    numa_node = node;
+}
+
+void* regular_buffer_cache::alloc_huge_block(size_t bytes) {
+    size_t mapped_bytes = 0;
+    utils::huge_page_type type = utils::huge_page_type::none;
+    void* ptr = utils::huge_page_alloc(bytes, mapped_bytes, type);
+
+    /* pages are not touched yet, so the policy applies to all of them */
+    if (ptr && numa_node != CCL_UNDEFINED_NUMA_NODE) {
+        global_data::get().hwloc_wrapper->membind_memory(ptr, mapped_bytes, numa_node);
+    }
+
+    std::lock_guard<buffer_cache::lock_t> lock{ mapped_guard };
+    stats.huge_page_request_count++;
+    if (!ptr) {
+        return nullptr;
+    }
+
+    mapped_buffers.emplace(ptr, mapped_bytes);
+    if (type == utils::huge_page_type::thp) {
+        stats.thp_count++;
+    }
+    else {
+        stats.huge_page_count++;
+    }
+    LOG_DEBUG("allocated buffer with huge pages: bytes: ",
+              bytes,
+              ", type: ",
+              utils::to_string(type),
+              ", ptr: ",
+              ptr);
+    return ptr;
+}
+
+void* regular_buffer_cache::alloc_block(size_t bytes) {
+    void* ptr = nullptr;
+    if (global_data::env().enable_huge_pages && bytes >= utils::huge_page_size_2mb) {
+        ptr = alloc_huge_block(bytes);
+    }
+
+    if (!ptr) {
+        if (numa_node != CCL_UNDEFINED_NUMA_NODE) {
+            ptr = global_data::get().hwloc_wrapper->alloc_memory(
+                CCL_REG_MSG_ALIGNMENT, bytes, numa_node);
+            std::lock_guard<buffer_cache::lock_t> lock{ mapped_guard };
+            numa_buffers.insert(ptr);
+        }
+        else {
+            ptr = CCL_MALLOC(bytes, "buffer");
         }
     }
-    *pptr = CCL_MALLOC(bytes, "buffer");
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
     if (global_data::get().ze_data &&
         global_data::get().ze_data->external_pointer_registration_enabled &&
         bytes < global_data::env().ze_pointer_registration_threshold) {
-        global_data::get().ze_data->import_external_pointer(*pptr, bytes);
+        global_data::get().ze_data->import_external_pointer(ptr, bytes);
     }
 #endif // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
+    return ptr;
 }
 
-void regular_buffer_cache::push(size_t bytes, void* ptr) {
-    if (global_data::env().enable_buffer_cache) {
-        std::lock_guard<buffer_cache::lock_t> lock{ guard };
-        key_t key(bytes);
-        cache.insert({ std::move(key), ptr });
-        LOG_DEBUG("inserted to buffer cache: bytes: ", bytes, ", ptr: ", ptr);
-        return;
-    }
+void regular_buffer_cache::free_block(void* ptr, size_t bytes) {
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
     if (global_data::get().ze_data &&
         global_data::get().ze_data->external_pointer_registration_enabled &&
@@ -110,7 +193,102 @@ void regular_buffer_cache::push(size_t bytes, void* ptr) {
         global_data::get().ze_data->release_imported_pointer(ptr);
     }
 #endif // CCL_ENABLE_SYCL && CCL_ENABLE_ZE
-    CCL_FREE(ptr);
+    /* allocation mode may be changed in runtime, so check how the buffer was allocated */
+    size_t mapped_bytes = 0;
+    bool is_numa_buffer = false;
+    {
+        std::lock_guard<buffer_cache::lock_t> lock{ mapped_guard };
+        auto it = mapped_buffers.find(ptr);
+        if (it != mapped_buffers.end()) {
+            mapped_bytes = it->second;
+            mapped_buffers.erase(it);
+        }
+        is_numa_buffer = (numa_buffers.erase(ptr) > 0);
+    }
+
+    if (mapped_bytes) {
+        utils::huge_page_free(ptr, mapped_bytes);
+    }
+    else if (is_numa_buffer) {
+        global_data::get().hwloc_wrapper->dealloc_memory(ptr);
+    }
+    else {
+        CCL_FREE(ptr);
+    }
+}
+
+void regular_buffer_cache::trim(size_t max_bytes) {
+    /* release the largest buffers first, they are the least likely to be reused */
+    for (size_t class_idx = free_lists.size(); class_idx > 0; class_idx--) {
+        auto& free_list = free_lists[class_idx - 1];
+        size_t class_bytes = get_class_bytes(class_idx - 1);
+        while (!free_list.empty() && stats.cached_bytes > max_bytes) {
+            free_block(free_list.back(), class_bytes);
+            free_list.pop_back();
+            stats.cached_bytes -= class_bytes;
+        }
+        if (stats.cached_bytes <= max_bytes) {
+            break;
+        }
+    }
+}
+
+void regular_buffer_cache::clear() {
+    std::lock_guard<buffer_cache::lock_t> lock{ guard };
+    {
+        std::lock_guard<buffer_cache::lock_t> mapped_lock{ mapped_guard };
+        if (stats.huge_page_request_count) {
+            LOG_INFO("clear buffer cache: stats: ", stats.to_string());
+        }
+        else {
+            LOG_DEBUG("clear buffer cache: stats: ", stats.to_string());
+        }
+    }
+    trim(0);
+}
+
+regular_buffer_cache::stats_t regular_buffer_cache::get_stats() {
+    std::lock_guard<buffer_cache::lock_t> lock{ guard };
+    std::lock_guard<buffer_cache::lock_t> mapped_lock{ mapped_guard };
+    return stats;
+}
+
+void regular_buffer_cache::get(size_t bytes, void** pptr) {
+    size_t class_idx = get_class_idx(bytes);
+    size_t class_bytes = get_class_bytes(class_idx);
+    if (global_data::env().enable_buffer_cache) {
+        std::lock_guard<buffer_cache::lock_t> lock{ guard };
+        auto& free_list = free_lists[class_idx];
+        if (!free_list.empty()) {
+            *pptr = free_list.back();
+            free_list.pop_back();
+            stats.cached_bytes -= class_bytes;
+            stats.hit_count++;
+            LOG_DEBUG("loaded from buffer cache: bytes: ", bytes, ", ptr: ", *pptr);
+            return;
+        }
+        stats.miss_count++;
+    }
+    *pptr = alloc_block(class_bytes);
+}
+
+void regular_buffer_cache::push(size_t bytes, void* ptr) {
+    size_t class_idx = get_class_idx(bytes);
+    size_t class_bytes = get_class_bytes(class_idx);
+    if (global_data::env().enable_buffer_cache) {
+        std::lock_guard<buffer_cache::lock_t> lock{ guard };
+        free_lists[class_idx].push_back(ptr);
+        stats.cached_bytes += class_bytes;
+        stats.peak_cached_bytes = std::max(stats.peak_cached_bytes, stats.cached_bytes);
+        LOG_DEBUG("inserted to buffer cache: bytes: ", bytes, ", ptr: ", ptr);
+        if (max_cached_bytes && stats.cached_bytes > max_cached_bytes) {
+            stats.trim_count++;
+            trim(max_cached_bytes * CCL_BUFFER_CACHE_LOW_WATER_PERCENT / 100);
+            LOG_DEBUG("trimmed buffer cache: stats: ", stats.to_string());
+        }
+        return;
+    }
+    free_block(ptr, class_bytes);
 }
 
 #ifdef CCL_ENABLE_SYCL
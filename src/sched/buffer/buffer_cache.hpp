@@ -15,7 +15,9 @@
 */
 #pragma once
 
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #ifdef CCL_ENABLE_SYCL
@@ -24,6 +26,7 @@
 #endif // CCL_ENABLE_SYCL
 
 #include "common/utils/spinlock.hpp"
+#include "common/utils/utils.hpp"
 
 namespace ccl {
 
@@ -43,6 +46,8 @@ public:
 
     void push(size_t idx, size_t bytes, void* ptr);
 
+    void set_numa_node(size_t idx, int numa_node);
+
 #ifdef CCL_ENABLE_SYCL
     void get(size_t idx, size_t bytes, const sycl::context& ctx, void** pptr);
 
@@ -58,23 +63,64 @@ private:
 #endif // CCL_ENABLE_SYCL
 };
 
+/*
+   host buffers are grouped by geometric size classes (4 classes per power of two,
+   so a class is at most 25% larger than the requested size) and are allocated
+   with the full class size, so any request from the same class can reuse them
+
+   cached bytes are bounded by high-water mark, when it is exceeded
+   the largest free buffers are released until low-water mark is reached
+*/
 class regular_buffer_cache {
 public:
-    regular_buffer_cache() = default;
+    regular_buffer_cache();
     ~regular_buffer_cache();
     regular_buffer_cache(const regular_buffer_cache& other) = delete;
     regular_buffer_cache& operator=(const regular_buffer_cache& other) = delete;
 
+    void init(size_t max_bytes);
     void clear();
     void get(size_t bytes, void** pptr);
     void push(size_t bytes, void* ptr);
+    void set_numa_node(int node);
+
+    struct stats_t {
+        size_t hit_count = 0;
+        size_t miss_count = 0;
+        size_t trim_count = 0;
+        size_t cached_bytes = 0;
+        size_t peak_cached_bytes = 0;
+        /* allocations eligible for huge pages and how they were served */
+        size_t huge_page_request_count = 0;
+        size_t huge_page_count = 0;
+        size_t thp_count = 0;
+
+        std::string to_string() const;
+    };
+    stats_t get_stats();
+
+    static size_t get_class_idx(size_t bytes);
+    static size_t get_class_bytes(size_t class_idx);
 
 private:
+    void* alloc_huge_block(size_t bytes);
+    void* alloc_block(size_t bytes);
+    void free_block(void* ptr, size_t bytes);
+    void trim(size_t max_bytes);
+
     buffer_cache::lock_t guard{};
 
-    using key_t = size_t;
-    using value_t = void*;
-    std::unordered_multimap<key_t, value_t> cache;
+    /* free buffers per size class */
+    std::vector<std::vector<void*>> free_lists;
+    size_t max_cached_bytes = 0; /* 0 means unlimited */
+    int numa_node = CCL_UNDEFINED_NUMA_NODE; /* set before worker start */
+    stats_t stats{};
+
+    /* buffers mapped with huge pages, ptr -> mapped bytes, guards huge page stats too */
+    buffer_cache::lock_t mapped_guard{};
+    std::unordered_map<void*, size_t> mapped_buffers;
+    /* buffers allocated on specific NUMA node through hwloc */
+    std::unordered_set<void*> numa_buffers;
 };
 
 #ifdef CCL_ENABLE_SYCL
@@ -105,6 +105,8 @@ void buffer_manager::clear() {
     }
     ze_buffers.clear();
 #endif // CCL_ENABLE_ZE
+
+    managed_bytes = 0;
 }
 
 void* buffer_manager::alloc(const alloc_param& param) {
@@ -127,6 +129,7 @@ void* buffer_manager::alloc(const alloc_param& param) {
         global_data::get().buffer_cache->get(instance_idx, bytes, &ptr);
         if (param.is_managed) {
             regular_buffers.emplace_back(ptr, bytes);
+            managed_bytes += bytes;
         }
     }
 #ifdef CCL_ENABLE_SYCL
@@ -139,6 +142,7 @@ void* buffer_manager::alloc(const alloc_param& param) {
         global_data::get().buffer_cache->get(instance_idx, bytes, sycl_ctx, &ptr);
         if (param.is_managed) {
             sycl_buffers.emplace_back(ptr, bytes, sycl_ctx);
+            managed_bytes += bytes;
         }
     }
 #endif // CCL_ENABLE_SYCL
@@ -155,6 +159,7 @@ void* buffer_manager::alloc(const alloc_param& param) {
             instance_idx, context, device, ze::default_device_mem_alloc_desc, bytes, 0, &ptr);
         if (param.is_managed) {
             ze_buffers.emplace_back(ptr, bytes, context, device);
+            managed_bytes += bytes;
         }
     }
 #endif // CCL_ENABLE_ZE
@@ -21,6 +21,7 @@
 #ifdef CCL_ENABLE_SYCL
 #include <sycl/sycl.hpp>
 #endif // CCL_ENABLE_SYCL
+#include <atomic>
 #include <list>
 
 #include "common/stream/stream.hpp"
@@ -141,8 +142,14 @@ public:
     void* alloc(const alloc_param& param);
     void dealloc(const dealloc_param& param);
 
+    /* total size of buffers which are held until clear */
+    size_t get_managed_bytes() const {
+        return managed_bytes.load(std::memory_order_relaxed);
+    }
+
 private:
     size_t instance_idx{};
+    std::atomic<size_t> managed_bytes{};
 
     std::list<buffer_desc> regular_buffers;
 
@@ -16,12 +16,17 @@
 #include "common/global/global.hpp"
 #include "sched/cache/cache.hpp"
 
-ccl_sched* ccl_sched_cache::find_unsafe(const ccl_sched_key& key) const {
+ccl_sched_cache::shard_t& ccl_sched_cache::get_shard(const ccl_sched_key& key) {
+    return shards[hasher(key) % CCL_SCHED_CACHE_SHARD_COUNT];
+}
+
+ccl_sched* ccl_sched_cache::find_unsafe(shard_t& shard, const ccl_sched_key& key) {
     ccl_sched* sched = nullptr;
     {
-        auto it = table.find(key);
-        if (it != table.end()) {
-            sched = it->second;
+        auto it = shard.table.find(key);
+        if (it != shard.table.end()) {
+            sched = it->second.sched;
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru_it);
         }
     }
 
@@ -36,23 +41,106 @@ ccl_sched* ccl_sched_cache::find_unsafe(const ccl_sched_key& key) const {
     return sched;
 }
 
+void ccl_sched_cache::insert_unsafe(shard_t& shard, ccl_sched_key&& key, ccl_sched* sched) {
+    auto emplace_result = shard.table.emplace(std::move(key), cache_entry{ sched, 0, {} });
+    CCL_THROW_IF_NOT(emplace_result.second);
+    auto& entry = emplace_result.first->second;
+    shard.lru.push_front(&emplace_result.first->first);
+    entry.lru_it = shard.lru.begin();
+}
+
+void ccl_sched_cache::acquire(ccl_sched* sched) {
+    sched->cache_ref_count++;
+    reference_counter++;
+}
+
+size_t ccl_sched_cache::get_sched_bytes(ccl_sched* sched) {
+    size_t bytes = sched->get_memory().buffer_manager.get_managed_bytes();
+    for (auto& subsched : sched->get_subscheds()) {
+        bytes += subsched->get_memory().buffer_manager.get_managed_bytes();
+    }
+    return bytes;
+}
+
+void ccl_sched_cache::evict_unsafe(shard_t& shard) {
+    const auto& env = ccl::global_data::env();
+
+    /* global limits are split evenly between shards, 0 means unlimited */
+    auto get_shard_limit = [](size_t limit) {
+        return (limit + CCL_SCHED_CACHE_SHARD_COUNT - 1) / CCL_SCHED_CACHE_SHARD_COUNT;
+    };
+    size_t max_entries = get_shard_limit(env.cache_max_entries);
+    size_t max_bytes = get_shard_limit(env.cache_max_size);
+
+    if (max_bytes) {
+        /* buffers are allocated after insertion, refresh sizes of idle scheds */
+        shard.bytes = 0;
+        for (auto& it : shard.table) {
+            auto& entry = it.second;
+            if (entry.sched->cache_ref_count == 0) {
+                entry.bytes = get_sched_bytes(entry.sched);
+            }
+            shard.bytes += entry.bytes;
+        }
+    }
+
+    auto is_over_limit = [&]() {
+        return (max_entries && shard.table.size() > max_entries) ||
+               (max_bytes && shard.bytes > max_bytes);
+    };
+
+    auto lru_it = shard.lru.end();
+    while (is_over_limit() && lru_it != shard.lru.begin()) {
+        --lru_it;
+        auto it = shard.table.find(**lru_it);
+        CCL_THROW_IF_NOT(it != shard.table.end(), "LRU entry is not found in sched cache");
+        ccl_sched* sched = it->second.sched;
+        if (sched->cache_ref_count != 0) {
+            continue;
+        }
+
+        LOG_DEBUG("evict sched ", sched, " from cache, bytes ", it->second.bytes);
+        shard.bytes -= it->second.bytes;
+        lru_it = shard.lru.erase(lru_it);
+        shard.table.erase(it);
+        delete sched;
+        evict_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (is_over_limit()) {
+        LOG_DEBUG("sched cache shard is over limit, entries ",
+                  shard.table.size(),
+                  ", bytes ",
+                  shard.bytes,
+                  ", all scheds are in use");
+    }
+}
+
 void ccl_sched_cache::recache(const ccl_sched_key& old_key, ccl_sched_key&& new_key) {
+    ccl_sched* sched = nullptr;
     {
-        std::lock_guard<sched_cache_lock_t> lock{ guard };
-        auto it = table.find(old_key);
-        if (it == table.end()) {
+        shard_t& shard = get_shard(old_key);
+        std::lock_guard<sched_cache_lock_t> lock{ shard.guard };
+        auto it = shard.table.find(old_key);
+        if (it == shard.table.end()) {
             std::string error_message = "old_key wasn't found";
             CCL_ASSERT(false, error_message, old_key.match_id);
             throw ccl::exception(error_message + old_key.match_id);
         }
-        ccl_sched* sched = it->second;
-        table.erase(it);
-        auto emplace_result = table.emplace(std::move(new_key), sched);
-        CCL_THROW_IF_NOT(emplace_result.second);
+        sched = it->second.sched;
+        shard.bytes -= it->second.bytes;
+        shard.lru.erase(it->second.lru_it);
+        shard.table.erase(it);
+    }
+    {
+        shard_t& shard = get_shard(new_key);
+        std::lock_guard<sched_cache_lock_t> lock{ shard.guard };
+        insert_unsafe(shard, std::move(new_key), sched);
     }
 }
 
 void ccl_sched_cache::release(ccl_sched* sched) {
+    sched->cache_ref_count--;
     reference_counter--;
     LOG_DEBUG("releasing sched to cache: ", sched);
     LOG_TRACE("reference_counter=", reference_counter);
@@ -62,19 +150,29 @@ bool ccl_sched_cache::try_flush() {
     if (!ccl::global_data::env().enable_cache_flush)
         return true;
 
-    std::lock_guard<sched_cache_lock_t> lock{ guard };
+    for (auto& shard : shards) {
+        shard.guard.lock();
+    }
 
+    bool is_flushed = false;
     if (reference_counter == 0) {
-        for (auto it = table.begin(); it != table.end(); ++it) {
-            ccl_sched* sched = it->second;
-            CCL_ASSERT(sched);
-            LOG_DEBUG("remove sched ", sched, " from cache");
-            delete sched;
+        for (auto& shard : shards) {
+            for (auto it = shard.table.begin(); it != shard.table.end(); ++it) {
+                ccl_sched* sched = it->second.sched;
+                CCL_ASSERT(sched);
+                LOG_DEBUG("remove sched ", sched, " from cache");
+                delete sched;
+            }
+            shard.table.clear();
+            shard.lru.clear();
+            shard.bytes = 0;
         }
-        table.clear();
-        return true;
+        is_flushed = true;
     }
-    else {
-        return false;
+
+    for (auto& shard : shards) {
+        shard.guard.unlock();
     }
+
+    return is_flushed;
 }
@@ -22,11 +22,21 @@
 
 #include <atomic>
 #include <functional>
+#include <list>
 #include <unordered_map>
 #include <utility>
 
 #define CCL_SCHED_CACHE_INITIAL_BUCKET_COUNT (4096)
+#define CCL_SCHED_CACHE_SHARD_COUNT          (16)
 
+/*
+   table is split into shards selected by key hash,
+   find_or_create/release on different keys don't contend on a single lock
+
+   each shard keeps its own LRU list and is bounded by
+   CCL_CACHE_MAX_ENTRIES / CCL_CACHE_MAX_SIZE split evenly between shards,
+   only scheds which are not referenced by any user are evicted
+*/
 class ccl_sched_cache {
 public:
     ccl_sched_cache() : reference_counter(0){};
@@ -41,6 +51,12 @@ public:
             }
             iter++;
         }
+        LOG_DEBUG("sched cache: hits ",
+                  hit_count.load(),
+                  ", misses ",
+                  miss_count.load(),
+                  ", evictions ",
+                  evict_count.load());
     }
     ccl_sched_cache(const ccl_sched_cache& other) = delete;
     ccl_sched_cache& operator=(const ccl_sched_cache& other) = delete;
@@ -50,14 +66,50 @@ public:
     void release(ccl_sched* sched);
     bool try_flush();
 
+    size_t get_hit_count() const {
+        return hit_count.load(std::memory_order_relaxed);
+    }
+    size_t get_miss_count() const {
+        return miss_count.load(std::memory_order_relaxed);
+    }
+    size_t get_evict_count() const {
+        return evict_count.load(std::memory_order_relaxed);
+    }
+
 private:
-    ccl_sched* find_unsafe(const ccl_sched_key& key) const;
     using sched_cache_lock_t = ccl_spinlock;
-    mutable sched_cache_lock_t guard{}; //could be changed in constant method
+    using lru_list_t = std::list<const ccl_sched_key*>;
+
+    struct cache_entry {
+        ccl_sched* sched;
+        size_t bytes;
+        lru_list_t::iterator lru_it;
+    };
+
     //TODO use smart ptr for ccl_master_sched in table
-    using sched_table_t = std::unordered_map<ccl_sched_key, ccl_sched*, ccl_sched_key_hasher>;
-    sched_table_t table{ CCL_SCHED_CACHE_INITIAL_BUCKET_COUNT };
+    using sched_table_t = std::unordered_map<ccl_sched_key, cache_entry, ccl_sched_key_hasher>;
+
+    struct alignas(CACHELINE_SIZE) shard_t {
+        sched_cache_lock_t guard{};
+        sched_table_t table{ CCL_SCHED_CACHE_INITIAL_BUCKET_COUNT / CCL_SCHED_CACHE_SHARD_COUNT };
+        lru_list_t lru{}; /* most recently used first */
+        size_t bytes = 0;
+    };
+
+    shard_t& get_shard(const ccl_sched_key& key);
+    ccl_sched* find_unsafe(shard_t& shard, const ccl_sched_key& key);
+    void insert_unsafe(shard_t& shard, ccl_sched_key&& key, ccl_sched* sched);
+    void evict_unsafe(shard_t& shard);
+    void acquire(ccl_sched* sched);
+    static size_t get_sched_bytes(ccl_sched* sched);
+
+    ccl_sched_key_hasher hasher{};
+    shard_t shards[CCL_SCHED_CACHE_SHARD_COUNT];
     std::atomic<size_t> reference_counter;
+
+    std::atomic<size_t> hit_count{ 0 };
+    std::atomic<size_t> miss_count{ 0 };
+    std::atomic<size_t> evict_count{ 0 };
 };
 
 template <class Lambda>
@@ -67,15 +119,17 @@ std::pair<ccl_sched*, bool> ccl_sched_cache::find_or_create(ccl_sched_key&& key,
     ccl_sched* sched = nullptr;
 
     bool is_created = false;
+    shard_t& shard = get_shard(key);
     {
-        std::lock_guard<sched_cache_lock_t> lock{ guard };
-        sched = find_unsafe(key);
+        std::lock_guard<sched_cache_lock_t> lock{ shard.guard };
+        sched = find_unsafe(shard, key);
         if (sched) {
 #ifdef CCL_ENABLE_ITT
             __itt_event sched_cached_event = ccl::profile::itt::event_get("SCHED_CACHED");
             ccl::profile::itt::event_start(sched_cached_event);
 #endif // CCL_ENABLE_ITT
-            reference_counter++;
+            acquire(sched);
+            hit_count.fetch_add(1, std::memory_order_relaxed);
 #ifdef CCL_ENABLE_ITT
             ccl::profile::itt::event_end(sched_cached_event);
 #endif // CCL_ENABLE_ITT
@@ -87,21 +141,21 @@ std::pair<ccl_sched*, bool> ccl_sched_cache::find_or_create(ccl_sched_key&& key,
 #endif // CCL_ENABLE_ITT
             LOG_DEBUG("didn't find sched in cache, the new one will be created");
             sched = create_fn();
-            {
-                reference_counter++;
-                auto emplace_result = table.emplace(std::move(key), sched);
-                CCL_ASSERT(emplace_result.second);
-            }
+            acquire(sched);
+            miss_count.fetch_add(1, std::memory_order_relaxed);
+            insert_unsafe(shard, std::move(key), sched);
             is_created = true;
 
-            LOG_DEBUG("size ",
-                      table.size(),
+            LOG_DEBUG("shard size ",
+                      shard.table.size(),
                       ", bucket_count ",
-                      table.bucket_count(),
+                      shard.table.bucket_count(),
                       ", load_factor ",
-                      table.load_factor(),
+                      shard.table.load_factor(),
                       ", max_load_factor ",
-                      table.max_load_factor());
+                      shard.table.max_load_factor());
+
+            evict_unsafe(shard);
 #ifdef CCL_ENABLE_ITT
             ccl::profile::itt::event_end(sched_new_event);
 #endif // CCL_ENABLE_ITT
@@ -0,0 +1,118 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include "common/log/log.hpp"
+#include "common/utils/utils.hpp"
+#include "sched/cache/object_pool.hpp"
+
+#include <atomic>
+
+#define CCL_OBJECT_POOL_CLASS_SIZE       (CACHELINE_SIZE)
+#define CCL_OBJECT_POOL_CLASS_COUNT      (64)
+#define CCL_OBJECT_POOL_MAX_CACHED_COUNT (128)
+
+namespace ccl {
+
+namespace {
+
+std::atomic<bool> pool_enabled{ false };
+
+struct pool_block {
+    pool_block* next;
+};
+
+struct thread_cache;
+
+/* trivial thread_locals stay accessible after thread_cache is destroyed on thread exit */
+thread_local thread_cache* cache_ptr = nullptr;
+thread_local bool is_cache_destroyed = false;
+
+struct thread_cache {
+    pool_block* heads[CCL_OBJECT_POOL_CLASS_COUNT] = {};
+    size_t counts[CCL_OBJECT_POOL_CLASS_COUNT] = {};
+
+    ~thread_cache() {
+        for (size_t idx = 0; idx < CCL_OBJECT_POOL_CLASS_COUNT; idx++) {
+            while (heads[idx]) {
+                pool_block* block = heads[idx];
+                heads[idx] = block->next;
+                CCL_FREE_IMPL(block);
+            }
+        }
+        cache_ptr = nullptr;
+        is_cache_destroyed = true;
+    }
+};
+
+thread_cache* get_thread_cache() {
+    if (cache_ptr || is_cache_destroyed) {
+        return cache_ptr;
+    }
+    static thread_local thread_cache cache;
+    cache_ptr = &cache;
+    return cache_ptr;
+}
+
+size_t get_class_idx(size_t size) {
+    return (size + CCL_OBJECT_POOL_CLASS_SIZE - 1) / CCL_OBJECT_POOL_CLASS_SIZE - 1;
+}
+
+} // namespace
+
+void* object_pool::allocate(size_t size) {
+    size_t class_idx = get_class_idx(size);
+    if (class_idx < CCL_OBJECT_POOL_CLASS_COUNT) {
+        thread_cache* cache = (is_enabled()) ? get_thread_cache() : nullptr;
+        if (cache && cache->heads[class_idx]) {
+            pool_block* block = cache->heads[class_idx];
+            cache->heads[class_idx] = block->next;
+            cache->counts[class_idx]--;
+            return block;
+        }
+        /* allocate the whole class size to make block reusable for any object of this class,
+           this is done even if pool is disabled because block may be released after enabling */
+        size = (class_idx + 1) * CCL_OBJECT_POOL_CLASS_SIZE;
+    }
+    return CCL_MEMALIGN_WRAPPER(size, CACHELINE_SIZE, "object_pool");
+}
+
+void object_pool::deallocate(void* ptr, size_t size) {
+    if (!ptr) {
+        return;
+    }
+
+    size_t class_idx = get_class_idx(size);
+    if (class_idx < CCL_OBJECT_POOL_CLASS_COUNT && is_enabled()) {
+        thread_cache* cache = get_thread_cache();
+        if (cache && cache->counts[class_idx] < CCL_OBJECT_POOL_MAX_CACHED_COUNT) {
+            pool_block* block = static_cast<pool_block*>(ptr);
+            block->next = cache->heads[class_idx];
+            cache->heads[class_idx] = block;
+            cache->counts[class_idx]++;
+            return;
+        }
+    }
+    CCL_FREE_IMPL(ptr);
+}
+
+void object_pool::set_enabled(bool value) {
+    pool_enabled.store(value, std::memory_order_relaxed);
+}
+
+bool object_pool::is_enabled() {
+    return pool_enabled.load(std::memory_order_relaxed);
+}
+
+} // namespace ccl
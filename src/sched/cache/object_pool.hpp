@@ -0,0 +1,50 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include <cstddef>
+
+namespace ccl {
+
+/*
+   cache of fixed-size blocks for short-living internal objects (scheds, requests, entries)
+
+   blocks are grouped by size classes of CACHELINE_SIZE granularity and are kept
+   in per-thread free lists, so allocation and release on the collective submission
+   path don't go to the system allocator once the pool is warmed up
+
+   a block may be released by other thread than the one which allocated it,
+   in this case it is cached by the releasing thread
+*/
+class object_pool {
+public:
+    static void* allocate(size_t size);
+    static void deallocate(void* ptr, size_t size);
+
+    static void set_enabled(bool value);
+    static bool is_enabled();
+};
+
+} // namespace ccl
+
+/* routes class-specific allocation through object_pool */
+#define CCL_OBJECT_POOL_ALLOCATED \
+    static void* operator new(size_t size) { \
+        return ccl::object_pool::allocate(size); \
+    } \
+    static void operator delete(void* ptr, size_t size) { \
+        ccl::object_pool::deallocate(ptr, size); \
+    }
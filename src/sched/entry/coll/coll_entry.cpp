@@ -167,6 +167,11 @@ void coll_entry::start() {
                   ", count: ",
                   param.count);
         subsched_entry::build_subsched({ sched->sched_id, coll_param });
+        /* the nested collective of the same type defines the algorithm reported in coll stats */
+        if (!sched->selected_algo.has_value() &&
+            (subsched->coll_param.ctype == sched->coll_param.ctype)) {
+            sched->selected_algo = subsched->selected_algo;
+        }
         LOG_DEBUG("built COLL entry: ",
                   this,
                   ", subsched: ",
@@ -47,7 +47,7 @@ public:
                                                                   recv_buf.get_ptr(bytes),
                                                                   cnt,
                                                                   dtype.atl_datatype(),
-                                                                  static_cast<atl_reduction_t>(op),
+                                                                  to_atl_reduction(op),
                                                                   req);
         if (unlikely(atl_status != ATL_STATUS_SUCCESS)) {
             CCL_THROW("ALLREDUCE entry failed. atl_status: ", atl_status_to_str(atl_status));
@@ -63,8 +63,13 @@ public:
             CCL_THROW("ALLREDUCE entry failed. atl_status: ", atl_status_to_str(atl_status));
         }
 
-        if (req.is_completed)
+        if (req.is_completed) {
+            if (op == ccl::reduction::avg) {
+                size_t bytes = cnt * dtype.size();
+                ccl_comp_average(recv_buf.get_ptr(bytes), cnt, dtype, comm->size());
+            }
             status = ccl_sched_entry_status_complete;
+        }
     }
 
     const char* name() const override {
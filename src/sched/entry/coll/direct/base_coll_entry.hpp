@@ -15,6 +15,7 @@
 */
 #pragma once
 
+#include "comp/comp.hpp"
 #include "sched/entry/entry.hpp"
 #include "sched/queue/queue.hpp"
 
@@ -28,4 +29,10 @@ public:
     bool is_strict_order_satisfied() override {
         return (status == ccl_sched_entry_status_started || is_completed());
     }
+
+protected:
+    /* ATL has no native avg, it is reduced as sum and divided on completion */
+    static atl_reduction_t to_atl_reduction(ccl::reduction op) {
+        return (op == ccl::reduction::avg) ? ATL_REDUCTION_SUM : static_cast<atl_reduction_t>(op);
+    }
 };
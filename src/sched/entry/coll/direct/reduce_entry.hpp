@@ -50,7 +50,7 @@ public:
                                                                cnt,
                                                                root,
                                                                dtype.atl_datatype(),
-                                                               static_cast<atl_reduction_t>(op),
+                                                               to_atl_reduction(op),
                                                                req);
 
         if (unlikely(atl_status != ATL_STATUS_SUCCESS)) {
@@ -67,8 +67,13 @@ public:
             CCL_THROW("REDUCE entry failed. atl_status: ", atl_status_to_str(atl_status));
         }
 
-        if (req.is_completed)
+        if (req.is_completed) {
+            if (op == ccl::reduction::avg && comm->rank() == root) {
+                size_t bytes = cnt * dtype.size();
+                ccl_comp_average(recv_buf.get_ptr(bytes), cnt, dtype, comm->size());
+            }
             status = ccl_sched_entry_status_complete;
+        }
     }
 
     const char* name() const override {
@@ -53,7 +53,7 @@ public:
                                                  recv_buf.get_ptr(recv_bytes),
                                                  recv_cnt,
                                                  dtype.atl_datatype(),
-                                                 static_cast<atl_reduction_t>(op),
+                                                 to_atl_reduction(op),
                                                  req);
 
         if (unlikely(atl_status != ATL_STATUS_SUCCESS)) {
@@ -70,8 +70,13 @@ public:
             CCL_THROW("REDUCE_SCATTER entry failed. atl_status: ", atl_status_to_str(atl_status));
         }
 
-        if (req.is_completed)
+        if (req.is_completed) {
+            if (op == ccl::reduction::avg) {
+                size_t bytes = recv_cnt * dtype.size();
+                ccl_comp_average(recv_buf.get_ptr(bytes), recv_cnt, dtype, comm->size());
+            }
             status = ccl_sched_entry_status_complete;
+        }
     }
 
     const char* name() const override {
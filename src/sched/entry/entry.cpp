@@ -17,6 +17,9 @@
 #include "common/log/log.hpp"
 #include "sched/entry/entry.hpp"
 #include "sched/sched.hpp"
+#include "sched/sched_trace.hpp"
+
+#include <algorithm>
 
 sched_entry::sched_entry(ccl_sched* sched, bool is_barrier, bool is_coll, bool is_deps)
         : sched(sched),
@@ -27,6 +30,7 @@ sched_entry::sched_entry(ccl_sched* sched, bool is_barrier, bool is_coll, bool i
     detect_update_time_expiration =
         ccl::global_data::env().entry_max_update_time_sec != CCL_ENV_SIZET_NOT_SPECIFIED;
     use_update_timer = ccl::global_data::env().sched_profile || detect_update_time_expiration;
+    use_trace = ccl::profile::trace::is_enabled();
 }
 
 void sched_entry::do_progress() {
@@ -34,77 +38,101 @@ void sched_entry::do_progress() {
         return;
 
     if (status < ccl_sched_entry_status_started) {
-        CCL_THROW_IF_NOT(
-            status == ccl_sched_entry_status_not_started || status == ccl_sched_entry_status_again,
-            "bad status ",
-            status,
-            "(",
-            status_to_str(status),
-            ")");
-
-        bool took_credits = false;
-        if (status == ccl_sched_entry_status_not_started) {
-            took_credits = sched->flow_control.take_credit();
-            if (took_credits && use_total_timer) {
-                total_timer.start();
-            }
-        }
-        else if (status == ccl_sched_entry_status_again) {
-            took_credits = true;
-        }
-
-        if (!took_credits) {
+        if (!prepare_start()) {
             return;
         }
-
-#ifdef CCL_ENABLE_ITT
-        this->itt_event = ccl::profile::itt::event_get(this->name());
-        ccl::profile::itt::event_start(this->itt_event);
-#endif // CCL_ENABLE_ITT
-
         start();
-        CCL_THROW_IF_NOT(status >= ccl_sched_entry_status_again,
-                         "bad status ",
-                         status,
-                         "(",
-                         status_to_str(status),
-                         ")");
+        check_start_status();
     }
     else if (status == ccl_sched_entry_status_started) {
-        LOG_TRACE("update entry ", name());
+        prepare_update();
+        update();
+        check_update_status();
+    }
+
+    complete_progress();
+}
+
+bool sched_entry::prepare_start() {
+    CCL_THROW_IF_NOT(
+        status == ccl_sched_entry_status_not_started || status == ccl_sched_entry_status_again,
+        "bad status ",
+        status,
+        "(",
+        status_to_str(status),
+        ")");
 
-        if (use_update_timer && !update_timer.is_started()) {
-            update_timer.start();
+    bool took_credits = false;
+    if (status == ccl_sched_entry_status_not_started) {
+        took_credits = sched->flow_control.take_credit();
+        if (took_credits && use_total_timer) {
+            total_timer.start();
         }
-        else if (update_timer.is_started() && detect_update_time_expiration) {
-            // do this before entry::update so entry can handle this state inside update
-            long double seconds = update_timer.get_elapsed_usec() / 1000000;
-            if (seconds >= ccl::global_data::env().entry_max_update_time_sec) {
-                is_update_time_expired = true;
-            }
+        if (took_credits && use_trace) {
+            trace_start_ns = ccl::profile::trace::now();
         }
+    }
+    else if (status == ccl_sched_entry_status_again) {
+        took_credits = true;
+    }
 
-        update();
+    if (!took_credits) {
+        return false;
+    }
 
-        if (use_update_timer) {
-            update_timer.update();
-        }
+#ifdef CCL_ENABLE_ITT
+    this->itt_event = ccl::profile::itt::event_get(this->name());
+    ccl::profile::itt::event_start(this->itt_event);
+#endif // CCL_ENABLE_ITT
+
+    return true;
+}
+
+void sched_entry::check_start_status() {
+    CCL_THROW_IF_NOT(status >= ccl_sched_entry_status_again,
+                     "bad status ",
+                     status,
+                     "(",
+                     status_to_str(status),
+                     ")");
+}
+
+void sched_entry::prepare_update() {
+    LOG_TRACE("update entry ", name());
 
-        // ignore timeout on coll entry
-        // actual timeout will be reported from sub-entries
-        if (!is_coll()) {
-            CCL_THROW_IF_NOT(
-                !is_update_time_expired, "entry ", name(), " ", this, " update time expired");
+    if (use_update_timer && !update_timer.is_started()) {
+        update_timer.start();
+    }
+    else if (update_timer.is_started() && detect_update_time_expiration) {
+        // do this before entry::update so entry can handle this state inside update
+        long double seconds = update_timer.get_elapsed_usec() / 1000000;
+        if (seconds >= ccl::global_data::env().entry_max_update_time_sec) {
+            is_update_time_expired = true;
         }
+    }
+}
 
-        CCL_THROW_IF_NOT(status >= ccl_sched_entry_status_started,
-                         "bad status ",
-                         status,
-                         "(",
-                         status_to_str(status),
-                         ")");
+void sched_entry::check_update_status() {
+    if (use_update_timer) {
+        update_timer.update();
     }
 
+    // ignore timeout on coll entry
+    // actual timeout will be reported from sub-entries
+    if (!is_coll()) {
+        CCL_THROW_IF_NOT(
+            !is_update_time_expired, "entry ", name(), " ", this, " update time expired");
+    }
+
+    CCL_THROW_IF_NOT(status >= ccl_sched_entry_status_started,
+                     "bad status ",
+                     status,
+                     "(",
+                     status_to_str(status),
+                     ")");
+}
+
+void sched_entry::complete_progress() {
     if (status == ccl_sched_entry_status_complete) {
 #ifdef CCL_ENABLE_ITT
         ccl::profile::itt::event_end(this->itt_event);
@@ -114,11 +142,17 @@ void sched_entry::do_progress() {
             total_timer.update();
         }
 
+        if (use_trace) {
+            ccl::profile::trace::add_async_span(
+                name(), "entry", this, trace_start_ns, ccl::profile::trace::now(), sched->sched_id);
+        }
+
         if (exec_mode == ccl_sched_entry_exec_once) {
             status = ccl_sched_entry_status_complete_once;
         }
 
         sched->flow_control.return_credit();
+        notify_dependents();
     }
 
     CCL_THROW_IF_NOT(
@@ -152,6 +186,13 @@ void sched_entry::reset(size_t idx) {
         is_update_time_expired = false;
     }
 
+    if (!dependencies.empty()) {
+        pending_dependency_count = std::count_if(
+            dependencies.begin(), dependencies.end(), [](const sched_entry* dep) {
+                return dep->get_status() != ccl_sched_entry_status_complete_once;
+            });
+    }
+
     if (status == ccl_sched_entry_status_complete_once) {
         return;
     }
@@ -185,6 +226,8 @@ void sched_entry::dump(std::stringstream& str, size_t idx) const {
                        std::left,
                        std::setw(5),
                        barrier ? "TRUE" : "FALSE",
+                       " deps ",
+                       dependencies.size(),
                        " ");
     dump_detail(str);
 }
@@ -197,6 +240,53 @@ bool sched_entry::is_barrier() const {
     return barrier;
 }
 
+void sched_entry::add_dependency(sched_entry* dep) {
+    CCL_THROW_IF_NOT(dep && dep != this, "unexpected dependency ", dep, " for entry ", this);
+    CCL_THROW_IF_NOT(dep->get_sched() == sched,
+                     "dependency ",
+                     dep->name(),
+                     " belongs to another sched");
+
+    dependencies.push_back(dep);
+    dep->dependents.push_back(this);
+    if (!dep->is_completed()) {
+        pending_dependency_count++;
+    }
+}
+
+bool sched_entry::has_pending_dependencies() const {
+    return (pending_dependency_count > 0);
+}
+
+size_t sched_entry::get_dependency_count() const {
+    return dependencies.size();
+}
+
+void sched_entry::remove_dependency_links() {
+    for (auto dependent : dependents) {
+        auto& deps = dependent->dependencies;
+        deps.erase(std::remove(deps.begin(), deps.end(), this), deps.end());
+        if (!is_completed()) {
+            CCL_ASSERT(dependent->pending_dependency_count > 0);
+            dependent->pending_dependency_count--;
+        }
+    }
+    for (auto dep : dependencies) {
+        auto& deps = dep->dependents;
+        deps.erase(std::remove(deps.begin(), deps.end(), this), deps.end());
+    }
+    dependents.clear();
+    dependencies.clear();
+    pending_dependency_count = 0;
+}
+
+void sched_entry::notify_dependents() {
+    for (auto dependent : dependents) {
+        CCL_ASSERT(dependent->pending_dependency_count > 0);
+        dependent->pending_dependency_count--;
+    }
+}
+
 bool sched_entry::is_coll() const {
     return coll;
 }
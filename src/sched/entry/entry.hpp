@@ -18,6 +18,7 @@
 #include "atl/atl_base_comm.hpp"
 #include "common/datatype/datatype.hpp"
 #include "common/utils/utils.hpp"
+#include "sched/cache/object_pool.hpp"
 #include "sched/sched_timer.hpp"
 #include "sched/entry/postponed_fields.hpp"
 #include "internal_types.hpp"
@@ -55,6 +56,8 @@ enum ccl_condition {
 
 class alignas(CACHELINE_SIZE) sched_entry {
 public:
+    CCL_OBJECT_POOL_ALLOCATED
+
     sched_entry() = delete;
     explicit sched_entry(ccl_sched* sched,
                          bool is_barrier = false,
@@ -66,6 +69,30 @@ public:
     void do_progress();
     bool is_completed();
 
+    /* same as do_progress but with non-virtual start/update of the known entry type,
+       used to run compiled sched plans */
+    template <class entry_type>
+    void do_progress_as() {
+        if (is_completed())
+            return;
+
+        entry_type* typed_entry = static_cast<entry_type*>(this);
+        if (status < ccl_sched_entry_status_started) {
+            if (!prepare_start()) {
+                return;
+            }
+            typed_entry->entry_type::start();
+            check_start_status();
+        }
+        else if (status == ccl_sched_entry_status_started) {
+            prepare_update();
+            typed_entry->entry_type::update();
+            check_update_status();
+        }
+
+        complete_progress();
+    }
+
     virtual void reset(size_t idx);
 
     virtual bool is_strict_order_satisfied();
@@ -74,6 +101,15 @@ public:
 
     void make_barrier();
     bool is_barrier() const;
+
+    /* fine-grained alternative to barrier: the entry starts only after all of its
+       dependencies are completed, independent entries keep progressing meanwhile */
+    void add_dependency(sched_entry* dep);
+    bool has_pending_dependencies() const;
+    size_t get_dependency_count() const;
+    /* drops links from and to this entry, called before the entry is released */
+    void remove_dependency_links();
+
     bool is_coll() const;
     bool is_deps() const;
     ccl_sched_entry_status get_status() const;
@@ -105,12 +141,22 @@ protected:
     virtual void dump_detail(std::stringstream& str) const;
     const char* entry_status_to_str(ccl_sched_entry_status status) const;
     void update_status(atl_status_t atl_status);
+    void notify_dependents();
+
+    bool prepare_start();
+    void check_start_status();
+    void prepare_update();
+    void check_update_status();
+    void complete_progress();
 
     ccl_sched* sched = nullptr;
     bool barrier = false;
     bool coll = false;
     bool deps = false;
     size_t start_idx = 0;
+    std::vector<sched_entry*> dependencies;
+    std::vector<sched_entry*> dependents;
+    size_t pending_dependency_count = 0;
     ccl_sched_entry_status status = ccl_sched_entry_status_not_started;
     ccl_sched_entry_exec_mode exec_mode = ccl_sched_entry_exec_regular;
 
@@ -119,6 +165,9 @@ protected:
     bool use_update_timer = false;
     bool is_update_time_expired = false;
 
+    bool use_trace = false;
+    uint64_t trace_start_ns = 0;
+
 #ifdef CCL_ENABLE_ITT
     __itt_event itt_event = ccl::profile::itt::invalid_event;
 #endif // CCL_ENABLE_ITT
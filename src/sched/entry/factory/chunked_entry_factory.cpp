@@ -26,6 +26,8 @@ void make_chunked_send_entry(ccl_sched* sched,
         "send",
         dtype,
         cnt,
+        sched->coll_param.ctype,
+        comm->size(),
         create<send_entry>(chunk_sched, buf + chunk_offset, chunk_size, dtype, dst, comm),
         { chunk_sched = sched; });
 }
@@ -40,6 +42,8 @@ void make_chunked_recv_entry(ccl_sched* sched,
         "recv",
         dtype,
         cnt,
+        sched->coll_param.ctype,
+        comm->size(),
         create<recv_entry>(chunk_sched, buf + chunk_offset, chunk_size, dtype, src, comm),
         { chunk_sched = sched; });
 }
@@ -56,6 +60,8 @@ void make_chunked_recv_reduce_entry(ccl_sched* sched,
     CCL_CHUNKED_ENTRY_FUNCTION("recv_reduce",
                                dtype,
                                cnt,
+                               sched->coll_param.ctype,
+                               comm->size(),
                                create<recv_reduce_entry>(chunk_sched,
                                                          inout_buf + chunk_offset,
                                                          chunk_size,
@@ -79,6 +85,8 @@ void make_chunked_send_entry(std::vector<ccl_sched*>& scheds,
         "send",
         dtype,
         cnt,
+        scheds.front()->coll_param.ctype,
+        comm->size(),
         create<send_entry>(chunk_sched, buf + chunk_offset, chunk_size, dtype, dst, comm),
         { chunk_sched = scheds[(first_sched_idx + chunk_idx) % scheds.size()]; });
 }
@@ -94,6 +102,8 @@ void make_chunked_recv_entry(std::vector<ccl_sched*>& scheds,
         "recv",
         dtype,
         cnt,
+        scheds.front()->coll_param.ctype,
+        comm->size(),
         create<recv_entry>(chunk_sched, buf + chunk_offset, chunk_size, dtype, src, comm),
         { chunk_sched = scheds[(first_sched_idx + chunk_idx) % scheds.size()]; });
 }
@@ -108,6 +118,8 @@ void make_chunked_copy_entry(std::vector<ccl_sched*>& scheds,
         "copy",
         dtype,
         cnt,
+        scheds.front()->coll_param.ctype,
+        0 /* no comm, the entry for any comm size */,
         create<copy_entry>(
             chunk_sched, in_buf + chunk_offset, out_buf + chunk_offset, chunk_size, dtype),
         { chunk_sched = scheds[(first_sched_idx + chunk_idx) % scheds.size()]; });
@@ -15,18 +15,26 @@
 */
 #pragma once
 
+#include "coll/selection/tuning.hpp"
 #include "common/global/global.hpp"
 #include "sched/entry/factory/entry_factory.hpp"
 
-#define CCL_CHUNKED_ENTRY_FUNCTION(entry_name, dtype, cnt, create_entry_expr, get_sched_expr) \
+#define CCL_CHUNKED_ENTRY_FUNCTION( \
+    entry_name, dtype, cnt, ctype, comm_size, create_entry_expr, get_sched_expr) \
     do { \
         LOG_DEBUG("creating chunked ", entry_name, " entry"); \
         size_t dtype_size = dtype.size(); \
         size_t bytes = cnt * dtype_size; \
-        size_t chunk_count = (bytes >= ccl::global_data::env().min_chunk_size && \
-                              bytes >= ccl::global_data::env().chunk_count) \
-                                 ? ccl::global_data::env().chunk_count \
-                                 : 1; \
+        size_t max_chunk_count = \
+            ccl::global_data::get().tuning->get_param(ccl_tuning_param::chunk_count, \
+                                                      ctype, \
+                                                      comm_size, \
+                                                      bytes, \
+                                                      ccl::global_data::env().chunk_count); \
+        size_t chunk_count = \
+            (bytes >= ccl::global_data::env().min_chunk_size && bytes >= max_chunk_count) \
+                ? max_chunk_count \
+                : 1; \
         while ((chunk_count > 1) && \
                (bytes / chunk_count < ccl::global_data::env().min_chunk_size)) { \
             chunk_count--; \
@@ -31,6 +31,7 @@
 #include "sched/entry/deps_entry.hpp"
 #include "sched/entry/deregister_entry.hpp"
 #include "sched/entry/function_entry.hpp"
+#include "sched/entry/generator_entry.hpp"
 #include "sched/entry/probe_entry.hpp"
 #include "sched/entry/recv_entry.hpp"
 #include "sched/entry/recv_copy_entry.hpp"
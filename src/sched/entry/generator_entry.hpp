@@ -0,0 +1,156 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include "sched/entry/entry.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/*
+   generates its sub-entries step by step instead of materializing them at build time,
+   at most window_size sub-entries are in flight and new steps are generated as earlier
+   sub-entries complete, so the memory of the sched doesn't depend on the step count
+
+   sub-entries are owned by the generator and are not added to sched entries,
+   sched dump shows the in-flight ones as part of the generator, sched plan runs the
+   generator as a regular entry, sub-entries are traced on completion as any other entry
+*/
+class generator_entry : public sched_entry {
+public:
+    using step_fn_t = std::function<void(generator_entry* gen, size_t step_idx)>;
+
+    static constexpr const char* class_name() noexcept {
+        return "GENERATOR";
+    }
+
+    generator_entry() = delete;
+    generator_entry(ccl_sched* sched, size_t step_count, size_t window_size, step_fn_t step_fn)
+            : sched_entry(sched),
+              step_count(step_count),
+              window_size(std::max(window_size, static_cast<size_t>(1))),
+              step_fn(std::move(step_fn)) {
+        window.reserve(this->window_size);
+    }
+
+    /* to be called from step_fn, sub-entries are progressed in the emission order */
+    template <class entry_type, class... Arguments>
+    entry_type* emit(Arguments&&... args) {
+        entry_type* entry = new entry_type(sched, std::forward<Arguments>(args)...);
+        entry->set_exec_mode(exec_mode);
+        window.emplace_back(entry);
+        return entry;
+    }
+
+    void start() override {
+        next_step = 0;
+        window.clear();
+        generate();
+        status = ccl_sched_entry_status_started;
+        update();
+    }
+
+    void update() override {
+        bool prev_completed = true;
+        for (auto& entry : window) {
+            if (entry->has_pending_dependencies()) {
+                prev_completed = false;
+                if (entry->is_barrier()) {
+                    break;
+                }
+                continue;
+            }
+
+            entry->do_progress();
+
+            if (entry->get_status() == ccl_sched_entry_status_again) {
+                break;
+            }
+
+            bool completed = entry->is_completed();
+            if (entry->is_barrier() && !(completed && prev_completed)) {
+                break;
+            }
+            prev_completed = prev_completed && completed;
+        }
+
+        /*
+           retire the completed prefix only, so an entry is released after all the entries
+           emitted before it, links to it are dropped as its dependents may be still in flight
+        */
+        auto retired_end = std::find_if(window.begin(),
+                                        window.end(),
+                                        [](const std::unique_ptr<sched_entry>& entry) {
+                                            return !entry->is_completed();
+                                        });
+        for (auto it = window.begin(); it != retired_end; ++it) {
+            (*it)->remove_dependency_links();
+        }
+        window.erase(window.begin(), retired_end);
+        generate();
+
+        if (window.empty() && next_step == step_count) {
+            status = ccl_sched_entry_status_complete;
+        }
+    }
+
+    void reset(size_t idx) override {
+        sched_entry::reset(idx);
+        next_step = 0;
+        for (auto& entry : window) {
+            entry->remove_dependency_links();
+        }
+        window.clear();
+    }
+
+    const char* name() const override {
+        return class_name();
+    }
+
+protected:
+    void dump_detail(std::stringstream& str) const override {
+        ccl_logger::format(str,
+                           "step_count ",
+                           step_count,
+                           ", next_step ",
+                           next_step,
+                           ", window_size ",
+                           window_size,
+                           ", in flight ",
+                           window.size(),
+                           "\n");
+        for (size_t idx = 0; idx < window.size(); idx++) {
+            str << "    ";
+            window[idx]->dump(str, idx);
+        }
+    }
+
+private:
+    void generate() {
+        while (next_step < step_count && window.size() < window_size) {
+            step_fn(this, next_step++);
+        }
+    }
+
+    const size_t step_count;
+    const size_t window_size;
+    step_fn_t step_fn;
+
+    size_t next_step = 0;
+    std::vector<std::unique_ptr<sched_entry>> window;
+};
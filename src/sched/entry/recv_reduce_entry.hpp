@@ -40,7 +40,8 @@ public:
                       int src,
                       ccl_comm* comm,
                       ccl_buffer comm_buf = ccl_buffer(),
-                      ccl_recv_reduce_result_buf_type result_buf_type = ccl_recv_reduce_local_buf)
+                      ccl_recv_reduce_result_buf_type result_buf_type = ccl_recv_reduce_local_buf,
+                      size_t avg_divisor = 1)
             : sched_entry(sched),
               inout_buf(inout_buf),
               in_cnt(cnt),
@@ -50,6 +51,7 @@ public:
               comm(comm),
               comm_buf(comm_buf),
               result_buf_type(result_buf_type),
+              avg_divisor(avg_divisor),
               fn(sched->coll_attr.reduction_fn) {
         CCL_THROW_IF_NOT(op != ccl::reduction::custom || fn,
                          "custom reduction requires user provided callback",
@@ -127,7 +129,8 @@ public:
                                                   dtype,
                                                   op,
                                                   fn,
-                                                  &context);
+                                                  &context,
+                                                  avg_divisor);
 
         CCL_ASSERT(comp_status == ccl::status::success, "bad status ", comp_status);
         status = ccl_sched_entry_status_complete;
@@ -161,6 +164,8 @@ protected:
                            comm_buf,
                            ", result_buf_type ",
                            result_buf_type,
+                           ", avg_divisor ",
+                           avg_divisor,
                            ", req ",
                            req,
                            "\n");
@@ -175,6 +180,7 @@ private:
     ccl_comm* comm;
     ccl_buffer comm_buf;
     ccl_recv_reduce_result_buf_type result_buf_type;
+    size_t avg_divisor;
     uint64_t atl_tag = 0;
     ccl::reduction_fn fn;
     atl_req_t req{};
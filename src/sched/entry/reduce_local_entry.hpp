@@ -39,7 +39,8 @@ public:
                                 ccl_buffer inout_buf,
                                 size_t* out_cnt,
                                 const ccl_datatype& dtype,
-                                ccl::reduction op);
+                                ccl::reduction op,
+                                size_t avg_divisor = 1);
 
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
     void check_use_device();
@@ -71,6 +72,8 @@ protected:
                            ccl_reduction_to_str(op),
                            ", red_fn ",
                            fn,
+                           ", avg_divisor ",
+                           avg_divisor,
                            "\n");
     }
 
@@ -81,6 +84,7 @@ private:
     const size_t* out_cnt;
     const ccl_datatype dtype;
     const ccl::reduction op;
+    const size_t avg_divisor;
     const ccl::reduction_fn fn;
 
     bool use_device{};
@@ -36,23 +36,12 @@ void ccl_sched_bin::add(ccl_sched* sched) {
 }
 
 size_t ccl_sched_bin::erase(size_t idx, size_t& next_idx) {
-    ccl_sched* sched = nullptr;
-    size_t size = 0;
-    {
-        std::lock_guard<sched_queue_lock_t> lock(sched_list.elem_guard);
-        size = sched_list.elems.size();
-        CCL_THROW_IF_NOT(size > 0, "unexpected sched_list size ", size);
-        CCL_ASSERT(idx < size);
-        sched = sched_list.elems[idx];
-        sched->set_in_bin_status(ccl_sched_in_bin_erased);
-        sched->bin = nullptr;
-        size--;
-        std::swap(sched_list.elems[size], sched_list.elems[idx]);
-        sched_list.elems.resize(size);
-        CCL_ASSERT(sched_list.elems.size() == (size));
-        next_idx = idx;
-    }
-    return size;
+    size_t size = sched_list.elems.size();
+    CCL_THROW_IF_NOT(size > 0, "unexpected sched_list size ", size);
+    ccl_sched* sched = sched_list.remove(idx, next_idx);
+    sched->set_in_bin_status(ccl_sched_in_bin_erased);
+    sched->bin = nullptr;
+    return size - 1;
 }
 
 ccl_sched_queue::ccl_sched_queue(size_t idx, std::vector<size_t> atl_eps)
@@ -66,11 +55,11 @@ ccl_sched_queue::ccl_sched_queue(size_t idx, std::vector<size_t> atl_eps)
               atl_eps[0]);
 
     if (ccl::global_data::env().priority_mode != ccl_priority_none) {
-        CCL_ASSERT(atl_eps.size() == CCL_PRIORITY_BUCKET_COUNT,
+        CCL_ASSERT(atl_eps.size() == ccl::global_data::env().priority_bucket_count,
                    "unexpected atl_eps count ",
                    atl_eps.size(),
                    ", expected ",
-                   CCL_PRIORITY_BUCKET_COUNT);
+                   ccl::global_data::env().priority_bucket_count);
     }
     else
         CCL_ASSERT(!atl_eps.empty());
@@ -129,7 +118,14 @@ void ccl_sched_queue::add(ccl_sched* sched) {
         if (ccl::global_data::env().priority_mode == ccl_priority_none)
             atl_ep = atl_eps[0];
         else {
-            size_t ep_idx = (priority / CCL_PRIORITY_BUCKET_SIZE) % CCL_PRIORITY_BUCKET_COUNT;
+            /*
+               direct priorities are absolute so the highest buckets are kept apart from the rest,
+               lifo priorities grow with every submission so they wrap around the buckets
+            */
+            size_t bucket_idx = priority / CCL_PRIORITY_BUCKET_SIZE;
+            size_t ep_idx = (ccl::global_data::env().priority_mode == ccl_priority_direct)
+                                ? std::min(bucket_idx, atl_eps.size() - 1)
+                                : bucket_idx % atl_eps.size();
             atl_ep = atl_eps[ep_idx];
             LOG_DEBUG("priority ", priority, ", ep_idx ", ep_idx);
         }
@@ -140,6 +136,14 @@ void ccl_sched_queue::add(ccl_sched* sched) {
                                            std::forward_as_tuple(this, atl_ep, priority, sched));
         CCL_ASSERT(emplace_result.second);
         bin = &(emplace_result.first->second);
+        bin_count.store(bins.size(), std::memory_order_relaxed);
+
+        auto pos = std::lower_bound(
+            ordered_bins.begin(), ordered_bins.end(), bin, [](ccl_sched_bin* a, ccl_sched_bin* b) {
+                return a->get_priority() > b->get_priority();
+            });
+        ordered_bins.insert(pos, bin);
+        bins_version.fetch_add(1, std::memory_order_release);
 
         if (priority >= max_priority) {
             max_priority = priority;
@@ -166,9 +170,12 @@ size_t ccl_sched_queue::erase(ccl_sched_bin* bin, size_t sched_idx) {
         // double check on bin.empty(), before remove it from whole table
         std::lock_guard<sched_queue_lock_t> lock{ bins_guard };
         {
-            // no need to lock 'bin' here, because all adding are under bins_guard protection
-            if (bin->sched_list.elems.empty() /* && (bins.size() > 1)*/) {
+            // all adding are under bins_guard protection, so submitted list can't grow here
+            if (bin->sched_list.empty() /* && (bins.size() > 1)*/) {
+                ordered_bins.erase(std::find(ordered_bins.begin(), ordered_bins.end(), bin));
+                bins_version.fetch_add(1, std::memory_order_release);
                 bins.erase(bin_priority);
+                bin_count.store(bins.size(), std::memory_order_relaxed);
 
                 // change priority
                 if (bins.empty()) {
@@ -194,18 +201,26 @@ ccl_sched_bin* ccl_sched_queue::peek() {
     return cached_max_priority_bin;
 }
 
-std::vector<ccl_sched_bin*> ccl_sched_queue::peek_all() {
-    std::lock_guard<sched_queue_lock_t> lock{ bins_guard };
-    std::vector<ccl_sched_bin*> result;
-    result.reserve(bins.size());
-    for (auto& bin : bins) {
-        result.emplace_back(&(bin.second));
+void ccl_sched_queue::peek_all(std::vector<ccl_sched_bin*>& result) {
+    /* bins are kept ordered on add/erase, the lock is taken only when the set of bins changed */
+    if (bins_version.load(std::memory_order_acquire) != snapshot_version) {
+        std::lock_guard<sched_queue_lock_t> lock{ bins_guard };
+        snapshot_bins = ordered_bins;
+        snapshot_version = bins_version.load(std::memory_order_relaxed);
     }
-    return result;
+    result = snapshot_bins;
+}
+
+size_t ccl_sched_queue::get_bin_count() const {
+    return bin_count.load(std::memory_order_relaxed);
 }
 
 void ccl_sched_queue::clear() {
     cached_max_priority_bin = nullptr;
+    ordered_bins.clear();
+    snapshot_bins.clear();
+    bins_version.fetch_add(1, std::memory_order_release);
     bins.clear();
+    bin_count = 0;
     max_priority = 0;
 }
@@ -19,6 +19,8 @@
 #include "exec/exec.hpp"
 #include "sched/sched.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <deque>
 #include <unordered_map>
 
@@ -28,13 +30,21 @@ using sched_container_t = std::vector<ccl_sched*>;
 using sched_bin_list_t = std::unordered_map<size_t, ccl_sched_bin>; // key - priority
 using sched_queue_lock_t = ccl_spinlock;
 
-/* ATL EP is limited resource, each priority bucket consumes single ATL EP and uses it for all bins in bucket */
-#define CCL_PRIORITY_BUCKET_COUNT (1)
+/*
+   ATL EP is limited resource, each priority bucket consumes single ATL EP and uses it for all bins in bucket,
+   the bucket count is set through CCL_PRIORITY_BUCKET_COUNT
+*/
 
 /* the size of priority bucket, each bin in bucket use the same ATL EP although bins have different priorities */
 #define CCL_PRIORITY_BUCKET_SIZE (8)
 
 #define CCL_BUCKET_INITIAL_ELEMS_COUNT (1024)
+
+/*
+   MPSC list: any thread submits through lock-free intrusive stack,
+   the thread which progresses the bin drains submitted scheds into private vector
+   so all other methods are single-threaded and take no locks
+*/
 class ccl_sched_list {
 public:
     friend class ccl_sched_bin;
@@ -48,17 +58,18 @@ public:
     ccl_sched_list(ccl_sched* sched) {
         CCL_ASSERT(sched);
         elems.reserve(CCL_BUCKET_INITIAL_ELEMS_COUNT);
-        elems.push_back(sched);
+        add(sched);
     }
 
     ~ccl_sched_list() {
-        if (!elems.empty()) {
+        if (!empty()) {
             LOG_WARN("unexpected elem_count ", elems.size(), ", expected 0");
         }
         clear();
     }
 
     void clear() {
+        submitted.store(nullptr, std::memory_order_relaxed);
         elems.clear();
     }
 
@@ -67,70 +78,56 @@ public:
     ccl_sched_list(const ccl_sched_list&) = delete;
 
     ccl_sched_list(ccl_sched_list&& src) {
-        {
-            std::lock_guard<sched_queue_lock_t> lock(src.elem_guard);
-            elems = std::move(src.elems);
-        }
+        elems = std::move(src.elems);
+        submitted.store(src.submitted.exchange(nullptr, std::memory_order_acquire),
+                        std::memory_order_relaxed);
     }
     ccl_sched_list& operator=(ccl_sched_list&& other) {
         if (this != &other) {
-            std::lock(this->elem_guard, other.elem_guard);
             elems = std::move(other.elems);
-            // make sure both already-locked mutexes are unlocked at the end of scope
-            std::lock_guard<ccl_spinlock> own_lock(this->elem_guard, std::adopt_lock);
-            std::lock_guard<ccl_spinlock> other_lock(other.elem_guard, std::adopt_lock);
+            submitted.store(other.submitted.exchange(nullptr, std::memory_order_acquire),
+                            std::memory_order_relaxed);
         }
         return *this;
     }
 
+    /* can be called from any thread */
     void add(ccl_sched* sched) {
-        {
-            std::lock_guard<sched_queue_lock_t> lock(elem_guard);
-            elems.emplace_back(sched);
-        }
+        ccl_sched* head = submitted.load(std::memory_order_relaxed);
+        do {
+            sched->next_submitted = head;
+        } while (!submitted.compare_exchange_weak(
+            head, sched, std::memory_order_release, std::memory_order_relaxed));
     }
 
-    size_t size() const {
-        {
-            std::lock_guard<sched_queue_lock_t> lock(elem_guard);
-            return elems.size();
-        }
+    size_t size() {
+        drain();
+        return elems.size();
     }
 
     bool empty() {
-        {
-            std::lock_guard<sched_queue_lock_t> lock(elem_guard);
-            return elems.empty();
-        }
+        drain();
+        return elems.empty();
     }
 
     ccl_sched* get(size_t idx) {
-        {
-            std::lock_guard<sched_queue_lock_t> lock(elem_guard);
-            CCL_ASSERT(idx < elems.size());
-            return elems[idx];
-        }
+        CCL_ASSERT(idx < elems.size());
+        return elems[idx];
     }
 
     ccl_sched* remove(size_t idx, size_t& next_idx) {
-        ccl_sched* ret = nullptr;
-        {
-            std::lock_guard<sched_queue_lock_t> lock(elem_guard);
-            size_t size = elems.size();
-            CCL_ASSERT(idx < size);
-            ret = elems[idx];
-            std::swap(elems[size - 1], elems[idx]);
-            elems.resize(size - 1);
-            CCL_ASSERT(elems.size() == (size - 1));
-            next_idx = idx;
-        }
+        size_t size = elems.size();
+        CCL_ASSERT(idx < size);
+        ccl_sched* ret = elems[idx];
+        std::swap(elems[size - 1], elems[idx]);
+        elems.resize(size - 1);
+        next_idx = idx;
         return ret;
     }
 
     void dump(std::ostream& out) const {
         {
             auto sched_dump = ccl::global_data::env().sched_dump;
-            std::lock_guard<sched_queue_lock_t> lock(elem_guard);
             if (sched_dump) {
                 for (auto& e : elems) {
                     e->dump(out);
@@ -146,7 +143,20 @@ public:
     }
 
 private:
-    mutable sched_queue_lock_t elem_guard{};
+    /* moves submitted scheds to elems keeping submission order */
+    void drain() {
+        if (!submitted.load(std::memory_order_relaxed))
+            return;
+
+        ccl_sched* head = submitted.exchange(nullptr, std::memory_order_acquire);
+        size_t first_idx = elems.size();
+        for (; head; head = head->next_submitted) {
+            elems.push_back(head);
+        }
+        std::reverse(elems.begin() + first_idx, elems.end());
+    }
+
+    std::atomic<ccl_sched*> submitted{ nullptr };
     sched_container_t elems;
     char padding_queue[CACHELINE_SIZE];
 };
@@ -176,7 +186,7 @@ public:
     ccl_sched_bin(ccl_sched_bin&& src) = default;
     ccl_sched_bin& operator=(ccl_sched_bin&& other) = default;
 
-    size_t size() const {
+    size_t size() {
         return sched_list.size();
     }
     size_t get_priority() {
@@ -228,7 +238,13 @@ public:
      */
     ccl_sched_bin* peek();
 
-    std::vector<ccl_sched_bin*> peek_all();
+    /**
+     * Retrieve pointers to all bins ordered from the highest priority to the lowest one,
+     * should be called only by the thread which progresses the queue
+     */
+    void peek_all(std::vector<ccl_sched_bin*>& result);
+
+    size_t get_bin_count() const;
 
     void dump(std::ostream& out) const {
         {
@@ -238,7 +254,7 @@ public:
             size_t bin_idx = 0;
             for (auto& bin : bins) {
                 out << "   bin: idx: " << bin_idx << " priority: " << bin.first
-                    << " size: " << bin.second.size() << "\n";
+                    << " size: " << bin.second.sched_list.elems.size() << "\n";
                 bin_idx++;
                 bin.second.dump(out);
             }
@@ -254,4 +270,13 @@ private:
     sched_bin_list_t bins{ CCL_SCHED_QUEUE_INITIAL_BIN_COUNT };
     size_t max_priority = 0;
     std::atomic<ccl_sched_bin*> cached_max_priority_bin{};
+    std::atomic<size_t> bin_count{ 0 };
+
+    /* bins from the highest priority, updated under bins_guard when a bin is added or erased */
+    std::vector<ccl_sched_bin*> ordered_bins;
+    std::atomic<size_t> bins_version{ 0 };
+
+    /* copy of ordered_bins owned by the progressing thread, refreshed on version change */
+    std::vector<ccl_sched_bin*> snapshot_bins;
+    size_t snapshot_version = 0;
 };
@@ -28,6 +28,7 @@
 #include "sched/queue/queue.hpp"
 #include "sched/sched_base.hpp"
 #include "sched/sched_restart_manager.hpp"
+#include "sched/sched_trace.hpp"
 
 #ifdef CCL_ENABLE_SYCL
 #include "common/utils/sycl_utils.hpp"
@@ -216,6 +217,18 @@ ccl_request* ccl_sched::start(ccl_executor* exec,
         ccl_logger::get_instance().info(ostream.str());
     }
 
+    if (type == sched_type_t::master &&
+        (ccl::global_data::env().enable_coll_stats || is_tune_trial)) {
+        stats_start_time = std::chrono::steady_clock::now();
+    }
+
+    if (type == sched_type_t::master && ccl::global_data::env().enable_trace) {
+        trace_start_ns = ccl::profile::trace::now();
+        for (auto& subsched : subscheds) {
+            subsched->trace_start_ns = trace_start_ns;
+        }
+    }
+
     exec->start(this);
 
     return get_request();
@@ -436,57 +449,20 @@ bool ccl_sched::has_deps_entry() {
     return false;
 }
 
-void ccl_sched::do_progress() {
-    for (auto entry_idx = start_idx; entry_idx < entries.size(); ++entry_idx) {
-        auto& entry = entries[entry_idx];
-
-        if (entry->get_status() == ccl_sched_entry_status_not_started) {
-            LOG_DEBUG("starting entry: ",
-                      entry.get(),
-                      ", name: ",
-                      entry->name(),
-                      " [",
-                      entry_idx,
-                      "/",
-                      entries.size(),
-                      "]");
-        }
-
-        entry->do_progress();
+bool ccl_sched::do_progress(bool yield) {
+    bool is_progressed = false;
 
-        if (entry->get_status() == ccl_sched_entry_status_again) {
-            LOG_DEBUG("entry ",
-                      entry->name(),
-                      " is in again state, stop progressing [",
-                      entry_idx,
-                      "/",
-                      entries.size(),
-                      "]");
-            break;
-        }
-
-        if (entry_idx == start_idx && entry->is_completed()) {
-            /* the entry has been completed, increment start_idx */
-            ++start_idx;
-            LOG_DEBUG("completed entry: ",
-                      entry.get(),
-                      ", name: ",
-                      entry->name(),
-                      entry->is_barrier() ? " barrier" : "",
-                      " entry [",
-                      entry_idx,
-                      "/",
-                      entries.size(),
-                      "], shift start_idx to ",
-                      start_idx,
-                      ", sched ",
-                      this);
-        }
-        else if (entry->is_barrier() && (!entry->is_completed() || (start_idx != entry_idx + 1))) {
-            /* barrier is not completed or completed too early, skip the further progressing */
-            break;
+    if (plan.is_compiled()) {
+        if (plan.is_valid(entries_version)) {
+            start_idx = plan.do_progress(start_idx, yield, is_progressed);
+            return is_progressed;
         }
+        /* entries were changed after compilation */
+        plan.reset();
     }
+
+    start_idx = sched_plan::do_progress(entries, start_idx, yield, is_progressed);
+    return is_progressed;
 }
 
 bool ccl_sched::is_strict_order_satisfied() {
@@ -535,8 +511,19 @@ void ccl_sched::complete() {
             }
         }
 
+        if (!plan.is_compiled() && ccl::global_data::env().enable_sched_plan &&
+            (parent_schedule ? parent_schedule->coll_attr.to_cache : coll_attr.to_cache)) {
+            plan.compile(entries, entries_version);
+        }
+
         sched_complete_hook();
 
+        complete_trace();
+
+        if (!parent_schedule) {
+            update_coll_stats();
+        }
+
         // now we completed everything related to finalization of the current sched,
         // so we can finally complete it
         bool success = get_request()->complete();
@@ -551,6 +538,8 @@ void ccl_sched::complete() {
                 // itt tracks only top-level sched execution
                 if (top_level_sched)
                     complete_itt(parent_schedule->coll_param.stream);
+                parent_schedule->update_coll_stats();
+                parent_schedule->complete_trace();
                 // if we don't use cache, it doesn't make sense to restart the sched
                 // as there are never be any requests to restart
                 if (parent_schedule->coll_attr.to_cache) {
@@ -595,6 +584,7 @@ void ccl_sched::renew(bool need_update_id, bool reset) {
 
 void ccl_sched::add_barrier() {
     if (!entries.empty()) {
+        entries_version++;
         if (add_mode == ccl_sched_add_back)
             entries.back()->make_barrier();
         else if (add_mode == ccl_sched_add_front)
@@ -686,6 +676,48 @@ void ccl_sched::update_active_request(bool use_delayed) {
     LOG_DEBUG("updated req: ", req, ", old: ", old_req, ", use_delayed: ", use_delayed);
 }
 
+void ccl_sched::update_coll_stats() {
+    /* only scheds started through start() have the start time */
+    if (stats_start_time == std::chrono::steady_clock::time_point{} || !coll_param.comm)
+        return;
+
+    ccl_coll_algo algo = selected_algo;
+    if (!algo.has_value() && !subscheds.empty())
+        algo = subscheds.front()->selected_algo;
+
+    auto end_time = std::chrono::steady_clock::now();
+    if (ccl::global_data::env().enable_coll_stats && !coll_attr.is_internal) {
+        coll_param.comm->get_coll_stats().record(coll_param, algo, stats_start_time, end_time);
+    }
+    if (is_tune_trial) {
+        coll_param.comm->get_coll_tuner().record(
+            coll_param,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - stats_start_time)
+                .count());
+    }
+    stats_start_time = {};
+}
+
+void ccl_sched::complete_trace() {
+    if (!trace_start_ns)
+        return;
+
+    ccl_coll_algo algo = selected_algo;
+    if (!algo.has_value() && !subscheds.empty())
+        algo = subscheds.front()->selected_algo;
+
+    ccl::profile::trace::add_async_span(ccl_coll_type_to_str(coll_param.ctype),
+                                        (type == sched_type_t::master) ? "coll" : "sched",
+                                        this,
+                                        trace_start_ns,
+                                        ccl::profile::trace::now(),
+                                        sched_id,
+                                        algo.has_value()
+                                            ? ccl_coll_algorithm_name(coll_param.ctype, algo)
+                                            : nullptr);
+    trace_start_ns = 0;
+}
+
 void ccl_sched::complete_itt(const ccl_stream* stream) {
     (void)stream;
 }
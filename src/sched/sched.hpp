@@ -17,9 +17,11 @@
 
 #include "common/request/request.hpp"
 #include "common/utils/sync_object.hpp"
+#include "sched/cache/object_pool.hpp"
 #include "sched/sched_base.hpp"
 #include "sched/sched_timer.hpp"
 #include "sched/sched_group.hpp"
+#include "sched/sched_plan.hpp"
 #include "sched/queue/flow_control.hpp"
 #include "internal_types.hpp"
 
@@ -58,6 +60,8 @@ class ccl_sched_key;
 enum class sched_type_t { /* regular , */ master, extra };
 class alignas(CACHELINE_SIZE) ccl_sched : public ccl_sched_base {
 public:
+    CCL_OBJECT_POOL_ALLOCATED
+
     static constexpr const char* class_name() {
         return "sched";
     }
@@ -121,7 +125,12 @@ public:
 
     bool is_strict_order_satisfied();
 
-    void do_progress();
+    /**
+     * Progresses the entries, when yield is set only already started entries are progressed
+     * and new ones are not started, so the sched gives way to higher priority work between chunks,
+     * returns true if any entry changed its status
+     */
+    bool do_progress(bool yield = false);
 
     /**
      * Called after all the entries have been completed
@@ -167,6 +176,7 @@ public:
 
     sched_entry* add_entry(std::unique_ptr<sched_entry>&& entry) {
         entry->set_exec_mode(exec_mode);
+        entries_version++;
 
         sched_entry* raw_ptr = entry.get();
         if (add_mode == ccl_sched_add_back)
@@ -189,6 +199,7 @@ public:
 
     sched_entry* add_entry(std::unique_ptr<sched_entry>&& entry, add_entry_front_t) {
         entry->set_exec_mode(exec_mode);
+        entries_version++;
 
         sched_entry* raw_ptr = entry.get();
         entries.push_front(std::move(entry));
@@ -197,6 +208,7 @@ public:
 
     sched_entry* add_entry(std::unique_ptr<sched_entry>&& entry, add_entry_back_t) {
         entry->set_exec_mode(exec_mode);
+        entries_version++;
 
         sched_entry* raw_ptr = entry.get();
         entries.push_back(std::move(entry));
@@ -213,6 +225,8 @@ public:
 
     ccl_sched_bin* bin = nullptr; /* valid only during execution */
     ccl_sched_queue* queue = nullptr; /* cached pointer to queue, valid even after execution */
+    ccl_sched* next_submitted = nullptr; /* link in lock-free submission list of bin */
+    std::atomic<size_t> cache_ref_count{ 0 }; /* users of cached sched, unused one can be evicted */
     size_t start_idx = 0; /* index to start */
 
     /*
@@ -228,10 +242,19 @@ public:
     using sched_entry_ptr = std::unique_ptr<sched_entry>;
     std::deque<sched_entry_ptr> entries{};
 
+    /* bumped on every change of entries, compiled plan is used only for the same version */
+    size_t entries_version = 0;
+
+    /* compiled on the first completion of a cached sched, used instead of entries */
+    sched_plan plan;
+
     /* whether sched should be executed in the same order as in user code */
     /* currently applicable for start phase only */
     bool strict_order = false;
 
+    /* top-level sched of the collective measured by the autotuner of the communicator */
+    bool is_tune_trial = false;
+
     /*
       limits number of active entries
       mostly makes sense for ATL entries
@@ -291,6 +314,8 @@ private:
     void create_sync_event(ccl_request* request);
     void update_active_request(bool use_delayed);
     static void complete_itt(const ccl_stream* stream);
+    void update_coll_stats();
+    void complete_trace();
 
     int calculate_request_count() const;
 
@@ -312,6 +337,12 @@ private:
 
     std::unique_ptr<sched_restart_manager> restart_manager;
 
+    // start of the current execution of the top-level sched, used for coll stats and autotune
+    std::chrono::steady_clock::time_point stats_start_time{};
+
+    // start of the current execution for CCL_TRACE, set for the top-level sched and its parts
+    uint64_t trace_start_ns = 0;
+
     friend class sched_restart_manager;
     friend class ze_execute_cmdlists_on_init_entry; // need to call ze_commands_submit();
     friend class ze_execute_cmdlists_on_start_entry; // need to call ze_commands_submit();
@@ -154,6 +154,9 @@ struct ccl_sched_base {
     /* TODO: schedule doesn't necessarily map on single algo */
     ccl_coll_algo hint_algo{};
 
+    /* algorithm selected on schedule build, reported in coll stats and trace */
+    ccl_coll_algo selected_algo{};
+
     static size_t get_lifo_priority() noexcept {
         return lifo_priority++;
     }
@@ -0,0 +1,202 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <typeinfo>
+
+#include "common/log/log.hpp"
+#include "sched/entry/copy/copy_entry.hpp"
+#include "sched/entry/recv_entry.hpp"
+#include "sched/entry/recv_reduce_entry.hpp"
+#include "sched/entry/reduce_local_entry.hpp"
+#include "sched/entry/send_entry.hpp"
+#include "sched/sched_plan.hpp"
+
+sched_plan::op_type sched_plan::get_op_type(sched_entry* entry) {
+    /* exact type match only, derived types may override start/update */
+    const std::type_info& type = typeid(*entry);
+    if (type == typeid(send_entry)) {
+        return op_type::send;
+    }
+    else if (type == typeid(recv_entry)) {
+        return op_type::recv;
+    }
+    else if (type == typeid(recv_reduce_entry)) {
+        return op_type::recv_reduce;
+    }
+    else if (type == typeid(reduce_local_entry)) {
+        return op_type::reduce_local;
+    }
+    else if (type == typeid(copy_entry)) {
+        return op_type::copy;
+    }
+    return op_type::generic;
+}
+
+/*
+   progress loop shared by compiled plans and generic scheds, progress_fn progresses entry
+   with the given index, barriers are passed separately since the plan caches them
+*/
+template <class get_entry_fn_t, class is_barrier_fn_t, class progress_fn_t>
+static size_t progress_entries(size_t start_idx,
+                               size_t entry_count,
+                               bool yield,
+                               bool& is_progressed,
+                               get_entry_fn_t get_entry,
+                               is_barrier_fn_t is_barrier,
+                               progress_fn_t progress) {
+    for (size_t entry_idx = start_idx; entry_idx < entry_count; ++entry_idx) {
+        sched_entry* entry = get_entry(entry_idx);
+
+        if (entry->has_pending_dependencies()) {
+            if (is_barrier(entry_idx)) {
+                break;
+            }
+            /* not ready yet, independent entries behind it can still progress */
+            continue;
+        }
+
+        ccl_sched_entry_status prev_status = entry->get_status();
+        if (prev_status == ccl_sched_entry_status_not_started) {
+            if (yield) {
+                LOG_TRACE("yield before entry ", entry->name(), " [", entry_idx, "]");
+                break;
+            }
+            LOG_DEBUG("starting entry: ",
+                      entry,
+                      ", name: ",
+                      entry->name(),
+                      " [",
+                      entry_idx,
+                      "/",
+                      entry_count,
+                      "]");
+        }
+
+        progress(entry_idx, entry);
+
+        ccl_sched_entry_status status = entry->get_status();
+        is_progressed |= (status != prev_status);
+        if (status == ccl_sched_entry_status_again) {
+            LOG_DEBUG("entry ",
+                      entry->name(),
+                      " is in again state, stop progressing [",
+                      entry_idx,
+                      "/",
+                      entry_count,
+                      "]");
+            break;
+        }
+
+        bool is_completed = (status == ccl_sched_entry_status_complete ||
+                             status == ccl_sched_entry_status_complete_once);
+        if (entry_idx == start_idx && is_completed) {
+            /* the entry has been completed, increment start_idx */
+            ++start_idx;
+            LOG_DEBUG("completed entry: ",
+                      entry,
+                      ", name: ",
+                      entry->name(),
+                      is_barrier(entry_idx) ? " barrier" : "",
+                      " entry [",
+                      entry_idx,
+                      "/",
+                      entry_count,
+                      "], shift start_idx to ",
+                      start_idx);
+        }
+        else if (is_barrier(entry_idx) && (!is_completed || (start_idx != entry_idx + 1))) {
+            /* barrier is not completed or completed too early, skip the further progressing */
+            break;
+        }
+    }
+    return start_idx;
+}
+
+void sched_plan::compile(const std::deque<std::unique_ptr<sched_entry>>& sched_entries,
+                         size_t entries_version) {
+    reset();
+
+    size_t entry_count = sched_entries.size();
+    entries.reserve(entry_count);
+    types.reserve(entry_count);
+    barriers.reserve(entry_count);
+
+    for (auto& entry : sched_entries) {
+        op_type type = get_op_type(entry.get());
+        if (type == op_type::generic) {
+            generic_count++;
+        }
+        entries.push_back(entry.get());
+        types.push_back(type);
+        barriers.push_back(entry->is_barrier());
+    }
+
+    compiled_version = entries_version;
+    compiled = true;
+
+    LOG_DEBUG("compiled sched plan, entries ", entry_count, ", generic entries ", generic_count);
+}
+
+void sched_plan::reset() {
+    entries.clear();
+    types.clear();
+    barriers.clear();
+    generic_count = 0;
+    compiled = false;
+}
+
+size_t sched_plan::do_progress(size_t start_idx, bool yield, bool& is_progressed) {
+    return progress_entries(
+        start_idx,
+        entries.size(),
+        yield,
+        is_progressed,
+        [this](size_t idx) {
+            return entries[idx];
+        },
+        [this](size_t idx) {
+            return barriers[idx] != 0;
+        },
+        [this](size_t idx, sched_entry* entry) {
+            switch (types[idx]) {
+                case op_type::send: entry->do_progress_as<send_entry>(); break;
+                case op_type::recv: entry->do_progress_as<recv_entry>(); break;
+                case op_type::recv_reduce: entry->do_progress_as<recv_reduce_entry>(); break;
+                case op_type::reduce_local: entry->do_progress_as<reduce_local_entry>(); break;
+                case op_type::copy: entry->do_progress_as<copy_entry>(); break;
+                default: entry->do_progress(); break;
+            }
+        });
+}
+
+size_t sched_plan::do_progress(const std::deque<std::unique_ptr<sched_entry>>& sched_entries,
+                               size_t start_idx,
+                               bool yield,
+                               bool& is_progressed) {
+    return progress_entries(
+        start_idx,
+        sched_entries.size(),
+        yield,
+        is_progressed,
+        [&sched_entries](size_t idx) {
+            return sched_entries[idx].get();
+        },
+        [&sched_entries](size_t idx) {
+            return sched_entries[idx]->is_barrier();
+        },
+        [](size_t idx, sched_entry* entry) {
+            entry->do_progress();
+        });
+}
@@ -0,0 +1,81 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+class sched_entry;
+
+/*
+   compact execution plan of a cached sched
+
+   entries are flattened into contiguous arrays tagged with their type, so progress
+   of the common entry types goes through a switch with non-virtual start/update
+   instead of the virtual dispatch of the generic sched loop
+*/
+class sched_plan {
+public:
+    enum class op_type : uint8_t { send, recv, recv_reduce, reduce_local, copy, generic };
+
+    sched_plan() = default;
+    sched_plan(const sched_plan& other) = delete;
+    sched_plan& operator=(const sched_plan& other) = delete;
+
+    void compile(const std::deque<std::unique_ptr<sched_entry>>& sched_entries,
+                 size_t entries_version);
+    void reset();
+
+    bool is_compiled() const {
+        return compiled;
+    }
+
+    /* plan is stale if entries were added or changed after compilation */
+    bool is_valid(size_t entries_version) const {
+        return compiled && (compiled_version == entries_version);
+    }
+
+    size_t size() const {
+        return entries.size();
+    }
+
+    size_t get_generic_count() const {
+        return generic_count;
+    }
+
+    /* progresses entries starting from start_idx, returns updated start_idx,
+       when yield is set stops at the first entry which is not started yet,
+       is_progressed is set if any entry changed its status */
+    size_t do_progress(size_t start_idx, bool yield, bool& is_progressed);
+
+    /* same progress loop over entries of sched which has no compiled plan */
+    static size_t do_progress(const std::deque<std::unique_ptr<sched_entry>>& sched_entries,
+                              size_t start_idx,
+                              bool yield,
+                              bool& is_progressed);
+
+private:
+    static op_type get_op_type(sched_entry* entry);
+
+    std::vector<sched_entry*> entries;
+    std::vector<op_type> types;
+    std::vector<uint8_t> barriers;
+    size_t generic_count = 0;
+    size_t compiled_version = 0;
+    bool compiled = false;
+};
@@ -0,0 +1,255 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unistd.h>
+#include <vector>
+
+#include "common/global/global.hpp"
+#include "common/log/log.hpp"
+#include "sched/sched_trace.hpp"
+
+namespace ccl {
+namespace profile {
+namespace trace {
+
+namespace {
+
+struct trace_event {
+    const char* name;
+    const char* cat;
+    const char* algo;
+    const void* id; /* nullptr for spans bound to the thread */
+    uint64_t arg;
+    uint64_t start_ns;
+    uint64_t end_ns;
+};
+
+class trace_buffer {
+public:
+    trace_buffer(size_t tid, size_t capacity)
+            : tid(tid),
+              thread_name("thread " + std::to_string(tid)),
+              slots(capacity) {}
+
+    void add(const trace_event& event) {
+        uint64_t idx = head.load(std::memory_order_relaxed);
+        trace_slot& slot = slots[idx % slots.size()];
+        /* odd seq marks the slot as being written */
+        slot.seq.store(2 * idx + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.event = event;
+        slot.seq.store(2 * idx + 2, std::memory_order_release);
+        head.store(idx + 1, std::memory_order_release);
+    }
+
+    /* false if the slot does not hold event idx or is overwritten during the copy */
+    bool get(uint64_t idx, trace_event& event) const {
+        const trace_slot& slot = slots[idx % slots.size()];
+        uint64_t seq = slot.seq.load(std::memory_order_acquire);
+        if (seq != 2 * idx + 2) {
+            return false;
+        }
+        event = slot.event;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return (slot.seq.load(std::memory_order_relaxed) == seq);
+    }
+
+    size_t capacity() const {
+        return slots.size();
+    }
+
+    const size_t tid;
+    std::string thread_name;
+    std::atomic<uint64_t> head{ 0 };
+
+private:
+    struct trace_slot {
+        std::atomic<uint64_t> seq{ 0 };
+        trace_event event;
+    };
+
+    std::vector<trace_slot> slots;
+};
+
+/* never destroyed, the dump may run from destructors of other static objects */
+struct trace_registry {
+    std::mutex guard;
+    std::vector<std::unique_ptr<trace_buffer>> buffers;
+    std::atomic<int> rank{ -1 };
+    std::atomic<bool> dump_requested{ false };
+};
+
+trace_registry& get_registry() {
+    static trace_registry* registry = new trace_registry();
+    return *registry;
+}
+
+thread_local trace_buffer* local_buffer = nullptr;
+
+trace_buffer* get_local_buffer() {
+    if (!local_buffer) {
+        auto& registry = get_registry();
+        std::lock_guard<std::mutex> lock(registry.guard);
+        registry.buffers.emplace_back(new trace_buffer(registry.buffers.size(),
+                                                       ccl::global_data::env().trace_buffer_size));
+        local_buffer = registry.buffers.back().get();
+    }
+    return local_buffer;
+}
+
+void signal_handler(int) {
+    get_registry().dump_requested.store(true);
+}
+
+} // namespace
+
+bool is_enabled() {
+    return ccl::global_data::env().enable_trace;
+}
+
+void init() {
+    if (!is_enabled())
+        return;
+
+    struct sigaction action {};
+    action.sa_handler = signal_handler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    if (sigaction(SIGUSR2, &action, nullptr)) {
+        LOG_WARN("failed to install SIGUSR2 handler, trace will be written only on finalize");
+    }
+}
+
+uint64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void set_rank(int rank) {
+    int expected = -1;
+    get_registry().rank.compare_exchange_strong(expected, rank);
+}
+
+void set_thread_name(const std::string& name) {
+    auto buffer = get_local_buffer();
+    std::lock_guard<std::mutex> lock(get_registry().guard);
+    buffer->thread_name = name;
+}
+
+void add_span(const char* name, const char* cat, uint64_t start_ns, uint64_t end_ns) {
+    get_local_buffer()->add({ name, cat, nullptr, nullptr, 0, start_ns, end_ns });
+}
+
+void add_async_span(const char* name,
+                    const char* cat,
+                    const void* id,
+                    uint64_t start_ns,
+                    uint64_t end_ns,
+                    uint64_t arg,
+                    const char* algo) {
+    get_local_buffer()->add({ name, cat, algo, id, arg, start_ns, end_ns });
+}
+
+void dump() {
+    auto& registry = get_registry();
+    std::lock_guard<std::mutex> lock(registry.guard);
+
+    int rank = registry.rank.load();
+    int pid = (rank >= 0) ? rank : getpid();
+    std::string file_name = ccl::global_data::env().trace_file + "." +
+                            ((rank >= 0) ? std::to_string(rank) : "pid" + std::to_string(pid)) +
+                            ".json";
+
+    std::ofstream out(file_name);
+    if (!out) {
+        LOG_WARN("failed to open trace file ", file_name);
+        return;
+    }
+
+    /* convert steady timestamps to wall-clock to align the ranks */
+    int64_t offset_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::system_clock::now().time_since_epoch())
+                            .count() -
+                        static_cast<int64_t>(now());
+    auto to_usec = [offset_ns](uint64_t ns) {
+        return std::to_string((static_cast<int64_t>(ns) + offset_ns) / 1000) + "." +
+               std::to_string(1000 + (static_cast<int64_t>(ns) + offset_ns) % 1000).substr(1);
+    };
+
+    size_t event_count = 0;
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+        << ",\"args\":{\"name\":\"" << ((rank >= 0) ? "rank " : "pid ") << pid << "\"}}";
+    for (auto& buffer : registry.buffers) {
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+            << ",\"tid\":" << buffer->tid << ",\"args\":{\"name\":\"" << buffer->thread_name
+            << "\"}}";
+
+        /*
+           the owner may still record, take the spans completed so far,
+           spans overwritten while the dump runs are skipped
+        */
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        size_t capacity = buffer->capacity();
+        uint64_t first = (head > capacity) ? head - capacity : 0;
+        for (uint64_t idx = first; idx < head; idx++) {
+            trace_event event;
+            if (!buffer->get(idx, event)) {
+                continue;
+            }
+            std::string common = std::string("\"name\":\"") + event.name + "\",\"cat\":\"" +
+                                 event.cat + "\",\"pid\":" + std::to_string(pid) +
+                                 ",\"tid\":" + std::to_string(buffer->tid);
+            if (!event.id) {
+                out << ",\n{" << common << ",\"ph\":\"X\",\"ts\":" << to_usec(event.start_ns)
+                    << ",\"dur\":" << (event.end_ns - event.start_ns) / 1000.0 << "}";
+            }
+            else {
+                out << ",\n{" << common << ",\"ph\":\"b\",\"id\":\"" << event.id
+                    << "\",\"ts\":" << to_usec(event.start_ns) << ",\"args\":{\"id\":"
+                    << event.arg;
+                if (event.algo) {
+                    out << ",\"algo\":\"" << event.algo << "\"";
+                }
+                out << "}}";
+                out << ",\n{" << common << ",\"ph\":\"e\",\"id\":\"" << event.id
+                    << "\",\"ts\":" << to_usec(event.end_ns) << "}";
+            }
+            event_count++;
+        }
+    }
+    out << "\n]}\n";
+
+    LOG_INFO("trace: ", event_count, " events are written to ", file_name);
+}
+
+void check_dump_request() {
+    auto& registry = get_registry();
+    if (registry.dump_requested.load(std::memory_order_relaxed) &&
+        registry.dump_requested.exchange(false)) {
+        dump();
+    }
+}
+
+} // namespace trace
+} // namespace profile
+} // namespace ccl
@@ -0,0 +1,70 @@
+/*
+ Copyright 2016-2020 Intel Corporation
+ 
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+ 
+     http://www.apache.org/licenses/LICENSE-2.0
+ 
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/*
+   timeline of collectives, scheds, entries and worker activity (CCL_TRACE=1)
+
+   every thread records completed spans into its own ring buffer, the writer is the only
+   thread which modifies the buffer so recording takes no locks, when the buffer is full
+   the oldest spans are overwritten
+
+   the buffers are written in chrome trace format to <CCL_TRACE_FILE>.<rank>.json
+   on executor destruction or when the process receives SIGUSR2,
+   pid of the events is the rank and timestamps are wall-clock based,
+   so files of different ranks can be merged by concatenating their traceEvents
+*/
+
+namespace ccl {
+namespace profile {
+namespace trace {
+
+bool is_enabled();
+
+/* installs SIGUSR2 handler, called once on executor creation */
+void init();
+
+/* monotonic timestamp in nanoseconds */
+uint64_t now();
+
+/* rank used as pid and in the file name, the first call wins */
+void set_rank(int rank);
+
+void set_thread_name(const std::string& name);
+
+/* span bound to the current thread, spans of one thread should not overlap */
+void add_span(const char* name, const char* cat, uint64_t start_ns, uint64_t end_ns);
+
+/* span which may overlap with other spans of the current thread, id groups the spans */
+void add_async_span(const char* name,
+                    const char* cat,
+                    const void* id,
+                    uint64_t start_ns,
+                    uint64_t end_ns,
+                    uint64_t arg = 0,
+                    const char* algo = nullptr);
+
+void dump();
+
+/* dumps if SIGUSR2 has been received since the last check */
+void check_dump_request();
+
+} // namespace trace
+} // namespace profile
+} // namespace ccl
@@ -254,6 +254,10 @@ bool topo_manager::has_same_domains() const {
     return is_same_domains;
 }
 
+bool topo_manager::has_block_layout() const {
+    return is_block_layout;
+}
+
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
 bool topo_manager::has_failed_ports() const {
     return (port_status == port_health_status::fail);
@@ -1444,6 +1448,14 @@ void topo_manager::build_host_info() {
         std::all_of(host_info_vec.begin(), host_info_vec.end(), [this](const topo_host_info& info) {
             return (info.ranks.size() == host_info_vec.front().ranks.size());
         });
+    is_block_layout =
+        is_same_ppn &&
+        std::all_of(host_info_vec.begin(), host_info_vec.end(), [](const topo_host_info& info) {
+            int ppn = static_cast<int>(info.ranks.size());
+            int first_rank = *info.ranks.begin();
+            int last_rank = *info.ranks.rbegin();
+            return (first_rank % ppn == 0) && (last_rank - first_rank + 1 == ppn);
+        });
 }
 
 void topo_manager::base_init(const std::shared_ptr<atl_base_comm>& atl_comm,
@@ -154,6 +154,8 @@ public:
     std::string get_uuid(int rank) const;
     bool has_same_ppn() const;
     bool has_same_domains() const;
+    // true if every host runs a contiguous block of ppn ranks starting at host_block_idx * ppn
+    bool has_block_layout() const;
 
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
     enum class port_health_status { unknown, ok, fail };
@@ -266,6 +268,7 @@ private:
 
     bool is_same_ppn = true;
     bool is_same_domains = true;
+    bool is_block_layout = false;
 
 #if defined(CCL_ENABLE_SYCL) && defined(CCL_ENABLE_ZE)
     ze_device_handle_t ze_device{};
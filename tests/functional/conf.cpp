@@ -99,6 +99,7 @@ ccl_reduction_type last_reduction_type = static_cast<ccl_reduction_type>(first_r
 std::map<int, std::string> reduction_type_names = {
     { REDUCTION_SUM, "REDUCTION_SUM" },       { REDUCTION_PROD, "REDUCTION_PROD" },
     { REDUCTION_MIN, "REDUCTION_MIN" },       { REDUCTION_MAX, "REDUCTION_MAX" },
+    { REDUCTION_AVG, "REDUCTION_AVG" },
 #ifdef TEST_CCL_CUSTOM_REDUCE
     { REDUCTION_CUSTOM, "REDUCTION_CUSTOM" }, { REDUCTION_CUSTOM_NULL, "REDUCTION_CUSTOM_NULL" }
 #endif
@@ -106,6 +107,7 @@ std::map<int, std::string> reduction_type_names = {
 std::map<int, ccl::reduction> reduction_values = {
     { REDUCTION_SUM, ccl::reduction::sum },       { REDUCTION_PROD, ccl::reduction::prod },
     { REDUCTION_MIN, ccl::reduction::min },       { REDUCTION_MAX, ccl::reduction::max },
+    { REDUCTION_AVG, ccl::reduction::avg },
 #ifdef TEST_CCL_CUSTOM_REDUCE
     { REDUCTION_CUSTOM, ccl::reduction::custom }, { REDUCTION_CUSTOM_NULL, ccl::reduction::custom }
 #endif
@@ -105,6 +105,7 @@ typedef enum {
     REDUCTION_PROD,
     REDUCTION_MIN,
     REDUCTION_MAX,
+    REDUCTION_AVG,
 #ifdef TEST_CCL_CUSTOM_REDUCE
     REDUCTION_CUSTOM,
     REDUCTION_CUSTOM_NULL,
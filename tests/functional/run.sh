@@ -187,6 +187,14 @@ case "$runtime" in
         run_test_cmd "${func_exec_env} ctest --output-junit ${TESTS_DIR}/junit/default_mpi.junit.xml -V -C default"
         run_test_cmd "${func_exec_env} ctest --output-junit ${TESTS_DIR}/junit/regression_mpi.junit.xml -V -C regression"
         ;;
+    shm )
+        # single-node runs, second pass disables the single-copy path to cover ring copies
+        func_exec_env+=" CCL_ATL_TRANSPORT=shm"
+        run_test_cmd "${func_exec_env} ctest --output-junit ${TESTS_DIR}/junit/default_shm.junit.xml -V -C default"
+        run_test_cmd "${func_exec_env} ctest --output-junit ${TESTS_DIR}/junit/regression_shm.junit.xml -V -C regression"
+        func_exec_env=$(set_tests_option "ATL_SHM_CMA_THRESHOLD=0" "${func_exec_env}")
+        run_test_cmd "${func_exec_env} ctest --output-junit ${TESTS_DIR}/junit/default_shm_copy.junit.xml -V -C default"
+        ;;
     ofi_adjust | mpi_adjust )
 
         allgatherv_algos="naive flat ring"
@@ -319,7 +327,7 @@ case "$runtime" in
         done
         ;;
     * )
-        echo "Please specify runtime mode: runtime=ofi|mpi|ofi_adjust|mpi_adjust|priority_mode|dynamic_pointer_mode|fusion_mode|"
+        echo "Please specify runtime mode: runtime=ofi|mpi|shm|ofi_adjust|mpi_adjust|priority_mode|dynamic_pointer_mode|fusion_mode|"
         exit 1
         ;;
 esac